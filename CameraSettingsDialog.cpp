@@ -335,6 +335,30 @@ void CameraSettingsDialog::setupUI()
     sharpnessLayout->addRow("Sharpness:", sharpnessSpinBox);
     
     colorLayout->addWidget(sharpnessGroup);
+    
+    // 디모자이크 (Bayer 픽셀 포맷일 때 검사 단계에서 변환)
+    QGroupBox* demosaicGroup = new QGroupBox("디모자이크", colorTab);
+    QFormLayout* demosaicLayout = new QFormLayout(demosaicGroup);
+    
+    demosaicQualityComboBox = new QComboBox(colorTab);
+    demosaicQualityComboBox->addItem("Fast (Bilinear)");
+    demosaicQualityComboBox->addItem("Edge-Aware");
+    demosaicQualityComboBox->addItem("High Quality (VNG)");
+    demosaicQualityComboBox->addItem("Directional (Spinnaker, 기본)");
+    demosaicQualityComboBox->setCurrentIndex(ConfigManager::instance()->getDemosaicQuality());
+    connect(demosaicQualityComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged), [](int index) {
+        ConfigManager::instance()->setDemosaicQuality(index);
+    });
+    demosaicLayout->addRow("Algorithm:", demosaicQualityComboBox);
+    
+    demosaicGrayOutputCheckBox = new QCheckBox("흑백 평면 동시 생성", colorTab);
+    demosaicGrayOutputCheckBox->setChecked(ConfigManager::instance()->getDemosaicGrayOutput());
+    connect(demosaicGrayOutputCheckBox, &QCheckBox::stateChanged, [](int state) {
+        ConfigManager::instance()->setDemosaicGrayOutput(state == Qt::Checked);
+    });
+    demosaicLayout->addRow("", demosaicGrayOutputCheckBox);
+    
+    colorLayout->addWidget(demosaicGroup);
     colorLayout->addStretch();
     
     tabWidget->addTab(colorTab, "색상 & 화질");
@@ -383,6 +407,14 @@ void CameraSettingsDialog::setupUI()
     });
     triggerFormLayout->addRow("", saveTriggerImagesCheckBox);
     
+    // 트리거 → 결과 지연 추적 (검사 중지 시 traces/ 폴더에 Chrome trace JSON 저장)
+    latencyTracingCheckBox = new QCheckBox("지연 추적 기록 (Chrome trace)", triggerTab);
+    latencyTracingCheckBox->setChecked(ConfigManager::instance()->getLatencyTracing());
+    connect(latencyTracingCheckBox, &QCheckBox::stateChanged, [](int state) {
+        ConfigManager::instance()->setLatencyTracing(state == Qt::Checked);
+    });
+    triggerFormLayout->addRow("", latencyTracingCheckBox);
+    
     triggerLayout->addWidget(triggerGroup);
     triggerLayout->addStretch();
     
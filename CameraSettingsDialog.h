@@ -102,12 +102,17 @@ private:
     QComboBox* triggerSourceComboBox;
     QComboBox* acquisitionModeComboBox;
     QCheckBox* saveTriggerImagesCheckBox;
+    QCheckBox* latencyTracingCheckBox;
     
     // 화질 설정
     QDoubleSpinBox* blackLevelSpinBox;
     QDoubleSpinBox* sharpnessSpinBox;
     QCheckBox* sharpnessEnableCheckBox;
     
+    // 디모자이크 설정 (Bayer 픽셀 포맷, 프로그램 설정으로 저장)
+    QComboBox* demosaicQualityComboBox;
+    QCheckBox* demosaicGrayOutputCheckBox;
+    
     QPushButton* applyButton;
     QPushButton* closeButton;
 
@@ -16,7 +16,9 @@
 #include <QPinchGesture>
 #include <QScrollBar>
 #include <QElapsedTimer>
+#include <QSet>
 #include <cmath>
+#include <cstring>
 #include <algorithm>
 
 CameraView::CameraView(QWidget *parent) : QGraphicsView(parent)
@@ -1946,7 +1948,7 @@ void CameraView::updateInspectionResult(bool passed, const InspectionResult &res
         // 검사 결과 오버레이 포함해서 ROI 영역만 캡쳐
         if (teachingWidget && targetFrameIndex < (int)teachingWidget->cameraFrames.size())
         {
-            const cv::Mat& frame = teachingWidget->cameraFrames[targetFrameIndex];
+            const cv::Mat& frame = teachingWidget->cameraFrames.load(targetFrameIndex);
             if (!frame.empty())
             {
                 // ROI 영역만 crop (경계선 5픽셀 안쪽)
@@ -4050,15 +4052,8 @@ void CameraView::paintEvent(QPaintEvent *event)
         std::array<cv::Mat, 4> framesCopy;
         if (teachingWidget) {
             try {
-                // teachingWidget이 유효한지 재확인
-                // std::array는 empty() 메서드가 없으므로 첫 번째 요소 확인
-                if (!teachingWidget->cameraFrames[0].empty() || 
-                    !teachingWidget->cameraFrames[1].empty() ||
-                    !teachingWidget->cameraFrames[2].empty() ||
-                    !teachingWidget->cameraFrames[3].empty()) {
-                    // shallow copy (참조 카운팅) - clone()보다 훨씬 빠름
-                    framesCopy = teachingWidget->cameraFrames;
-                }
+                // 슬롯별 발행된 프레임 스냅샷 (참조 카운팅 - clone 없음)
+                framesCopy = teachingWidget->cameraFrames.snapshot();
             } catch (...) {
                 // teachingWidget이 소멸 중이거나 무효한 경우 무시
                 for (auto& frame : framesCopy) {
@@ -5184,6 +5179,22 @@ void CameraView::movePatternFilterDown(const QUuid &patternId, int filterIndex)
     update();
 }
 
+namespace {
+    // 두 영역의 픽셀이 같은지 비교 (행 단위, 다른 행을 만나면 바로 중단)
+    bool sameRegion(const cv::Mat &a, const cv::Mat &b)
+    {
+        if (a.size() != b.size() || a.type() != b.type())
+            return false;
+        const size_t rowBytes = a.cols * a.elemSize();
+        for (int y = 0; y < a.rows; y++)
+        {
+            if (std::memcmp(a.ptr(y), b.ptr(y), rowBytes) != 0)
+                return false;
+        }
+        return true;
+    }
+}
+
 void CameraView::applyFiltersToImage(cv::Mat &image)
 {
     // 이미지가 비어있으면 처리하지 않음
@@ -5192,6 +5203,8 @@ void CameraView::applyFiltersToImage(cv::Mat &image)
         return;
     }
 
+    QSet<QUuid> visitedPatterns;
+
     for (int i = 0; i < patterns.size(); ++i)
     {
         const PatternInfo &pattern = patterns[i];
@@ -5214,106 +5227,65 @@ void CameraView::applyFiltersToImage(cv::Mat &image)
             continue;
         }
 
-        // 회전이 있는 경우: 회전된 사각형 영역에만 필터 적용
-        if (std::abs(pattern.angle) > 0.1)
-        {
-            cv::Point2f center(pattern.rect.x() + pattern.rect.width() / 2.0f,
-                               pattern.rect.y() + pattern.rect.height() / 2.0f);
-
-            // 1. 회전된 사각형 마스크 생성
-            cv::Mat mask = cv::Mat::zeros(image.size(), CV_8UC1);
-            cv::Size2f patternSize(pattern.rect.width(), pattern.rect.height());
+        // 1. 필터 체인/영역이 바뀌었으면 다시 준비 (영역/마스크는 필터 대화상자 미리보기와 같은 계산)
+        const bool rotated = FilterPreviewRegion::isRotated(pattern.angle);
+        const size_t signature = qHashMulti(FilterChain::computeSignature(pattern.filters, !rotated),
+                                            pattern.rect.x(), pattern.rect.y(),
+                                            pattern.rect.width(), pattern.rect.height(),
+                                            rotated ? pattern.angle : 0.0,
+                                            image.cols, image.rows, image.type());
 
-            cv::Point2f vertices[4];
-            cv::RotatedRect rotatedRect(center, patternSize, pattern.angle);
-            rotatedRect.points(vertices);
+        FilterPreviewCache &cache = filterPreviewCache[pattern.id];
 
-            std::vector<cv::Point> points;
-            for (int i = 0; i < 4; i++)
+        try
+        {
+            if (cache.signature != signature || !cache.chain)
             {
-                points.push_back(cv::Point(static_cast<int>(std::round(vertices[i].x)),
-                                           static_cast<int>(std::round(vertices[i].y))));
+                cache.chain = std::make_shared<const FilterChain>(pattern.filters, !rotated);
+                cache.region = FilterPreviewRegion::compute(pattern.rect, pattern.angle, image.size());
+                cache.result.release();
+                cache.signature = signature;
             }
-            cv::fillPoly(mask, std::vector<std::vector<cv::Point>>{points}, cv::Scalar(255));
-
-            // 2. 마스크 영역만 복사한 이미지 생성
-            cv::Mat maskedImage = cv::Mat::zeros(image.size(), image.type());
-            image.copyTo(maskedImage, mask);
-
-            // 3. 확장된 ROI 계산
-            double angleRad = std::abs(pattern.angle) * M_PI / 180.0;
-            double width = pattern.rect.width();
-            double height = pattern.rect.height();
-
-            double rotatedWidth = std::abs(width * std::cos(angleRad)) + std::abs(height * std::sin(angleRad));
-            double rotatedHeight = std::abs(width * std::sin(angleRad)) + std::abs(height * std::cos(angleRad));
-
-            int maxSize = static_cast<int>(std::max(rotatedWidth, rotatedHeight));
-            int halfSize = maxSize / 2;
+            if (!cache.region.isValid())
+            {
+                continue;
+            }
+            visitedPatterns.insert(pattern.id);
+            cv::Mat region = image(cache.region.roi);
 
-            cv::Rect expandedRoi(
-                qBound(0, static_cast<int>(center.x) - halfSize, image.cols - 1),
-                qBound(0, static_cast<int>(center.y) - halfSize, image.rows - 1),
-                qBound(1, maxSize, image.cols - (static_cast<int>(center.x) - halfSize)),
-                qBound(1, maxSize, image.rows - (static_cast<int>(center.y) - halfSize)));
+            // 2. 원본 픽셀도 같으면 이전 결과를 그대로 사용
+            bool reusable = !cache.result.empty() && sameRegion(cache.source, region);
 
-            // 4. 확장된 영역에 필터 적용
-            if (expandedRoi.width > 0 && expandedRoi.height > 0 &&
-                expandedRoi.x + expandedRoi.width <= maskedImage.cols &&
-                expandedRoi.y + expandedRoi.height <= maskedImage.rows)
+            if (!reusable)
             {
-
-                cv::Mat roiMat = maskedImage(expandedRoi);
-                ImageProcessor processor;
-                for (const FilterInfo &filter : pattern.filters)
-                {
-                    if (filter.enabled)
-                    {
-                        cv::Mat nextFiltered;
-                        processor.applyFilter(roiMat, nextFiltered, filter);
-                        if (!nextFiltered.empty())
-                        {
-                            nextFiltered.copyTo(roiMat);
-                        }
-                    }
-                }
+                // 3. 원본 영역을 복사해 두고 (다음 프레임 비교용) 필터 체인 적용
+                region.copyTo(cache.source);
+                cache.region.makeInput(cache.source, cache.input);
+                cache.chain->apply(cache.input, cache.result);
             }
 
-            // 5. 마스크 영역만 필터 적용된 결과로 교체
-            maskedImage.copyTo(image, mask);
+            // 4. 결과를 영역에 반영 (회전 패턴은 마스크 영역만)
+            cache.region.writeBack(cache.result, image);
         }
-        else
+        catch (const std::exception &e)
         {
-            // 회전 없는 경우: rect 영역에만 필터 적용
-            QRectF rect = pattern.rect;
-
-            int x = qBound(0, qRound(rect.x()), image.cols - 2);
-            int y = qBound(0, qRound(rect.y()), image.rows - 2);
-            int width = qBound(1, qRound(rect.width()), image.cols - x);
-            int height = qBound(1, qRound(rect.height()), image.rows - y);
-
-            if (width <= 0 || height <= 0)
-                continue;
-
-            cv::Rect roi(x, y, width, height);
-
-            try
-            {
-                if (roi.x >= 0 && roi.y >= 0 &&
-                    roi.x + roi.width <= image.cols &&
-                    roi.y + roi.height <= image.rows &&
-                    roi.width > 0 && roi.height > 0)
-                {
+            filterPreviewCache.remove(pattern.id);
+        }
+        catch (...)
+        {
+            filterPreviewCache.remove(pattern.id);
+        }
+    }
 
-                    ImageProcessor::applyFilters(image, pattern.filters, roi);
-                }
-            }
-            catch (const std::exception &e)
-            {
-            }
-            catch (...)
-            {
-            }
+    // 삭제됐거나 다른 프레임의 패턴 캐시 정리
+    if (filterPreviewCache.size() > visitedPatterns.size())
+    {
+        for (auto it = filterPreviewCache.begin(); it != filterPreviewCache.end();)
+        {
+            if (visitedPatterns.contains(it.key()))
+                ++it;
+            else
+                it = filterPreviewCache.erase(it);
         }
     }
 }
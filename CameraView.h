@@ -18,7 +18,9 @@
 #include <QComboBox>
 #include <QDebug>
 #include <QMutex>
+#include <QHash>
 #include <array>
+#include <memory>
 #include "CommonDefs.h"
 #include "ImageProcessor.h"
 #include "LanguageManager.h"
@@ -479,6 +481,19 @@ private:
     // 패턴별 윤곽선 저장
     QMap<QUuid, QList<QVector<QPoint>>> patternContours;
 
+    // 패턴별 필터 미리보기 캐시 (applyFiltersToImage, 메인 스레드 전용)
+    // 필터/영역이 같고 원본 영역 픽셀도 같으면 체인을 다시 돌리지 않고 결과만 붙여넣는다.
+    // 버퍼는 패턴 영역 크기로 한 번 할당 후 프레임마다 재사용한다.
+    struct FilterPreviewCache {
+        size_t signature = 0;                       // 필터 체인 + 영역 + 각도 + 영상 형식
+        std::shared_ptr<const FilterChain> chain;
+        FilterPreviewRegion region;                 // 필터 적용 영역/마스크 (필터 대화상자와 공용 계산)
+        cv::Mat source;                             // 필터 적용 전 영역 (변경 감지용)
+        cv::Mat input;                              // 첫 필터 입력 (회전 패턴은 마스크 밖을 0으로)
+        cv::Mat result;                             // 필터 적용 결과 (영역 크기)
+    };
+    QHash<QUuid, FilterPreviewCache> filterPreviewCache;
+
     QString statusInfo;
     EditMode m_editMode = EditMode::Move; // 기본값은 이동 모드
     QString currentCameraUuid;            // 현재 카메라 UUID
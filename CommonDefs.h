@@ -46,6 +46,7 @@
 // 프레임별 스테이지 레이블 (4분할 화면용)
 const QStringList FRAME_LABELS = {"FRONT - STRIP", "FRONT - CRIMP", "REAR - STRIP", "REAR - CRIMP"};
 
+// ★ 필드 추가 시 구조체 끝의 merge()에도 반영할 것 (병렬 INS 검사 결과 병합)
 struct InspectionResult {
     bool isPassed = false;
     int inspectionTimeMs = 0;              // 검사 소요 시간 (밀리초)
@@ -54,6 +55,7 @@ struct InspectionResult {
     QMap<QUuid, double> matchScores;       // 매칭 점수 (패턴 ID -> 점수)
     QMap<QUuid, double> insScores;         // INS 검사 점수 (패턴 ID -> 점수)
     QMap<QUuid, cv::Point> locations;      // 검출 위치 (원본 이미지 기준 절대좌표, 픽셀)
+    QMap<QUuid, cv::Point2f> subPixelLocations;  // FID 서브픽셀 검출 위치 (원본 이미지 기준 절대좌표)
     QMap<QUuid, double> angles;            // 검출 각도 (도 단위)
     QMap<QUuid, QRectF> adjustedRects;      // 조정된 검사 영역 (원본 이미지 기준 절대좌표)
     
@@ -63,6 +65,7 @@ struct InspectionResult {
 
     QMap<QUuid, cv::Mat> insProcessedImages;  // 처리된 결과 이미지 (패턴 ID -> 결과 이미지)
     QMap<QUuid, int> insMethodTypes;          // 검사 방법 타입 (패턴 ID -> 검사 방법)
+    QMap<QUuid, qint64> patternTimesUs;       // 패턴별 검사 소요 시간 (패턴 ID -> 마이크로초, FID/INS/ANOMALY)
     
     // STRIP 두께 검사 전용 측정 위치 정보
     QMap<QUuid, cv::Point> stripThicknessCenters;  // 두께 측정 중심점 (원본 이미지 기준 절대좌표, 픽셀)
@@ -193,6 +196,124 @@ struct InspectionResult {
     QMap<QUuid, cv::Mat> anomalyHeatmap;           // ANOMALY 히트맵 (패턴별, 임계값 적용, 컬러)
     QMap<QUuid, QRectF> anomalyHeatmapRect;        // ANOMALY 히트맵 위치 (절대좌표)
     QMap<QUuid, std::vector<std::vector<cv::Point>>> anomalyDefectContours;  // ANOMALY 불량 contour (절대좌표)
+
+    // 패턴별 결과 슬롯을 전체 검사 결과에 병합 (병렬 INS 검사에서 사용, 패턴 ID 키는 슬롯 간에 겹치지 않음)
+    // 로그용 문자열은 직렬 실행과 같도록 나중 슬롯의 값이 덮어쓴다. inspectionTimeMs는 호출 측에서 전체 시간으로 기록.
+    // ★ 위에 필드를 추가하면 여기에도 병합을 추가할 것 (빠뜨리면 병렬 검사 결과에서 조용히 누락됨)
+    void merge(const InspectionResult& src)
+    {
+        isPassed = isPassed && src.isPassed;
+
+        fidResults.insert(src.fidResults);
+        insResults.insert(src.insResults);
+        matchScores.insert(src.matchScores);
+        insScores.insert(src.insScores);
+        locations.insert(src.locations);
+        subPixelLocations.insert(src.subPixelLocations);
+        angles.insert(src.angles);
+        adjustedRects.insert(src.adjustedRects);
+        parentOffsets.insert(src.parentOffsets);
+        parentAngles.insert(src.parentAngles);
+        insProcessedImages.insert(src.insProcessedImages);
+        insMethodTypes.insert(src.insMethodTypes);
+        patternTimesUs.insert(src.patternTimesUs);
+        stripThicknessCenters.insert(src.stripThicknessCenters);
+        stripThicknessLines.insert(src.stripThicknessLines);
+        stripThicknessDetails.insert(src.stripThicknessDetails);
+        stripNeckAvgWidths.insert(src.stripNeckAvgWidths);
+        stripNeckMinWidths.insert(src.stripNeckMinWidths);
+        stripNeckMaxWidths.insert(src.stripNeckMaxWidths);
+        stripNeckStdDevs.insert(src.stripNeckStdDevs);
+        stripNeckMeasureX.insert(src.stripNeckMeasureX);
+        stripNeckMeasureCount.insert(src.stripNeckMeasureCount);
+        stripMeasuredThicknessMin.insert(src.stripMeasuredThicknessMin);
+        stripMeasuredThicknessMax.insert(src.stripMeasuredThicknessMax);
+        stripMeasuredThicknessAvg.insert(src.stripMeasuredThicknessAvg);
+        stripThicknessMeasured.insert(src.stripThicknessMeasured);
+        stripRearMeasuredThicknessMin.insert(src.stripRearMeasuredThicknessMin);
+        stripRearMeasuredThicknessMax.insert(src.stripRearMeasuredThicknessMax);
+        stripRearMeasuredThicknessAvg.insert(src.stripRearMeasuredThicknessAvg);
+        stripRearThicknessMeasured.insert(src.stripRearThicknessMeasured);
+        stripFrontBoxCenter.insert(src.stripFrontBoxCenter);
+        stripFrontBoxSize.insert(src.stripFrontBoxSize);
+        stripRearBoxCenter.insert(src.stripRearBoxCenter);
+        stripRearBoxSize.insert(src.stripRearBoxSize);
+        stripFrontThicknessPoints.insert(src.stripFrontThicknessPoints);
+        stripRearThicknessPoints.insert(src.stripRearThicknessPoints);
+        stripFrontBlackRegionPoints.insert(src.stripFrontBlackRegionPoints);
+        stripRearBlackRegionPoints.insert(src.stripRearBlackRegionPoints);
+        stripFrontScanLines.insert(src.stripFrontScanLines);
+        stripRearScanLines.insert(src.stripRearScanLines);
+        stripStartPoint.insert(src.stripStartPoint);
+        stripMaxGradientPoint.insert(src.stripMaxGradientPoint);
+        stripMeasuredThicknessLeft.insert(src.stripMeasuredThicknessLeft);
+        stripMeasuredThicknessRight.insert(src.stripMeasuredThicknessRight);
+        edgeResults.insert(src.edgeResults);
+        edgeIrregularityCount.insert(src.edgeIrregularityCount);
+        edgeMaxDeviation.insert(src.edgeMaxDeviation);
+        edgeMinDeviation.insert(src.edgeMinDeviation);
+        edgeAvgDeviation.insert(src.edgeAvgDeviation);
+        edgeBoxCenter.insert(src.edgeBoxCenter);
+        edgeBoxSize.insert(src.edgeBoxSize);
+        edgeMeasured.insert(src.edgeMeasured);
+        edgeAbsolutePoints.insert(src.edgeAbsolutePoints);
+        edgePointDistances.insert(src.edgePointDistances);
+        edgeAverageX.insert(src.edgeAverageX);
+        edgeRegressionSlope.insert(src.edgeRegressionSlope);
+        edgeRegressionIntercept.insert(src.edgeRegressionIntercept);
+        stripPoint1.insert(src.stripPoint1);
+        stripPoint2.insert(src.stripPoint2);
+        stripPoint3.insert(src.stripPoint3);
+        stripPoint4.insert(src.stripPoint4);
+        stripPointsValid.insert(src.stripPointsValid);
+        stripLengthResults.insert(src.stripLengthResults);
+        stripMeasuredLength.insert(src.stripMeasuredLength);
+        stripMeasuredLengthPx.insert(src.stripMeasuredLengthPx);
+        stripLengthStartPoint.insert(src.stripLengthStartPoint);
+        stripLengthEndPoint.insert(src.stripLengthEndPoint);
+        barrelLeftResults.insert(src.barrelLeftResults);
+        barrelRightResults.insert(src.barrelRightResults);
+        barrelLeftMeasuredLength.insert(src.barrelLeftMeasuredLength);
+        barrelRightMeasuredLength.insert(src.barrelRightMeasuredLength);
+        barrelLeftBoxCenter.insert(src.barrelLeftBoxCenter);
+        barrelRightBoxCenter.insert(src.barrelRightBoxCenter);
+        barrelLeftBoxSize.insert(src.barrelLeftBoxSize);
+        barrelRightBoxSize.insert(src.barrelRightBoxSize);
+        barrelLeftMask.insert(src.barrelLeftMask);
+        barrelRightMask.insert(src.barrelRightMask);
+        barrelLeftContour.insert(src.barrelLeftContour);
+        barrelRightContour.insert(src.barrelRightContour);
+        barrelLeftContourWidth.insert(src.barrelLeftContourWidth);
+        barrelLeftContourHeight.insert(src.barrelLeftContourHeight);
+        barrelRightContourWidth.insert(src.barrelRightContourWidth);
+        barrelRightContourHeight.insert(src.barrelRightContourHeight);
+        barrelLeftBoxRect.insert(src.barrelLeftBoxRect);
+        barrelRightBoxRect.insert(src.barrelRightBoxRect);
+        diffMask.insert(src.diffMask);
+        ssimHeatmap.insert(src.ssimHeatmap);
+        ssimHeatmapRect.insert(src.ssimHeatmapRect);
+        ssimDiffMap.insert(src.ssimDiffMap);
+        anomalyRawMap.insert(src.anomalyRawMap);
+        anomalyHeatmap.insert(src.anomalyHeatmap);
+        anomalyHeatmapRect.insert(src.anomalyHeatmapRect);
+        anomalyDefectContours.insert(src.anomalyDefectContours);
+
+        if (!src.stripPatternName.isEmpty()) stripPatternName = src.stripPatternName;
+        if (!src.stripLengthResult.isEmpty()) stripLengthResult = src.stripLengthResult;
+        if (!src.stripLengthDetail.isEmpty()) stripLengthDetail = src.stripLengthDetail;
+        if (!src.frontResult.isEmpty()) frontResult = src.frontResult;
+        if (!src.frontDetail.isEmpty()) frontDetail = src.frontDetail;
+        if (!src.rearResult.isEmpty()) rearResult = src.rearResult;
+        if (!src.rearDetail.isEmpty()) rearDetail = src.rearDetail;
+        if (!src.edgeResult.isEmpty()) edgeResult = src.edgeResult;
+        if (!src.edgeDetail.isEmpty()) edgeDetail = src.edgeDetail;
+        if (!src.barrelLeftResult.isEmpty()) barrelLeftResult = src.barrelLeftResult;
+        if (!src.barrelLeftDetail.isEmpty()) barrelLeftDetail = src.barrelLeftDetail;
+        if (!src.barrelRightResult.isEmpty()) barrelRightResult = src.barrelRightResult;
+        if (!src.barrelRightDetail.isEmpty()) barrelRightDetail = src.barrelRightDetail;
+
+        if (!src.globalAnomalyMap.empty()) globalAnomalyMap = src.globalAnomalyMap;
+    }
 };
 
 // 패턴 유형 열거형
@@ -238,14 +359,14 @@ struct PatternInfo {
     double maxAngle = 15.0;
     double angleStep = 1.0;
     QImage templateImage;  // 템플릿 이미지
-    int fidMatchMethod = 0;     // FID 템플릿 매칭 방법 (0: Coefficient, 1: Correlation)
+    int fidMatchMethod = 0;     // FID 템플릿 매칭 방법 (0: Coefficient, 1: Correlation, 2: Shape)
     bool runInspection = true;  // 추가: 매칭 검사 활성화 여부
     
     // 패턴 매칭 (Fine Alignment) 전용 속성
     QImage matchTemplate;       // 패턴 매칭용 템플릿 (필터 적용 안 된 원본)
     QImage matchTemplateMask;   // 패턴 매칭용 마스크 (회전된 영역만 255, 나머지 0)
     bool patternMatchEnabled = false;  // 패턴 매칭 활성화 여부
-    int patternMatchMethod = 0;        // 패턴 매칭 방법 (0: Coefficient, 1: Correlation)
+    int patternMatchMethod = 0;        // 패턴 매칭 방법 (0: Coefficient, 1: Correlation, 2: Shape)
     double patternMatchThreshold = 65.0;  // 패턴 매칭 임계값 (0-100%)
     bool patternMatchUseRotation = false;  // 패턴 매칭 회전 사용 여부
     double patternMatchMinAngle = -3.0;   // 패턴 매칭 최소 각도
@@ -31,6 +31,10 @@ ConfigManager::ConfigManager(QObject* parent) : QObject(parent) {
     m_heartbeatInterval = 30;  // 기본 Heartbeat 주기 30초
     m_cameraAutoConnect = false;  // 기본 카메라 자동 연결 비활성화
     m_saveTriggerImages = true;  // 기본 트리거 영상 저장 활성화
+    m_demosaicQuality = 3;  // 기본 Spinnaker 방향성 필터 (OpenCV 디모자이크는 선택)
+    m_demosaicGrayOutput = false;  // 기본 흑백 평면 미생성
+    m_latencyTracing = false;  // 기본 지연 추적 비활성화
+    m_statsPort = 0;  // 기본 통계 엔드포인트 비활성화
     
     // 프로퍼티 패널 기본값
     m_propertyPanelGeometry = QRect(0, 0, 400, 600);
@@ -125,6 +129,18 @@ bool ConfigManager::loadConfig() {
                 QString value = xml.readElementText();
                 m_saveTriggerImages = (value.toLower() == "true");
                 qDebug() << "[ConfigManager] Save trigger images loaded:" << m_saveTriggerImages;
+            } else if (xml.name() == QLatin1String("DemosaicQuality")) {
+                m_demosaicQuality = xml.readElementText().toInt();
+                if (m_demosaicQuality < 0 || m_demosaicQuality > 3) m_demosaicQuality = 3;
+            } else if (xml.name() == QLatin1String("DemosaicGrayOutput")) {
+                QString value = xml.readElementText();
+                m_demosaicGrayOutput = (value.toLower() == "true");
+            } else if (xml.name() == QLatin1String("LatencyTracing")) {
+                QString value = xml.readElementText();
+                m_latencyTracing = (value.toLower() == "true");
+            } else if (xml.name() == QLatin1String("StatsPort")) {
+                m_statsPort = xml.readElementText().toInt();
+                if (m_statsPort < 0 || m_statsPort > 65535) m_statsPort = 0;
             } else if (xml.name() == QLatin1String("PropertyPanel")) {
                 // 프로퍼티 패널 설정
                 QXmlStreamAttributes attrs = xml.attributes();
@@ -220,6 +236,16 @@ bool ConfigManager::saveConfig() {
     // 트리거 영상 저장 설정 저장
     xml.writeTextElement("SaveTriggerImages", m_saveTriggerImages ? "true" : "false");
     
+    // 디모자이크 설정 저장
+    xml.writeTextElement("DemosaicQuality", QString::number(m_demosaicQuality));
+    xml.writeTextElement("DemosaicGrayOutput", m_demosaicGrayOutput ? "true" : "false");
+    
+    // 지연 추적 설정 저장
+    xml.writeTextElement("LatencyTracing", m_latencyTracing ? "true" : "false");
+    
+    // 검사 통계 엔드포인트 포트 저장
+    xml.writeTextElement("StatsPort", QString::number(m_statsPort));
+    
     // 프로퍼티 패널 설정 저장
     xml.writeStartElement("PropertyPanel");
     xml.writeAttribute("x", QString::number(m_propertyPanelGeometry.x()));
@@ -464,3 +490,54 @@ void ConfigManager::setSaveTriggerImages(bool enable) {
         saveConfig();
     }
 }
+
+// 디모자이크 설정
+int ConfigManager::getDemosaicQuality() const {
+    return m_demosaicQuality;
+}
+
+void ConfigManager::setDemosaicQuality(int quality) {
+    if (m_demosaicQuality != quality) {
+        m_demosaicQuality = quality;
+        saveConfig();
+        emit configChanged();
+    }
+}
+
+bool ConfigManager::getDemosaicGrayOutput() const {
+    return m_demosaicGrayOutput;
+}
+
+void ConfigManager::setDemosaicGrayOutput(bool enable) {
+    if (m_demosaicGrayOutput != enable) {
+        m_demosaicGrayOutput = enable;
+        saveConfig();
+        emit configChanged();
+    }
+}
+
+// 지연 추적 설정
+bool ConfigManager::getLatencyTracing() const {
+    return m_latencyTracing;
+}
+
+void ConfigManager::setLatencyTracing(bool enable) {
+    if (m_latencyTracing != enable) {
+        m_latencyTracing = enable;
+        saveConfig();
+        emit configChanged();
+    }
+}
+
+// 검사 통계 엔드포인트 포트
+int ConfigManager::getStatsPort() const {
+    return m_statsPort;
+}
+
+void ConfigManager::setStatsPort(int port) {
+    if (m_statsPort != port) {
+        m_statsPort = port;
+        saveConfig();
+        emit configChanged();
+    }
+}
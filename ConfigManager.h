@@ -63,6 +63,22 @@ public:
     bool getSaveTriggerImages() const;
     void setSaveTriggerImages(bool enable);
     
+    // Bayer 디모자이크 설정 (0: 빠름, 1: 에지 보간, 2: VNG, 3: Spinnaker 방향성 필터 - 기본)
+    // 모두 검사 단계에서 변환: 0~2는 OpenCV 띠 병렬 변환, 3은 카메라 SDK 알고리즘 (기존 화질)
+    int getDemosaicQuality() const;
+    void setDemosaicQuality(int quality);
+    
+    bool getDemosaicGrayOutput() const;
+    void setDemosaicGrayOutput(bool enable);
+    
+    // 트리거 → 결과 지연 추적 (검사 중지 시 traces/ 폴더에 Chrome trace JSON 저장)
+    bool getLatencyTracing() const;
+    void setLatencyTracing(bool enable);
+    
+    // 검사 통계 엔드포인트 포트 (127.0.0.1, 0: 꺼짐)
+    int getStatsPort() const;
+    void setStatsPort(int port);
+    
     // 프로퍼티 패널 설정
     QRect getPropertyPanelGeometry() const;
     void setPropertyPanelGeometry(const QRect& geometry);
@@ -104,6 +120,10 @@ private:
     int m_heartbeatInterval;
     bool m_cameraAutoConnect;
     bool m_saveTriggerImages;
+    int m_demosaicQuality;
+    bool m_demosaicGrayOutput;
+    bool m_latencyTracing;
+    int m_statsPort;
     
     // 프로퍼티 패널 설정
     QRect m_propertyPanelGeometry;
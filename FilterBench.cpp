@@ -0,0 +1,147 @@
+// ===== filter_bench: 필터 커널 마이크로 벤치마크 =====
+// 밝기/대비/Canny 필터의 기존 픽셀 루프 구현과 현재 구현(LUT, SIMD 색변환)을 5MP 프레임에서 비교한다.
+// 결과가 기존 구현과 픽셀 단위로 같은지도 함께 확인한다.
+//   filter_bench [반복 횟수=20] [너비=2448] [높이=2048]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "ImageProcessor.h"
+
+namespace {
+    const int DEFAULT_ITERATIONS = 20;
+    const int DEFAULT_WIDTH = 2448;             // Sony IMX264 5MP
+    const int DEFAULT_HEIGHT = 2048;
+
+    // ----- 기존 구현 (비교 기준) -----
+    void legacyBrightness(const cv::Mat &src, cv::Mat &dst, int value)
+    {
+        src.copyTo(dst);
+        for (int y = 0; y < dst.rows; y++)
+            for (int x = 0; x < dst.cols; x++)
+                for (int c = 0; c < 3; c++)
+                {
+                    int pixel = dst.at<cv::Vec3b>(y, x)[c] + value;
+                    dst.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(pixel);
+                }
+    }
+
+    void legacyContrast(const cv::Mat &src, cv::Mat &dst, int value)
+    {
+        src.copyTo(dst);
+        double factor = (259.0 * (value + 255)) / (255.0 * (259 - value));
+        for (int y = 0; y < dst.rows; y++)
+            for (int x = 0; x < dst.cols; x++)
+                for (int c = 0; c < 3; c++)
+                {
+                    int pixel = static_cast<int>(factor * (dst.at<cv::Vec3b>(y, x)[c] - 128) + 128);
+                    dst.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(pixel);
+                }
+    }
+
+    void legacyCanny(const cv::Mat &src, cv::Mat &dst, int threshold1, int threshold2)
+    {
+        cv::Mat gray, edges;
+        cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
+        cv::Canny(gray, edges, threshold1, threshold2);
+        dst = cv::Mat::zeros(src.size(), src.type());
+        for (int y = 0; y < edges.rows; y++)
+            for (int x = 0; x < edges.cols; x++)
+                if (edges.at<uchar>(y, x) > 0)
+                    dst.at<cv::Vec3b>(y, x) = cv::Vec3b(255, 255, 255);
+    }
+
+    // 밝기 -> 대비 -> 이진화를 필터마다 전체 영상 한 번씩 (기존 applyFilters 방식)
+    void legacyChain(const cv::Mat &src, cv::Mat &dst)
+    {
+        cv::Mat bright, contrast;
+        legacyBrightness(src, bright, 20);
+        legacyContrast(bright, contrast, 40);
+        ImageProcessor::applyThresholdFilter(contrast, dst, 128, cv::THRESH_BINARY);
+    }
+
+    struct Timing {
+        double minMs = 0.0;
+        double medianMs = 0.0;
+    };
+
+    Timing measure(int iterations, const std::function<void()> &run)
+    {
+        run();  // 버퍼 할당/캐시 워밍업
+        std::vector<double> samples;
+        for (int i = 0; i < iterations; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            samples.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(samples.begin(), samples.end());
+        return {samples.front(), samples[samples.size() / 2]};
+    }
+
+    bool identical(const cv::Mat &a, const cv::Mat &b)
+    {
+        return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0.0;
+    }
+
+    void report(const char *name, const Timing &legacy, const Timing &current, bool same)
+    {
+        printf("%-22s %10.2f %10.2f %10.2f %10.2f %8.1fx  %s\n", name,
+               legacy.medianMs, legacy.minMs, current.medianMs, current.minMs,
+               current.medianMs > 0.0 ? legacy.medianMs / current.medianMs : 0.0,
+               same ? "동일" : "불일치");
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : DEFAULT_ITERATIONS;
+    const int width = argc > 2 ? std::max(16, atoi(argv[2])) : DEFAULT_WIDTH;
+    const int height = argc > 3 ? std::max(16, atoi(argv[3])) : DEFAULT_HEIGHT;
+
+    // 잡음 + 블러로 엣지가 적당히 있는 BGR 프레임
+    cv::Mat frame(height, width, CV_8UC3);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::GaussianBlur(frame, frame, cv::Size(9, 9), 0);
+
+    printf("프레임 %dx%d BGR, 반복 %d회 (단위 ms)\n", width, height, iterations);
+    printf("%-22s %10s %10s %10s %10s %9s  %s\n", "필터", "기존 중앙", "기존 최소", "현재 중앙", "현재 최소", "배속", "결과");
+
+    cv::Mat legacyOut, currentOut;
+    bool allSame = true;
+
+    Timing legacy = measure(iterations, [&]() { legacyBrightness(frame, legacyOut, 35); });
+    Timing current = measure(iterations, [&]() { ImageProcessor::applyBrightnessFilter(frame, currentOut, 35); });
+    bool same = identical(legacyOut, currentOut);
+    allSame &= same;
+    report("밝기 (+35)", legacy, current, same);
+
+    legacy = measure(iterations, [&]() { legacyContrast(frame, legacyOut, 60); });
+    current = measure(iterations, [&]() { ImageProcessor::applyContrastFilter(frame, currentOut, 60); });
+    same = identical(legacyOut, currentOut);
+    allSame &= same;
+    report("대비 (+60)", legacy, current, same);
+
+    legacy = measure(iterations, [&]() { legacyCanny(frame, legacyOut, 50, 150); });
+    current = measure(iterations, [&]() { ImageProcessor::applyCannyFilter(frame, currentOut, 50, 150); });
+    same = identical(legacyOut, currentOut);
+    allSame &= same;
+    report("Canny (50/150)", legacy, current, same);
+
+    FilterInfo brightness{FILTER_BRIGHTNESS, {{"brightness", 20}}};
+    FilterInfo contrast{FILTER_CONTRAST, {{"contrast", 40}}};
+    FilterInfo threshold{FILTER_THRESHOLD, {{"threshold", 128}, {"thresholdType", cv::THRESH_BINARY}}};
+    const FilterChain chain({brightness, contrast, threshold});
+    legacy = measure(iterations, [&]() { legacyChain(frame, legacyOut); });
+    current = measure(iterations, [&]() { chain.apply(frame, currentOut); });
+    same = identical(legacyOut, currentOut);
+    allSame &= same;
+    report("체인 밝기+대비+이진화", legacy, current, same);
+
+    return allSame ? 0 : 1;
+}
@@ -11,6 +11,11 @@
 #include <QApplication>
 #include <QScreen>
 
+namespace {
+    // 슬라이더 드래그 중 미리보기 재계산 간격 (이 사이에 들어온 변경은 한 번으로 병합)
+    const int PREVIEW_COALESCE_MS = 16;
+}
+
 FilterDialog::FilterDialog(CameraView* cameraView, int patternIndex, QWidget* parent)
     : QWidget(parent), cameraView(cameraView), patternIndex(-1), dragging(false)
 {
@@ -25,6 +30,11 @@ FilterDialog::FilterDialog(CameraView* cameraView, int patternIndex, QWidget* pa
     setAttribute(Qt::WA_TranslucentBackground);
     setMinimumSize(700, 500);
 
+    previewTimer = new QTimer(this);
+    previewTimer->setSingleShot(true);
+    previewTimer->setInterval(PREVIEW_COALESCE_MS);
+    connect(previewTimer, &QTimer::timeout, this, &FilterDialog::renderFilterPreview);
+
     setupUI();
     setPatternIndex(patternIndex);
     
@@ -490,6 +500,7 @@ void FilterDialog::onFilterParamChanged(const QString& paramName, int value) {
 void FilterDialog::setPatternId(const QUuid& id) {
     
     appliedFilters.clear();
+    resetPreviewCache();
     this->patternId = id;
     
     // 유효한 패턴 정보 설정
@@ -526,6 +537,7 @@ void FilterDialog::setPatternId(const QUuid& id) {
 
 void FilterDialog::setPatternIndex(int index) {
     appliedFilters.clear();
+    resetPreviewCache();
     this->patternIndex = index;
     QLabel* patternLabel = findChild<QLabel*>("patternInfoLabel");
     bool isValid = false;
@@ -655,141 +667,11 @@ void FilterDialog::updateFilterParam(int filterType, const QString& paramName, i
         // 기존 필터의 파라미터 업데이트
         cameraView->setPatternFilterParam(patternId, existingFilterIndex, paramName, value);
         
-        // 컨투어 필터 특별 처리
-        if (filterType == FILTER_CONTOUR) {
-            if (auto parentWidget = qobject_cast<TeachingWidget*>(this->parentWidget())) {
-                cv::Mat filteredFrame = parentWidget->getCurrentFilteredFrame();
-                if (!filteredFrame.empty()) {
-                    PatternInfo* pattern = cameraView->getPatternById(patternId);
-                    if (pattern) {
-                        cv::Rect roi(pattern->rect.x(), pattern->rect.y(),
-                                   pattern->rect.width(), pattern->rect.height());
-                        
-                        if (roi.x >= 0 && roi.y >= 0 &&
-                            roi.x + roi.width <= filteredFrame.cols &&
-                            roi.y + roi.height <= filteredFrame.rows) {
-                            
-                            cv::Mat roiMat = filteredFrame(roi).clone();
-                            
-                            const QList<FilterInfo>& filters = cameraView->getPatternFilters(patternId);
-                            if (existingFilterIndex < filters.size()) {
-                                int threshold = filters[existingFilterIndex].params.value("threshold", 128);
-                                int minArea = filters[existingFilterIndex].params.value("minArea", 100);
-                                int contourMode = filters[existingFilterIndex].params.value("contourMode", cv::RETR_EXTERNAL);
-                                int contourApprox = filters[existingFilterIndex].params.value("contourApprox", cv::CHAIN_APPROX_SIMPLE);
-                                int contourTarget = filters[existingFilterIndex].params.value("contourTarget", 0);
-                                
-                                QList<QVector<QPoint>> contours = ImageProcessor::extractContours(
-                                    roiMat, threshold, minArea, contourMode, contourApprox, contourTarget);
-                                
-                                for (QVector<QPoint>& contour : contours) {
-                                    for (QPoint& pt : contour) {
-                                        pt += QPoint(roi.x, roi.y);
-                                    }
-                                }
-                                
-                                cameraView->setPatternContours(patternId, contours);
-                            }
-                        }
-                    }
-                }
-            }
-        }
-        
         // 화면 갱신
         cameraView->update();
         
-        // FilterDialog에서도 필터 적용 결과를 직접 렌더링 (cam on/off 구분 없이)
-        if (auto parentWidget = qobject_cast<TeachingWidget*>(this->parentWidget())) {
-            PatternInfo* pattern = cameraView->getPatternById(patternId);
-            if (pattern && existingFilterIndex < pattern->filters.size()) {
-                const FilterInfo& filter = pattern->filters[existingFilterIndex];
-                
-                cv::Mat sourceFrame = parentWidget->getCurrentFrame();
-                if (!sourceFrame.empty()) {
-                    sourceFrame = sourceFrame.clone();
-                    
-                    // 회전이 있는 경우: 회전된 사각형 영역에만 필터 적용
-                    if (std::abs(pattern->angle) > 0.1) {
-                        cv::Point2f center(pattern->rect.x() + pattern->rect.width() / 2.0f,
-                                          pattern->rect.y() + pattern->rect.height() / 2.0f);
-
-                        cv::Mat mask = cv::Mat::zeros(sourceFrame.size(), CV_8UC1);
-                        cv::Size2f patternSize(pattern->rect.width(), pattern->rect.height());
-
-                        cv::Point2f vertices[4];
-                        cv::RotatedRect rotatedRect(center, patternSize, pattern->angle);
-                        rotatedRect.points(vertices);
-
-                        std::vector<cv::Point> points;
-                        for (int i = 0; i < 4; i++) {
-                            points.push_back(cv::Point(static_cast<int>(std::round(vertices[i].x)),
-                                                      static_cast<int>(std::round(vertices[i].y))));
-                        }
-                        cv::fillPoly(mask, std::vector<std::vector<cv::Point>>{points}, cv::Scalar(255));
-
-                        cv::Mat maskedImage = cv::Mat::zeros(sourceFrame.size(), sourceFrame.type());
-                        sourceFrame.copyTo(maskedImage, mask);
-
-                        double width = pattern->rect.width();
-                        double height = pattern->rect.height();
-
-                        int rotatedWidth, rotatedHeight;
-                        parentWidget->calculateRotatedBoundingBox(width, height, pattern->angle, rotatedWidth, rotatedHeight);
-
-                        int maxSize = std::max(rotatedWidth, rotatedHeight);
-                        int halfSize = maxSize / 2;
-
-                        cv::Rect expandedRoi(
-                            qBound(0, static_cast<int>(center.x) - halfSize, sourceFrame.cols - 1),
-                            qBound(0, static_cast<int>(center.y) - halfSize, sourceFrame.rows - 1),
-                            qBound(1, maxSize, sourceFrame.cols - (static_cast<int>(center.x) - halfSize)),
-                            qBound(1, maxSize, sourceFrame.rows - (static_cast<int>(center.y) - halfSize)));
-
-                        if (expandedRoi.width > 0 && expandedRoi.height > 0 &&
-                            expandedRoi.x + expandedRoi.width <= maskedImage.cols &&
-                            expandedRoi.y + expandedRoi.height <= maskedImage.rows) {
-                            cv::Mat roiMat = maskedImage(expandedRoi);
-                            ImageProcessor processor;
-                            cv::Mat filteredRoi;
-                            processor.applyFilter(roiMat, filteredRoi, filter);
-                            if (!filteredRoi.empty()) {
-                                filteredRoi.copyTo(roiMat);
-                            }
-                        }
-
-                        maskedImage.copyTo(sourceFrame, mask);
-                    }
-                    else {
-                        // 회전이 없는 경우
-                        cv::Rect roi(
-                            qBound(0, static_cast<int>(pattern->rect.x()), sourceFrame.cols - 1),
-                            qBound(0, static_cast<int>(pattern->rect.y()), sourceFrame.rows - 1),
-                            qBound(1, static_cast<int>(pattern->rect.width()), sourceFrame.cols - static_cast<int>(pattern->rect.x())),
-                            qBound(1, static_cast<int>(pattern->rect.height()), sourceFrame.rows - static_cast<int>(pattern->rect.y())));
-
-                        if (roi.width > 0 && roi.height > 0) {
-                            cv::Mat roiMat = sourceFrame(roi);
-                            ImageProcessor processor;
-                            cv::Mat filteredRoi;
-                            processor.applyFilter(roiMat, filteredRoi, filter);
-                            if (!filteredRoi.empty()) {
-                                filteredRoi.copyTo(roiMat);
-                            }
-                        }
-                    }
-                    
-                    cv::Mat rgbFrame;
-                    cv::cvtColor(sourceFrame, rgbFrame, cv::COLOR_BGR2RGB);
-                    QImage image(rgbFrame.data, rgbFrame.cols, rgbFrame.rows,
-                                rgbFrame.step, QImage::Format_RGB888);
-                    QPixmap pixmap = QPixmap::fromImage(image.copy());
-                    
-                    cameraView->setBackgroundPixmap(pixmap);
-                    cameraView->viewport()->update();
-                }
-            }
-        }
+        // 필터 적용 결과 미리보기 (cam on/off 구분 없이) - 드래그 중 변경은 병합해서 한 번에 계산
+        schedulePreview(filterType == FILTER_CONTOUR);
     } else {
         // 새로운 필터 추가 및 파라미터 설정
         cameraView->addPatternFilter(patternId, filterType);
@@ -843,6 +725,164 @@ void FilterDialog::updateFilterParam(int filterType, const QString& paramName, i
     }
 }
 
+void FilterDialog::schedulePreview(bool contourChanged) {
+    previewContourPending = previewContourPending || contourChanged;
+    
+    // 이미 예약되어 있으면 그 때 최신 파라미터로 한 번만 계산
+    if (!previewTimer->isActive()) {
+        previewTimer->start();
+    }
+}
+
+void FilterDialog::resetPreviewCache() {
+    if (previewTimer) {
+        previewTimer->stop();
+    }
+    previewStages.clear();
+    previewRaw.release();
+    previewInput.release();
+    previewGeometry = 0;
+    previewContourPending = false;
+}
+
+void FilterDialog::updateContourPreview(int filterIndex) {
+    auto parentWidget = qobject_cast<TeachingWidget*>(this->parentWidget());
+    if (!parentWidget) {
+        return;
+    }
+    
+    cv::Mat filteredFrame = parentWidget->getCurrentFilteredFrame();
+    if (filteredFrame.empty()) {
+        return;
+    }
+    
+    PatternInfo* pattern = cameraView->getPatternById(patternId);
+    if (!pattern || filterIndex < 0 || filterIndex >= pattern->filters.size()) {
+        return;
+    }
+    
+    cv::Rect roi(pattern->rect.x(), pattern->rect.y(),
+               pattern->rect.width(), pattern->rect.height());
+    
+    if (roi.x < 0 || roi.y < 0 ||
+        roi.x + roi.width > filteredFrame.cols ||
+        roi.y + roi.height > filteredFrame.rows) {
+        return;
+    }
+    
+    cv::Mat roiMat = filteredFrame(roi).clone();
+    
+    const FilterInfo& filter = pattern->filters[filterIndex];
+    int threshold = filter.params.value("threshold", 128);
+    int minArea = filter.params.value("minArea", 100);
+    int contourMode = filter.params.value("contourMode", cv::RETR_EXTERNAL);
+    int contourApprox = filter.params.value("contourApprox", cv::CHAIN_APPROX_SIMPLE);
+    int contourTarget = filter.params.value("contourTarget", 0);
+    
+    QList<QVector<QPoint>> contours = ImageProcessor::extractContours(
+        roiMat, threshold, minArea, contourMode, contourApprox, contourTarget);
+    
+    for (QVector<QPoint>& contour : contours) {
+        for (QPoint& pt : contour) {
+            pt += QPoint(roi.x, roi.y);
+        }
+    }
+    
+    cameraView->setPatternContours(patternId, contours);
+}
+
+void FilterDialog::renderFilterPreview() {
+    auto parentWidget = qobject_cast<TeachingWidget*>(this->parentWidget());
+    if (!parentWidget || patternId.isNull()) {
+        return;
+    }
+    
+    PatternInfo* pattern = cameraView->getPatternById(patternId);
+    if (!pattern) {
+        return;
+    }
+    
+    // 컨투어 필터 특별 처리 (병합된 변경 중 컨투어 파라미터가 있었을 때만)
+    if (previewContourPending) {
+        previewContourPending = false;
+        for (int i = 0; i < pattern->filters.size(); i++) {
+            if (pattern->filters[i].type == FILTER_CONTOUR) {
+                updateContourPreview(i);
+                break;
+            }
+        }
+    }
+    
+    cv::Mat sourceFrame = parentWidget->getCurrentFrame();
+    if (sourceFrame.empty()) {
+        return;
+    }
+    
+    // 1. 필터를 적용할 영역 계산 (메인 화면 미리보기와 같은 영역/마스크)
+    const FilterPreviewRegion previewRegion =
+        FilterPreviewRegion::compute(pattern->rect, pattern->angle, sourceFrame.size());
+    if (!previewRegion.isValid()) {
+        return;
+    }
+    const bool rotated = previewRegion.rotated;
+    const cv::Rect roi = previewRegion.roi;
+    cv::Mat region = sourceFrame(roi);
+    
+    // 2. 패턴/영역/원본 픽셀이 바뀌었으면 첫 단계 입력을 다시 만들고 단계 캐시를 비움
+    const size_t geometry = qHashMulti(qHash(patternId), pattern->rect.x(), pattern->rect.y(),
+                                       pattern->rect.width(), pattern->rect.height(),
+                                       rotated ? pattern->angle : 0.0,
+                                       roi.x, roi.y, roi.width, roi.height, sourceFrame.type());
+    bool sameSource = geometry == previewGeometry &&
+                      previewRaw.size() == region.size() && previewRaw.type() == region.type() &&
+                      cv::norm(previewRaw, region, cv::NORM_INF) == 0.0;
+    if (!sameSource) {
+        region.copyTo(previewRaw);
+        previewRegion.makeInput(previewRaw, previewInput);
+        previewGeometry = geometry;
+        previewStages.clear();
+    }
+    
+    // 3. 바뀐 필터부터 끝까지만 다시 계산 (앞 단계 출력은 그대로 재사용)
+    const QList<FilterInfo>& filters = pattern->filters;
+    previewStages.resize(filters.size());
+    cv::Mat current = previewInput;
+    bool upstreamValid = true;
+    try {
+        for (int i = 0; i < filters.size(); i++) {
+            const QList<FilterInfo> single{filters[i]};
+            const size_t signature = FilterChain::computeSignature(single, !rotated);
+            PreviewStage& stage = previewStages[i];
+            
+            if (!upstreamValid || stage.signature != signature || stage.output.empty()) {
+                upstreamValid = false;
+                FilterChain(single, !rotated).apply(current, stage.output);
+                if (stage.output.empty()) {
+                    current.copyTo(stage.output);
+                }
+                stage.signature = signature;
+            }
+            current = stage.output;
+        }
+    } catch (const std::exception& e) {
+        qDebug() << "[FilterDialog::renderFilterPreview] 필터 적용 실패:" << e.what();
+        previewStages.clear();
+        return;
+    }
+    
+    // 4. 결과를 프레임에 반영해서 표시 (회전 패턴은 마스크 영역만)
+    previewRegion.writeBack(current, sourceFrame);
+    
+    cv::Mat rgbFrame;
+    cv::cvtColor(sourceFrame, rgbFrame, cv::COLOR_BGR2RGB);
+    QImage image(rgbFrame.data, rgbFrame.cols, rgbFrame.rows,
+                rgbFrame.step, QImage::Format_RGB888);
+    QPixmap pixmap = QPixmap::fromImage(image.copy());
+    
+    cameraView->setBackgroundPixmap(pixmap);
+    cameraView->viewport()->update();
+}
+
 QMap<QString, int> FilterDialog::getFilterParams(int filterType) {
     if (filterWidgets.contains(filterType)) {
         return filterWidgets[filterType]->getParams();
@@ -851,6 +891,8 @@ QMap<QString, int> FilterDialog::getFilterParams(int filterType) {
 }
 
 void FilterDialog::onCancelClicked() {
+    resetPreviewCache();
+
     // 취소 시 필터 원래대로 복구
     if (!patternId.isNull() && cameraView) {
         PatternInfo* pattern = cameraView->getPatternById(patternId);
@@ -892,6 +934,7 @@ void FilterDialog::onCancelClicked() {
 }
 
 void FilterDialog::onApplyClicked() {
+    resetPreviewCache();
     
     // 패턴 ID 확인
     if (patternId.isNull()) {
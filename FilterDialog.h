@@ -10,6 +10,7 @@
 #include <QFileDialog>
 #include <QFile>
 #include <QTextStream>
+#include <QTimer>
 #include "CameraView.h"
 #include "ImageProcessor.h"
 #include "FilterPropertyWidget.h"
@@ -28,6 +29,7 @@ private slots:
     void onApplyClicked();
     void onFilterCheckStateChanged(int state);
     void onFilterParamChanged(const QString& paramName, int value);
+    void renderFilterPreview();   // 병합된 파라미터 변경을 한 번에 미리보기로 반영
 
 private:
     void setupUI();
@@ -39,6 +41,9 @@ private:
     QUuid getPatternId(int index) const;
     void updateUIFromFilters();
     void updateFilterParam(int filterType, const QString& paramName, int value);
+    void schedulePreview(bool contourChanged);
+    void updateContourPreview(int filterIndex);
+    void resetPreviewCache();
 
     CameraView* cameraView;
     int patternIndex;
@@ -51,6 +56,19 @@ private:
     QMap<int, FilterPropertyWidget*> filterWidgets;
     QMap<int, FilterInfo> appliedFilters;
     QMap<int, QMap<QString, int>> defaultParams;
+
+    // 파라미터 조정 미리보기 캐시 (패턴 영역 기준)
+    // 단계 k의 출력 = 필터 0..k 적용 결과. 필터 k가 바뀌면 k..n 단계만 다시 계산한다.
+    struct PreviewStage {
+        size_t signature = 0;   // 해당 필터 하나의 시그니처
+        cv::Mat output;
+    };
+    QVector<PreviewStage> previewStages;
+    cv::Mat previewRaw;         // 필터 적용 전 패턴 영역 (프레임 변경 감지용)
+    cv::Mat previewInput;       // 첫 단계 입력 (회전 패턴은 마스크 밖을 0으로)
+    size_t previewGeometry = 0; // 패턴 ID + 영역 + 각도 + 영상 형식
+    QTimer* previewTimer = nullptr;     // 슬라이더 이벤트 병합 (재계산은 한 번에 하나만)
+    bool previewContourPending = false;
     
     // 드래그 관련
     bool dragging;
@@ -2,6 +2,7 @@
 #include <opencv2/imgproc.hpp>
 #include <QDebug>
 #include <QFile>
+#include <QHash>
 #include <QFileInfo>
 #include <QTextStream>
 #include <algorithm>
@@ -184,149 +185,394 @@ bool ImageProcessor::compareContours(const cv::Mat &ref, const cv::Mat &target,
     return diffValue <= threshold;
 }
 
-// 단일 필터 적용 함수
+// 단일 필터 적용 함수 (필터 하나짜리 체인: 파라미터 해석과 LUT 변환을 FilterChain과 공유)
 void ImageProcessor::applyFilter(cv::Mat &src, cv::Mat &dst, const FilterInfo &filter)
 {
-    if (!filter.enabled)
+    FilterChain(QList<FilterInfo>{filter}).apply(src, dst);
+}
+
+// 여러 필터 순차 적용 함수
+void ImageProcessor::applyFilters(cv::Mat &image, const QList<FilterInfo> &filters, const cv::Rect &roi)
+{
+    if (filters.isEmpty())
+        return;
+
+    // ROI 유효성 검사
+    if (roi.width <= 0 || roi.height <= 0 ||
+        roi.x < 0 || roi.y < 0 ||
+        roi.x + roi.width > image.cols ||
+        roi.y + roi.height > image.rows)
     {
-        src.copyTo(dst); // 필터 비활성화 시 원본 그대로 리턴
         return;
     }
 
-    switch (filter.type)
+    // ROI 영역만 복사하여 처리 (블러 등이 ROI 밖 픽셀을 읽지 않도록), 결과는 한 번만 되돌려 복사
+    cv::Mat roiMat = image(roi).clone();
+    cv::Mat filtered;
+    FilterChain(filters, true).apply(roiMat, filtered);
+    filtered.copyTo(image(roi));
+}
+
+// ===== FilterChain =====
+
+namespace {
+    // 체인 중간 결과용 스레드별 버퍼 (스레드마다 ROI 크기만큼 한 번 할당 후 재사용)
+    thread_local cv::Mat chainBuffers[2];
+    thread_local cv::Mat chainGrayBuffer;
+
+    cv::Mat identityLut()
     {
-    case FILTER_THRESHOLD:
+        cv::Mat lut(1, 256, CV_8U);
+        for (int i = 0; i < 256; i++)
+            lut.at<uchar>(i) = static_cast<uchar>(i);
+        return lut;
+    }
+
+    // 밝기: 채널값 + value (포화)
+    cv::Mat brightnessLut(int value)
     {
-        int threshold = filter.params.value("threshold", 128);
-        int thresholdType = filter.params.value("thresholdType", cv::THRESH_BINARY);
-        int blockSize = filter.params.value("blockSize", 11);
-        int C = filter.params.value("C", 2);
+        cv::Mat lut(1, 256, CV_8U);
+        for (int i = 0; i < 256; i++)
+            lut.at<uchar>(i) = cv::saturate_cast<uchar>(i + value);
+        return lut;
+    }
 
-        applyThresholdFilter(src, dst, threshold, thresholdType, blockSize, C);
-        break;
+    // 대비: factor * (채널값 - 128) + 128 (int 변환 후 포화)
+    cv::Mat contrastLut(int value)
+    {
+        cv::Mat lut(1, 256, CV_8U);
+        double factor = (259.0 * (value + 255)) / (255.0 * (259 - value));
+        for (int i = 0; i < 256; i++)
+            lut.at<uchar>(i) = cv::saturate_cast<uchar>(static_cast<int>(factor * (i - 128) + 128));
+        return lut;
     }
-    case FILTER_BLUR:
+
+    // cv::threshold(8U, maxval 255)와 같은 결과
+    cv::Mat thresholdLut(int threshold, int thresholdType)
     {
-        int kernelSize = validateKernelSize(filter.params.value("kernelSize", 3));
-        applyBlurFilter(src, dst, kernelSize);
-        break;
+        cv::Mat lut(1, 256, CV_8U);
+        for (int i = 0; i < 256; i++)
+        {
+            bool above = i > threshold;
+            int value = i;
+            switch (thresholdType)
+            {
+            case cv::THRESH_BINARY:     value = above ? 255 : 0; break;
+            case cv::THRESH_BINARY_INV: value = above ? 0 : 255; break;
+            case cv::THRESH_TRUNC:      value = above ? threshold : i; break;
+            case cv::THRESH_TOZERO:     value = above ? i : 0; break;
+            case cv::THRESH_TOZERO_INV: value = above ? 0 : i; break;
+            }
+            lut.at<uchar>(i) = cv::saturate_cast<uchar>(value);
+        }
+        return lut;
     }
-    case FILTER_CANNY:
+
+    // 결과 표시용 복사 (필터 체인 Native 출력 등 1채널 영상은 3채널로 복원)
+    void copyForDisplay(const cv::Mat &src, cv::Mat &dst)
     {
-        int threshold1 = filter.params.value("threshold1", 100);
-        int threshold2 = filter.params.value("threshold2", 200);
-        applyCannyFilter(src, dst, threshold1, threshold2);
-        break;
+        if (src.channels() == 1)
+            cv::cvtColor(src, dst, cv::COLOR_GRAY2BGR);
+        else
+            src.copyTo(dst);
     }
-    case FILTER_SOBEL:
+
+    bool isLutThresholdType(int thresholdType)
     {
-        int kernelSize = validateKernelSize(filter.params.value("sobelKernelSize", 3));
-        applySobelFilter(src, dst, kernelSize);
-        break;
+        return thresholdType == cv::THRESH_BINARY || thresholdType == cv::THRESH_BINARY_INV ||
+               thresholdType == cv::THRESH_TRUNC || thresholdType == cv::THRESH_TOZERO ||
+               thresholdType == cv::THRESH_TOZERO_INV;
     }
-    case FILTER_LAPLACIAN:
+}
+
+FilterChain::FilterChain(const QList<FilterInfo> &filters, bool applyMask)
+    : m_signature(computeSignature(filters, applyMask))
+{
+    for (const FilterInfo &filter : filters)
     {
-        int kernelSize = validateKernelSize(filter.params.value("laplacianKernelSize", 3));
-        applyLaplacianFilter(src, dst, kernelSize);
-        break;
+        if (!filter.enabled)
+            continue;
+
+        Step step;
+        step.type = filter.type;
+        switch (filter.type)
+        {
+        case FILTER_BRIGHTNESS:
+            appendPointOp(StepKind::Lut, brightnessLut(filter.params.value("brightness", 0)));
+            continue;
+        case FILTER_CONTRAST:
+            appendPointOp(StepKind::Lut, contrastLut(filter.params.value("contrast", 0)));
+            continue;
+        case FILTER_THRESHOLD:
+        {
+            int threshold = filter.params.value("threshold", 128);
+            int thresholdType = filter.params.value("thresholdType", cv::THRESH_BINARY);
+            if (isLutThresholdType(thresholdType))
+            {
+                appendPointOp(StepKind::GrayLut, thresholdLut(threshold, thresholdType));
+                continue;
+            }
+            step.params[0] = threshold;
+            step.params[1] = thresholdType;
+            step.params[2] = filter.params.value("blockSize", 11);
+            step.params[3] = filter.params.value("C", 2);
+            break;
+        }
+        case FILTER_BLUR:
+            step.params[0] = ImageProcessor::validateKernelSize(filter.params.value("kernelSize", 3));
+            break;
+        case FILTER_CANNY:
+            step.params[0] = filter.params.value("threshold1", 100);
+            step.params[1] = filter.params.value("threshold2", 200);
+            break;
+        case FILTER_SOBEL:
+            step.params[0] = ImageProcessor::validateKernelSize(filter.params.value("sobelKernelSize", 3));
+            break;
+        case FILTER_LAPLACIAN:
+            step.params[0] = ImageProcessor::validateKernelSize(filter.params.value("laplacianKernelSize", 3));
+            break;
+        case FILTER_SHARPEN:
+            step.params[0] = filter.params.value("sharpenStrength", 3);
+            break;
+        case FILTER_CONTOUR:
+            step.params[0] = filter.params.value("threshold", 128);
+            step.params[1] = filter.params.value("minArea", 100);
+            step.params[2] = filter.params.value("thickness", 2);
+            step.params[3] = filter.params.value("contourMode", cv::RETR_EXTERNAL);
+            step.params[4] = filter.params.value("contourApprox", cv::CHAIN_APPROX_SIMPLE);
+            break;
+        case FILTER_REFLECTION_CHROMATICITY:
+            step.params[0] = filter.params.value("reflectionThreshold", 200);
+            step.params[1] = filter.params.value("inpaintRadius", 3);
+            break;
+        case FILTER_REFLECTION_INPAINTING:
+            step.params[0] = filter.params.value("reflectionThreshold", 200);
+            step.params[1] = filter.params.value("inpaintRadius", 5);
+            step.params[2] = filter.params.value("inpaintMethod", cv::INPAINT_TELEA);
+            break;
+        case FILTER_MASK:
+            if (!applyMask)
+                continue;
+            step.kind = StepKind::Mask;
+            step.params[0] = filter.params.value("maskValue", 255);
+            break;
+        default:
+            continue; // 알 수 없는 필터 유형은 건너뜀 (원본 그대로)
+        }
+        m_steps.push_back(step);
     }
-    case FILTER_SHARPEN:
+}
+
+size_t FilterChain::computeSignature(const QList<FilterInfo> &filters, bool applyMask)
+{
+    size_t seed = qHashMulti(0, filters.size(), applyMask);
+    for (const FilterInfo &filter : filters)
     {
-        int strength = filter.params.value("sharpenStrength", 3);
-        applySharpenFilter(src, dst, strength);
-        break;
+        seed = qHashMulti(seed, filter.type, filter.enabled);
+        for (auto it = filter.params.constBegin(); it != filter.params.constEnd(); ++it)
+            seed = qHashMulti(seed, it.key(), it.value());
     }
-    case FILTER_BRIGHTNESS:
+    return seed;
+}
+
+void FilterChain::appendPointOp(StepKind kind, const cv::Mat &lut)
+{
+    // 앞 단계가 LUT이면 합성 (이진화 뒤는 세 채널이 같은 그레이라 채널별 점 연산도 그레이 LUT로 합성 가능,
+    // 그레이 복원 영상의 그레이 변환은 항등이므로 이진화끼리도 합성 가능)
+    if (!m_steps.empty())
     {
-        int brightness = filter.params.value("brightness", 0);
-        applyBrightnessFilter(src, dst, brightness);
-        break;
+        Step &prev = m_steps.back();
+        bool fusable = (prev.kind == StepKind::GrayLut) ||
+                       (prev.kind == StepKind::Lut && kind == StepKind::Lut);
+        if (fusable)
+        {
+            cv::LUT(prev.lut, lut, prev.lut);
+            return;
+        }
     }
-    case FILTER_CONTRAST:
+
+    // 항등 LUT (밝기/대비 0)는 단계를 만들지 않음
+    if (kind == StepKind::Lut && cv::countNonZero(lut != identityLut()) == 0)
+        return;
+
+    Step step;
+    step.kind = kind;
+    step.lut = lut;
+    m_steps.push_back(step);
+}
+
+void FilterChain::runStep(const Step &step, const cv::Mat &src, cv::Mat &dst, bool native)
+{
+    // 개별 필터 함수는 src를 수정하지 않음 (비const 시그니처 호환용 헤더)
+    cv::Mat input = src;
+    switch (step.kind)
     {
-        int contrast = filter.params.value("contrast", 0);
-        applyContrastFilter(src, dst, contrast);
+    case StepKind::Lut:
+        cv::LUT(input, step.lut, dst);
+        return;
+    case StepKind::GrayLut:
+        if (input.channels() == 1)
+        {
+            cv::LUT(input, step.lut, dst);
+            return;
+        }
+        cv::cvtColor(input, chainGrayBuffer, cv::COLOR_RGB2GRAY);
+        if (native)
+        {
+            cv::LUT(chainGrayBuffer, step.lut, dst);
+            return;
+        }
+        // 결과를 다시 RGB로 변환 (UI 표시용, applyThresholdFilter와 동일)
+        cv::LUT(chainGrayBuffer, step.lut, chainGrayBuffer);
+        cv::cvtColor(chainGrayBuffer, dst, cv::COLOR_GRAY2RGB);
+        return;
+    case StepKind::Mask:
+        ImageProcessor::applyMaskFilter(input, dst, QRect(0, 0, input.cols, input.rows), step.params[0]);
+        return;
+    case StepKind::Filter:
         break;
     }
-    case FILTER_CONTOUR:
+
+    // Native: 그레이를 만드는 필터는 그레이 입력으로 호출해 1채널 결과를 그대로 받음
+    const bool producesGray = step.type == FILTER_THRESHOLD || step.type == FILTER_CANNY ||
+                              step.type == FILTER_SOBEL || step.type == FILTER_LAPLACIAN;
+    if (native && producesGray && input.channels() != 1)
     {
-        int threshold = filter.params.value("threshold", 128);
-        int minArea = filter.params.value("minArea", 100);
-        int thickness = filter.params.value("thickness", 2);
-        int contourMode = filter.params.value("contourMode", cv::RETR_EXTERNAL);
-        int contourApprox = filter.params.value("contourApprox", cv::CHAIN_APPROX_SIMPLE);
+        cv::cvtColor(input, chainGrayBuffer, cv::COLOR_RGB2GRAY);
+        input = chainGrayBuffer;
+    }
 
-        applyContourFilter(src, dst, threshold, minArea, thickness, contourMode, contourApprox);
+    const int *p = step.params;
+    switch (step.type)
+    {
+    case FILTER_THRESHOLD:
+        ImageProcessor::applyThresholdFilter(input, dst, p[0], p[1], p[2], p[3]);
+        break;
+    case FILTER_BLUR:
+        ImageProcessor::applyBlurFilter(input, dst, p[0]);
+        break;
+    case FILTER_CANNY:
+        ImageProcessor::applyCannyFilter(input, dst, p[0], p[1]);
+        break;
+    case FILTER_SOBEL:
+        ImageProcessor::applySobelFilter(input, dst, p[0]);
+        break;
+    case FILTER_LAPLACIAN:
+        ImageProcessor::applyLaplacianFilter(input, dst, p[0]);
+        break;
+    case FILTER_SHARPEN:
+        ImageProcessor::applySharpenFilter(input, dst, p[0]);
+        break;
+    case FILTER_CONTOUR:
+        ImageProcessor::applyContourFilter(input, dst, p[0], p[1], p[2], p[3], p[4]);
         break;
-    }
     case FILTER_REFLECTION_CHROMATICITY:
-    {
-        double threshold = filter.params.value("reflectionThreshold", 200.0);
-        int inpaintRadius = filter.params.value("inpaintRadius", 3);
-        applyReflectionRemovalChromaticity(src, dst, threshold, inpaintRadius);
+        ImageProcessor::applyReflectionRemovalChromaticity(input, dst, p[0], p[1]);
         break;
-    }
     case FILTER_REFLECTION_INPAINTING:
-    {
-        double threshold = filter.params.value("reflectionThreshold", 200.0);
-        int inpaintRadius = filter.params.value("inpaintRadius", 5);
-        int inpaintMethod = filter.params.value("inpaintMethod", cv::INPAINT_TELEA);
-        applyReflectionRemovalInpainting(src, dst, threshold, inpaintRadius, inpaintMethod);
+        ImageProcessor::applyReflectionRemovalInpainting(input, dst, p[0], p[1], p[2]);
         break;
-    }
     default:
-        src.copyTo(dst); // 알 수 없는 필터 유형은 원본 그대로 리턴
+        input.copyTo(dst);
         break;
     }
 }
 
-// 여러 필터 순차 적용 함수
-void ImageProcessor::applyFilters(cv::Mat &image, const QList<FilterInfo> &filters, const cv::Rect &roi)
+void FilterChain::apply(const cv::Mat &src, cv::Mat &dst, ChannelMode mode) const
 {
-    if (filters.isEmpty())
-        return;
+    const bool native = (mode == ChannelMode::Native);
+    // 같은 데이터를 넘기면 제자리 적용 (마지막 결과만 dst로 복사 - ROI 뷰도 그대로 갱신됨)
+    const bool inPlace = dst.data != nullptr && dst.data == src.data;
 
-    // ROI 유효성 검사
-    if (roi.width <= 0 || roi.height <= 0 ||
-        roi.x < 0 || roi.y < 0 ||
-        roi.x + roi.width > image.cols ||
-        roi.y + roi.height > image.rows)
+    if (m_steps.empty())
     {
+        if (!inPlace)
+            src.copyTo(dst);
         return;
     }
 
-    // ROI 영역만 복사하여 처리
-    cv::Mat roiMat = image(roi).clone();
-
-    // 필터 순차 적용
-    for (const FilterInfo &filter : filters)
+    // 단계 결과는 두 버퍼를 번갈아 사용, 마지막 단계는 dst에 바로 기록
+    const size_t last = m_steps.size() - 1;
+    cv::Mat current = src;
+    for (size_t i = 0; i < m_steps.size(); i++)
     {
-        if (!filter.enabled)
-            continue;
-        cv::Mat processed;
-        if (filter.type == FILTER_MASK)
-        {
-            int maskValue = filter.params.value("maskValue", 255);
-            applyMaskFilter(roiMat, processed, QRect(0, 0, roi.width, roi.height), maskValue);
-        }
-        else
-        {
-            applyFilter(roiMat, processed, filter);
-        }
-        if (!processed.empty())
+        if (i == last && !inPlace)
         {
-            processed.copyTo(roiMat);
+            runStep(m_steps[i], current, dst, native);
+            return;
         }
+        cv::Mat &out = chainBuffers[i % 2];
+        runStep(m_steps[i], current, out, native);
+        current = out;
+    }
+    current.copyTo(dst);
+}
 
-        // 처리된 영상이 비어있지 않으면 업데이트
-        if (!processed.empty())
-        {
-            processed.copyTo(roiMat);
-        }
+FilterPreviewRegion FilterPreviewRegion::compute(const QRectF &rect, double angle, const cv::Size &frameSize)
+{
+    FilterPreviewRegion region;
+    region.rotated = isRotated(angle);
+    const cv::Point2f center(rect.x() + rect.width() / 2.0f, rect.y() + rect.height() / 2.0f);
+
+    if (region.rotated)
+    {
+        // 회전된 사각형을 감싸는 정사각 영역
+        const double angleRad = std::abs(angle) * M_PI / 180.0;
+        const double rotatedWidth = std::abs(rect.width() * std::cos(angleRad)) + std::abs(rect.height() * std::sin(angleRad));
+        const double rotatedHeight = std::abs(rect.width() * std::sin(angleRad)) + std::abs(rect.height() * std::cos(angleRad));
+        const int maxSize = static_cast<int>(std::max(rotatedWidth, rotatedHeight));
+        const int halfSize = maxSize / 2;
+        region.roi = cv::Rect(static_cast<int>(center.x) - halfSize, static_cast<int>(center.y) - halfSize,
+                              maxSize, maxSize);
+    }
+    else
+    {
+        region.roi = cv::Rect(qRound(rect.x()), qRound(rect.y()), qRound(rect.width()), qRound(rect.height()));
+    }
+    region.roi &= cv::Rect(0, 0, frameSize.width, frameSize.height);
+
+    if (!region.rotated || !region.isValid())
+        return region;
+
+    // 회전된 사각형 마스크 (영역 좌표)
+    cv::Point2f vertices[4];
+    cv::RotatedRect(center, cv::Size2f(rect.width(), rect.height()), angle).points(vertices);
+    std::vector<cv::Point> points;
+    for (int i = 0; i < 4; i++)
+    {
+        points.push_back(cv::Point(static_cast<int>(std::round(vertices[i].x)) - region.roi.x,
+                                   static_cast<int>(std::round(vertices[i].y)) - region.roi.y));
+    }
+    region.mask = cv::Mat::zeros(region.roi.size(), CV_8UC1);
+    cv::fillPoly(region.mask, std::vector<std::vector<cv::Point>>{points}, cv::Scalar(255));
+    return region;
+}
+
+void FilterPreviewRegion::makeInput(const cv::Mat &source, cv::Mat &input) const
+{
+    if (!rotated)
+    {
+        input = source;
+        return;
     }
 
-    // 처리된 ROI를 원본 이미지에 복사
-    roiMat.copyTo(image(roi));
+    // 이전에 source를 공유했으면 새 버퍼로 (0 채우기가 source를 지우지 않도록)
+    if (input.data == source.data)
+        input.release();
+    input.create(source.size(), source.type());
+    input.setTo(cv::Scalar::all(0));
+    source.copyTo(input, mask);
+}
+
+void FilterPreviewRegion::writeBack(const cv::Mat &result, cv::Mat &frame) const
+{
+    cv::Mat region = frame(roi);
+    if (result.size() != region.size() || result.type() != region.type())
+        return;
+    if (rotated)
+        result.copyTo(region, mask);
+    else
+        result.copyTo(region);
 }
 
 void ImageProcessor::applyContourFilter(cv::Mat &src, cv::Mat &dst,
@@ -368,9 +614,13 @@ void ImageProcessor::applyContourFilter(cv::Mat &src, cv::Mat &dst,
 
 void ImageProcessor::applyThresholdFilter(cv::Mat &src, cv::Mat &dst, int threshold, int thresholdType, int blockSize, int C)
 {
-    // 입력 이미지를 그레이스케일로 변환
+    // 입력 이미지를 그레이스케일로 변환 (1채널 입력은 그대로 사용하고 1채널로 반환)
+    const bool expandToColor = src.channels() != 1;
     cv::Mat gray;
-    cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
+    if (expandToColor)
+        cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
+    else
+        gray = src;
 
     // 적응형 이진화 처리
     if (thresholdType == THRESH_ADAPTIVE_MEAN || thresholdType == THRESH_ADAPTIVE_GAUSSIAN)
@@ -392,7 +642,8 @@ void ImageProcessor::applyThresholdFilter(cv::Mat &src, cv::Mat &dst, int thresh
     }
 
     // 결과를 다시 RGB로 변환 (UI 표시용)
-    cv::cvtColor(dst, dst, cv::COLOR_GRAY2RGB);
+    if (expandToColor)
+        cv::cvtColor(dst, dst, cv::COLOR_GRAY2RGB);
 }
 
 // 블러 필터
@@ -404,29 +655,32 @@ void ImageProcessor::applyBlurFilter(cv::Mat &src, cv::Mat &dst, int kernelSize)
 // 캐니 엣지 검출 필터
 void ImageProcessor::applyCannyFilter(cv::Mat &src, cv::Mat &dst, int threshold1, int threshold2)
 {
+    // 1채널 입력은 변환 없이 처리하고 1채널 엣지 영상으로 반환
+    if (src.channels() == 1)
+    {
+        cv::Canny(src, dst, threshold1, threshold2);
+        return;
+    }
+
     cv::Mat gray, edges;
     cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
     cv::Canny(gray, edges, threshold1, threshold2);
 
     // 엣지 결과를 컬러로 변환 (검은 배경에 흰색 엣지)
-    dst = cv::Mat::zeros(src.size(), src.type());
-    for (int y = 0; y < edges.rows; y++)
-    {
-        for (int x = 0; x < edges.cols; x++)
-        {
-            if (edges.at<uchar>(y, x) > 0)
-            {
-                dst.at<cv::Vec3b>(y, x) = cv::Vec3b(255, 255, 255);
-            }
-        }
-    }
+    // Canny 출력은 0/255뿐이므로 채널 복제가 곧 흰색 엣지 (SIMD 변환, 픽셀 루프 없음)
+    cv::cvtColor(edges, dst, cv::COLOR_GRAY2RGB);
 }
 
 // 소벨 엣지 검출 필터
 void ImageProcessor::applySobelFilter(cv::Mat &src, cv::Mat &dst, int kernelSize)
 {
-    cv::Mat gray, grad_x, grad_y, abs_grad_x, abs_grad_y, sobel_result;
-    cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
+    // 1채널 입력은 변환 없이 처리하고 1채널로 반환
+    const bool expandToColor = src.channels() != 1;
+    cv::Mat gray, grad_x, grad_y, abs_grad_x, abs_grad_y;
+    if (expandToColor)
+        cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
+    else
+        gray = src;
 
     cv::Sobel(gray, grad_x, CV_16S, 1, 0, kernelSize);
     cv::Sobel(gray, grad_y, CV_16S, 0, 1, kernelSize);
@@ -434,14 +688,29 @@ void ImageProcessor::applySobelFilter(cv::Mat &src, cv::Mat &dst, int kernelSize
     cv::convertScaleAbs(grad_x, abs_grad_x);
     cv::convertScaleAbs(grad_y, abs_grad_y);
 
-    cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, sobel_result);
-    cv::cvtColor(sobel_result, dst, cv::COLOR_GRAY2RGB);
+    if (expandToColor)
+    {
+        cv::Mat sobel_result;
+        cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, sobel_result);
+        cv::cvtColor(sobel_result, dst, cv::COLOR_GRAY2RGB);
+    }
+    else
+    {
+        cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, dst);
+    }
 }
 
 // 라플라시안 필터
 void ImageProcessor::applyLaplacianFilter(cv::Mat &src, cv::Mat &dst, int kernelSize)
 {
+    // 1채널 입력은 변환 없이 처리하고 1채널로 반환
     cv::Mat gray, laplacian;
+    if (src.channels() == 1)
+    {
+        cv::Laplacian(src, laplacian, CV_16S, kernelSize);
+        cv::convertScaleAbs(laplacian, dst);
+        return;
+    }
     cv::cvtColor(src, gray, cv::COLOR_RGB2GRAY);
     cv::Laplacian(gray, laplacian, CV_16S, kernelSize);
 
@@ -460,41 +729,16 @@ void ImageProcessor::applySharpenFilter(cv::Mat &src, cv::Mat &dst, int strength
     cv::addWeighted(src, 1.0 + (strength * 0.1), blurred, -(strength * 0.1), 0, dst);
 }
 
-// 밝기 필터
+// 밝기 필터 (포화 덧셈을 LUT로, cv::LUT는 채널 수와 무관하게 SIMD/병렬 처리)
 void ImageProcessor::applyBrightnessFilter(cv::Mat &src, cv::Mat &dst, int value)
 {
-    src.copyTo(dst);
-
-    for (int y = 0; y < dst.rows; y++)
-    {
-        for (int x = 0; x < dst.cols; x++)
-        {
-            for (int c = 0; c < 3; c++)
-            {
-                int pixel = dst.at<cv::Vec3b>(y, x)[c] + value;
-                dst.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(pixel);
-            }
-        }
-    }
+    cv::LUT(src, brightnessLut(value), dst);
 }
 
-// 대비 필터
+// 대비 필터 (기존 식의 int 변환/포화까지 그대로 담은 LUT)
 void ImageProcessor::applyContrastFilter(cv::Mat &src, cv::Mat &dst, int value)
 {
-    src.copyTo(dst);
-    double factor = (259.0 * (value + 255)) / (255.0 * (259 - value));
-
-    for (int y = 0; y < dst.rows; y++)
-    {
-        for (int x = 0; x < dst.cols; x++)
-        {
-            for (int c = 0; c < 3; c++)
-            {
-                int pixel = static_cast<int>(factor * (dst.at<cv::Vec3b>(y, x)[c] - 128) + 128);
-                dst.at<cv::Vec3b>(y, x)[c] = cv::saturate_cast<uchar>(pixel);
-            }
-        }
-    }
+    cv::LUT(src, contrastLut(value), dst);
 }
 
 void ImageProcessor::applyMaskFilter(cv::Mat &src, cv::Mat &dst, const QRect &maskRect, int maskValue)
@@ -899,7 +1143,7 @@ bool ImageProcessor::performStripInspection(const cv::Mat &roiImage, const cv::M
         if (contours.empty())
         {
             score = 0.0;
-            roiImage.copyTo(resultImage);
+            copyForDisplay(roiImage, resultImage);
             return false;
         }
 
@@ -919,7 +1163,7 @@ bool ImageProcessor::performStripInspection(const cv::Mat &roiImage, const cv::M
         {
 
             score = 0.0;
-            roiImage.copyTo(resultImage);
+            copyForDisplay(roiImage, resultImage);
             return false;
         }
 
@@ -1602,7 +1846,7 @@ bool ImageProcessor::performStripInspection(const cv::Mat &roiImage, const cv::M
         if (positions.empty())
         {
             score = 0.0;
-            roiImage.copyTo(resultImage);
+            copyForDisplay(roiImage, resultImage);
             return false;
         }
 
@@ -1842,7 +2086,7 @@ bool ImageProcessor::performStripInspection(const cv::Mat &roiImage, const cv::M
         // 디버그: 두께 측정 결과
 
         // 원본 이미지 복사 (컨투어 선 제거, 연결선과 원만 표시) - 보정된 이미지 사용
-        roiImage.copyTo(resultImage);
+        copyForDisplay(roiImage, resultImage);
 
         // OpenCV 4점 시각화 제거됨 - Qt에서 처리
 
@@ -2856,7 +3100,7 @@ bool ImageProcessor::performStripInspection(const cv::Mat &roiImage, const cv::M
         startPoint = cv::Point(0, 0);
         maxGradientPoint = cv::Point(0, 0);
         gradientPoints.clear();
-        roiImage.copyTo(resultImage);
+        copyForDisplay(roiImage, resultImage);
         return false;
     }
 }
@@ -6,6 +6,7 @@
 #include <QMap>
 #include <QList>
 #include <memory>
+#include <vector>
 #include "CommonDefs.h"  // 공통 정의 포함
 
 // YOLO11-seg 세그멘테이션 결과 구조체
@@ -200,4 +201,70 @@ public:
 #endif  // USE_ONNX
 };
 
+// ===== 컴파일된 필터 체인 =====
+// PatternInfo::filters를 생성 시 한 번 해석해 두고 (파라미터 조회/커널 크기 보정)
+// 연속된 점 연산(밝기, 대비, 고정 임계값 이진화)은 256 항목 LUT 하나로 합쳐 한 번에 적용한다.
+// 중간 결과는 스레드별 버퍼 두 개를 번갈아 쓰므로 같은 체인을 여러 검사 스레드가 동시에 적용해도 된다.
+class FilterChain {
+public:
+    // 출력 채널
+    //  Color:  그레이를 만드는 단계(이진화, Canny, Sobel, Laplacian) 결과를 3채널로 복원 (화면 표시/템플릿 저장)
+    //  Native: 그레이 단계 이후 1채널(8UC1) 그대로 유지 (검사 전용, 다음 단계와 검사가 다시 그레이 변환하지 않음)
+    //          Color 결과를 그레이로 변환한 것과 픽셀 단위로 같다.
+    enum class ChannelMode { Color, Native };
+
+    // applyMask: FILTER_MASK를 영상 전체 채움으로 적용 (ImageProcessor::applyFilters와 동일, 그 외 경로는 무시)
+    explicit FilterChain(const QList<FilterInfo>& filters, bool applyMask = false);
+
+    // 필터 구성 서명 (캐시된 체인이 현재 패턴 필터와 같은지 확인)
+    static size_t computeSignature(const QList<FilterInfo>& filters, bool applyMask = false);
+    size_t signature() const { return m_signature; }
+
+    bool isEmpty() const { return m_steps.empty(); }
+    int stepCount() const { return static_cast<int>(m_steps.size()); }
+
+    // src -> dst (같은 Mat 또는 같은 ROI를 넘기면 제자리 적용). 적용할 단계가 없으면 그대로 복사
+    void apply(const cv::Mat& src, cv::Mat& dst, ChannelMode mode = ChannelMode::Color) const;
+
+private:
+    enum class StepKind {
+        Lut,        // 채널별 LUT (밝기/대비)
+        GrayLut,    // 그레이 변환 -> LUT (이진화 + 뒤따르는 점 연산) -> 3채널 복원
+        Filter,     // 그 외 필터 (파라미터는 해석된 값)
+        Mask        // 영상 전체를 maskValue로 채움
+    };
+
+    struct Step {
+        StepKind kind = StepKind::Filter;
+        int type = -1;                          // FILTER_* (Filter 단계)
+        int params[5] = {0, 0, 0, 0, 0};
+        cv::Mat lut;                            // 1x256 CV_8U (Lut/GrayLut 단계)
+    };
+
+    void appendPointOp(StepKind kind, const cv::Mat& lut);
+    static void runStep(const Step& step, const cv::Mat& src, cv::Mat& dst, bool native);
+
+    std::vector<Step> m_steps;
+    size_t m_signature = 0;
+};
+
+// ===== 패턴 필터 미리보기 영역 =====
+// 메인 화면(CameraView)과 필터 대화상자가 같은 픽셀에 필터를 적용하도록 영역/마스크/입력을 한 곳에서 만든다.
+// 회전 패턴은 회전 사각형을 감싸는 정사각 영역 + 회전 사각형 마스크, 아니면 패턴 사각형 영역.
+// 영역은 프레임과의 교집합이다 (가장자리 패턴은 프레임 안쪽 부분만 필터).
+struct FilterPreviewRegion {
+    cv::Rect roi;               // 프레임 좌표
+    cv::Mat mask;               // 회전 패턴만 (roi 크기 CV_8UC1)
+    bool rotated = false;
+
+    static bool isRotated(double angle) { return std::abs(angle) > 0.1; }
+    static FilterPreviewRegion compute(const QRectF& rect, double angle, const cv::Size& frameSize);
+
+    bool isValid() const { return roi.width > 0 && roi.height > 0; }
+    // source(roi 크기 원본) → 첫 필터 입력. 회전 패턴은 마스크 밖을 0으로 채운 복사본, 아니면 source 공유
+    void makeInput(const cv::Mat& source, cv::Mat& input) const;
+    // roi 크기 필터 결과를 frame에 반영 (회전 패턴은 마스크 영역만)
+    void writeBack(const cv::Mat& result, cv::Mat& frame) const;
+};
+
 #endif // IMAGEPROCESSOR_H
\ No newline at end of file
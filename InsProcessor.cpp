@@ -1,6 +1,7 @@
 #include "InsProcessor.h"
 #include "ImageProcessor.h"
 #include "ConfigManager.h"
+#include "InspectionTrace.h"
 #include <QDebug>
 #include <QDateTime>
 #include <QDir>
@@ -10,8 +11,17 @@
 #include <QFont>
 #include <QPen>
 #include <QFontMetrics>
+#include <QSemaphore>
+#include <QScopeGuard>
+#include <QWaitCondition>
+#include <QThread>
 #include <numeric>
+#include <algorithm>
+#include <cmath>
 #include <chrono>
+#include <atomic>
+#include <functional>
+#include <random>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/imgcodecs.hpp>
 
@@ -30,15 +40,725 @@ namespace {
         return false;
 #endif
     }
+
+    // 레시피별 ANOMALY 모델 파일 경로 (A-PD는 _padim 접미사)
+    QString anomalyModelPath(const QString& recipeName, const QString& patternName, bool isPaDiM)
+    {
+        QString weightsDir = QCoreApplication::applicationDirPath() + "/recipes/" + recipeName + "/weights";
+        QString suffix = isPaDiM ? "_padim" : "";
+#ifdef USE_TENSORRT
+        return weightsDir + "/" + patternName + "/" + patternName + suffix + ".trt";
+#else
+        return weightsDir + "/" + patternName + "/" + patternName + suffix + ".onnx";
+#endif
+    }
+
+    // 켜진 필터가 있는지 (없으면 ROI를 프레임 공용 흑백 평면에서 바로 추출 - 필터는 컬러 입력 전제)
+    bool hasEnabledFilter(const PatternInfo& pattern)
+    {
+        return std::any_of(pattern.filters.begin(), pattern.filters.end(),
+                           [](const FilterInfo& filter) { return filter.enabled; });
+    }
+
+    // ===== 회전/피라미드(Coarse-to-Fine) 템플릿 매칭 설정 =====
+    const int PYRAMID_MAX_LEVEL = 3;              // 최대 1/8 축소
+    const int PYRAMID_MIN_TEMPLATE_SIDE = 16;     // 축소 후 템플릿 짧은 변 최소 크기 (픽셀)
+    const int PYRAMID_CANDIDATES = 5;             // 원본 해상도에서 정밀 검색할 후보 수
+    const double COARSE_ANGLE_STEP = 5.0;         // 1단계 각도 간격
+    const double FINE_ANGLE_RANGE = 3.0;          // 1단계 최적 각도 주변 정밀 검색 범위 (+/-)
+    const int ROTATION_BANK_MAX_ANGLES = 720;     // 회전 뱅크 최대 각도 수 (너무 작은 각도 간격 방지)
+    const int TRACK_SEARCH_MARGIN = 24;           // FID 추적 창 여유 (직전 위치 기준 +/- 픽셀)
+
+    // 템플릿 크기로 정해지는 피라미드 레벨 (0이면 원본 해상도만)
+    int templatePyramidLevel(const cv::Size& templSize)
+    {
+        int level = 0;
+        int templSide = std::min(templSize.width, templSize.height);
+        while (level < PYRAMID_MAX_LEVEL && (templSide >> (level + 1)) >= PYRAMID_MIN_TEMPLATE_SIDE)
+            level++;
+        return level;
+    }
+
+    // 검색 영역이 템플릿과 비슷하면 축소 이득이 없음
+    bool pyramidWorthwhile(const cv::Size& templSize, const cv::Size& searchSize)
+    {
+        return searchSize.width >= templSize.width * 2 || searchSize.height >= templSize.height * 2;
+    }
+
+    cv::Mat pyramidDown(const cv::Mat& src, int level)
+    {
+        cv::Mat dst = src;
+        for (int i = 0; i < level; i++) {
+            cv::Mat next;
+            cv::pyrDown(dst, next);
+            dst = next;
+        }
+        return dst;
+    }
+
+    // 회전 시 잘림 방지를 위해 대각선 크기로 패딩한 뒤 상대 각도만큼 회전 (마스크도 동일하게)
+    void rotatePaddedTemplate(const cv::Mat& templ, const cv::Mat& mask, double relativeAngle,
+                              cv::Mat& rotatedTempl, cv::Mat& rotatedMask)
+    {
+        int diagonal = static_cast<int>(std::sqrt(templ.cols * templ.cols + templ.rows * templ.rows));
+        cv::Rect roi((diagonal - templ.cols) / 2, (diagonal - templ.rows) / 2, templ.cols, templ.rows);
+
+        cv::Mat paddedTempl = cv::Mat::zeros(diagonal, diagonal, templ.type());
+        templ.copyTo(paddedTempl(roi));
+
+        cv::Mat rotMatrix = cv::getRotationMatrix2D(
+            cv::Point2f(diagonal / 2.0f, diagonal / 2.0f), -relativeAngle, 1.0);
+        cv::warpAffine(paddedTempl, rotatedTempl, rotMatrix, paddedTempl.size(),
+                       cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
+
+        rotatedMask.release();
+        if (!mask.empty())
+        {
+            cv::Mat paddedMask = cv::Mat::zeros(diagonal, diagonal, CV_8UC1);
+            mask.copyTo(paddedMask(roi));
+            cv::warpAffine(paddedMask, rotatedMask, rotMatrix, paddedMask.size(),
+                           cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
+            // 보간으로 생긴 중간값 제거
+            cv::threshold(rotatedMask, rotatedMask, 127, 255, cv::THRESH_BINARY);
+        }
+    }
+
+    // 상대 각도 하나의 회전 템플릿 (티칭 각도는 padded가 아니면 원본 그대로)
+    RotatedTemplate makeRotatedTemplate(const cv::Mat& templ, const cv::Mat& mask, double relativeAngle,
+                                        bool padded = false)
+    {
+        RotatedTemplate entry;
+        entry.relativeAngle = relativeAngle;
+        if (!padded && std::abs(relativeAngle) < 0.01)
+        {
+            entry.templ = templ;
+            entry.mask = mask;
+        }
+        else
+        {
+            rotatePaddedTemplate(templ, mask, relativeAngle, entry.templ, entry.mask);
+        }
+
+        int totalPixels = entry.templ.rows * entry.templ.cols;
+        entry.maskNonZero = entry.mask.empty() ? totalPixels : cv::countNonZero(entry.mask);
+        entry.maskFull = (entry.maskNonZero == totalPixels);
+        return entry;
+    }
+
+    // ===== 형상(에지 그래디언트) 매칭 =====
+    const float SHAPE_MIN_GRADIENT = 10.0f;       // 이보다 약한 영상 그래디언트는 방향 없음(0점)으로 처리
+    const int SHAPE_MIN_POINTS = 16;              // 모델 에지 점이 이보다 적으면 Canny 임계값을 낮춰 다시 추출
+    const int SHAPE_MAX_POINTS = 256;             // 원본 해상도 모델 점 수 상한 (축소 레벨은 절반)
+    const double SHAPE_COARSE_SCORE_RATIO = 0.7;  // 축소 레벨 후보 최소 점수 = 매칭 임계값 x 비율
+
+    // 모델 추출용 에지 점 (템플릿 중심 기준 실수 좌표 + 단위 방향)
+    struct ShapeEdgePoint {
+        cv::Point2f position;
+        cv::Point2f direction;
+    };
+
+    // 영상 그래디언트 단위 방향 (약한 그래디언트는 0)
+    struct ShapeGradient {
+        cv::Mat dx;
+        cv::Mat dy;
+    };
+
+    ShapeGradient computeShapeGradient(const cv::Mat& gray)
+    {
+        ShapeGradient gradient;
+        cv::Sobel(gray, gradient.dx, CV_32F, 1, 0, 3);
+        cv::Sobel(gray, gradient.dy, CV_32F, 0, 1, 3);
+
+        cv::Mat magnitude;
+        cv::magnitude(gradient.dx, gradient.dy, magnitude);
+        cv::Mat weak = magnitude < SHAPE_MIN_GRADIENT;
+        magnitude.setTo(1.0f, weak);
+        cv::divide(gradient.dx, magnitude, gradient.dx);
+        cv::divide(gradient.dy, magnitude, gradient.dy);
+        gradient.dx.setTo(0.0f, weak);
+        gradient.dy.setTo(0.0f, weak);
+        return gradient;
+    }
+
+    // 템플릿 에지 점 추출 (Canny 에지 위치의 그래디언트 방향, 마스크 밖 제외, 최대 maxPoints개)
+    std::vector<ShapeEdgePoint> extractShapeEdgePoints(const cv::Mat& templGray, const cv::Mat& mask, int maxPoints)
+    {
+        std::vector<ShapeEdgePoint> points;
+        if (templGray.empty() || templGray.type() != CV_8UC1)
+            return points;
+
+        cv::Mat gx, gy;
+        cv::Sobel(templGray, gx, CV_32F, 1, 0, 3);
+        cv::Sobel(templGray, gy, CV_32F, 0, 1, 3);
+
+        // 템플릿 대비가 낮으면 임계값을 낮춰 다시 시도
+        const int thresholds[][2] = {{60, 120}, {30, 60}, {15, 30}};
+        cv::Mat edges;
+        for (const auto& threshold : thresholds)
+        {
+            cv::Canny(templGray, edges, threshold[0], threshold[1]);
+            if (!mask.empty())
+                edges.setTo(0, mask == 0);
+            if (cv::countNonZero(edges) >= SHAPE_MIN_POINTS)
+                break;
+        }
+
+        const float centerX = templGray.cols / 2.0f;
+        const float centerY = templGray.rows / 2.0f;
+        for (int y = 0; y < edges.rows; y++)
+        {
+            const uchar* edgeRow = edges.ptr<uchar>(y);
+            for (int x = 0; x < edges.cols; x++)
+            {
+                if (!edgeRow[x])
+                    continue;
+                float dx = gx.at<float>(y, x);
+                float dy = gy.at<float>(y, x);
+                float length = std::sqrt(dx * dx + dy * dy);
+                if (length < SHAPE_MIN_GRADIENT)
+                    continue;
+                points.push_back({cv::Point2f(x - centerX, y - centerY), cv::Point2f(dx / length, dy / length)});
+            }
+        }
+
+        // 균일 간격으로 줄인 뒤 고정 시드로 섞어 앞쪽 점만으로도 전체를 대표하게 함 (조기 종료용)
+        if (static_cast<int>(points.size()) > maxPoints)
+        {
+            std::vector<ShapeEdgePoint> sampled;
+            double stride = static_cast<double>(points.size()) / maxPoints;
+            for (int i = 0; i < maxPoints; i++)
+                sampled.push_back(points[static_cast<size_t>(i * stride)]);
+            points.swap(sampled);
+        }
+        std::shuffle(points.begin(), points.end(), std::mt19937(12345));
+        return points;
+    }
+
+    // 에지 점을 상대 각도만큼 회전한 형상 모델 (rotatePaddedTemplate과 같은 회전 방향)
+    ShapeModel rotateShapeModel(const std::vector<ShapeEdgePoint>& base, double relativeAngle)
+    {
+        ShapeModel model;
+        double radians = relativeAngle * CV_PI / 180.0;
+        float cosA = static_cast<float>(std::cos(radians));
+        float sinA = static_cast<float>(std::sin(radians));
+
+        model.points.reserve(base.size());
+        for (const ShapeEdgePoint& edge : base)
+        {
+            ShapeModelPoint point;
+            point.x = static_cast<int>(std::lround(cosA * edge.position.x - sinA * edge.position.y));
+            point.y = static_cast<int>(std::lround(sinA * edge.position.x + cosA * edge.position.y));
+            point.dx = cosA * edge.direction.x - sinA * edge.direction.y;
+            point.dy = sinA * edge.direction.x + cosA * edge.direction.y;
+
+            if (model.points.empty())
+            {
+                model.minX = model.maxX = point.x;
+                model.minY = model.maxY = point.y;
+            }
+            model.minX = std::min(model.minX, point.x);
+            model.maxX = std::max(model.maxX, point.x);
+            model.minY = std::min(model.minY, point.y);
+            model.maxY = std::max(model.maxY, point.y);
+            model.points.push_back(point);
+        }
+        return model;
+    }
+
+    // 모델 전체가 영상 안에 들어가는 중심 좌표 범위
+    cv::Rect shapeCenterRange(const ShapeModel& model, const cv::Size& imageSize)
+    {
+        return cv::Rect(-model.minX, -model.minY,
+                        imageSize.width - model.maxX + model.minX, imageSize.height - model.maxY + model.minY);
+    }
+
+    // 중심 (cx, cy)에서 모델 점 방향과 영상 그래디언트 방향의 평균 내적 (-1 ~ 1)
+    // 남은 점이 모두 1점이어도 minScore에 못 미치면 중단한다 (그때 반환값은 minScore 미만).
+    double shapeScoreAt(const ShapeGradient& gradient, const ShapeModel& model, int cx, int cy, double minScore)
+    {
+        const int count = static_cast<int>(model.points.size());
+        if (count == 0)
+            return 0.0;
+
+        const double stop = (minScore - 1.0) * count;
+        double sum = 0.0;
+        for (int j = 0; j < count; j++)
+        {
+            const ShapeModelPoint& point = model.points[j];
+            int x = cx + point.x;
+            int y = cy + point.y;
+            sum += point.dx * gradient.dx.at<float>(y, x) + point.dy * gradient.dy.at<float>(y, x);
+            if (sum - (j + 1) < stop)
+                break;
+        }
+        return sum / count;
+    }
+
+    // 티칭 각도 기준 [minAngle, maxAngle] 범위를 angleStep 간격으로 회전한 템플릿 뱅크 생성
+    std::shared_ptr<RotatedTemplateBank> buildRotatedTemplateBank(const cv::Mat& templGray, const cv::Mat& mask,
+                                                                  double minAngle, double maxAngle, double angleStep)
+    {
+        auto bank = std::make_shared<RotatedTemplateBank>();
+        bank->minAngle = minAngle;
+        bank->maxAngle = maxAngle;
+        bank->angleStep = angleStep;
+        bank->sourceSize = templGray.size();
+        bank->pyramidLevel = templatePyramidLevel(templGray.size());
+
+        double step = angleStep > 0.0 ? angleStep : 1.0;
+        if ((maxAngle - minAngle) / step > ROTATION_BANK_MAX_ANGLES)
+            step = (maxAngle - minAngle) / ROTATION_BANK_MAX_ANGLES;
+
+        // 티칭 각도(상대 0도)는 항상 포함
+        int first = std::min(0, static_cast<int>(std::ceil(minAngle / step - 1e-6)));
+        int last = std::max(0, static_cast<int>(std::floor(maxAngle / step + 1e-6)));
+
+        cv::Mat coarseTempl, coarseMask;
+        if (bank->pyramidLevel > 0)
+        {
+            coarseTempl = pyramidDown(templGray, bank->pyramidLevel);
+            if (!mask.empty())
+            {
+                cv::resize(mask, coarseMask, coarseTempl.size(), 0, 0, cv::INTER_NEAREST);
+                cv::threshold(coarseMask, coarseMask, 127, 255, cv::THRESH_BINARY);
+            }
+        }
+
+        // 형상 매칭 모델은 회전 전 에지 점을 각도별로 회전 (패딩 경계가 에지로 잡히지 않음)
+        std::vector<ShapeEdgePoint> shapeBase = extractShapeEdgePoints(templGray, mask, SHAPE_MAX_POINTS);
+        std::vector<ShapeEdgePoint> shapeCoarseBase;
+        if (bank->pyramidLevel > 0)
+            shapeCoarseBase = extractShapeEdgePoints(coarseTempl, coarseMask, SHAPE_MAX_POINTS / 2);
+
+        for (int k = first; k <= last; k++)
+        {
+            double relativeAngle = k * step;
+            if (k == 0)
+                bank->zeroIndex = static_cast<int>(bank->full.size());
+            bank->full.push_back(makeRotatedTemplate(templGray, mask, relativeAngle));
+            bank->shapeFull.push_back(rotateShapeModel(shapeBase, relativeAngle));
+            if (bank->pyramidLevel > 0)
+            {
+                bank->coarse.push_back(makeRotatedTemplate(coarseTempl, coarseMask, relativeAngle));
+                bank->shapeCoarse.push_back(rotateShapeModel(shapeCoarseBase, relativeAngle));
+            }
+        }
+
+        // 각도 보간 시 이웃 회전 템플릿과 같은 패딩 조건으로 점수를 비교하기 위한 티칭 각도 템플릿
+        if (bank->full.size() > 1)
+            bank->zeroPadded = makeRotatedTemplate(templGray, mask, 0.0, true);
+        return bank;
+    }
+
+    // 1단계 각도 인덱스: 티칭 각도 우선, 이후 약 5도 간격 (티칭 각도와 가까운 각도 제외)
+    std::vector<int> coarseAngleIndices(const RotatedTemplateBank& bank)
+    {
+        std::vector<int> indices;
+        indices.push_back(bank.zeroIndex);
+        if (bank.full.size() <= 1)
+            return indices;
+
+        double step = std::abs(bank.full[1].relativeAngle - bank.full[0].relativeAngle);
+        int stride = std::max(1, static_cast<int>(std::round(COARSE_ANGLE_STEP / step)));
+        for (int i = 0; i < static_cast<int>(bank.full.size()); i += stride)
+        {
+            if (std::abs(bank.full[i].relativeAngle) >= COARSE_ANGLE_STEP / 2.0)
+                indices.push_back(i);
+        }
+        return indices;
+    }
+
+    // 2단계 각도 인덱스: 기준 각도 주변 +/-3도 (기준 각도 먼저)
+    std::vector<int> fineAngleIndices(const RotatedTemplateBank& bank, int centerIndex)
+    {
+        std::vector<int> indices;
+        indices.push_back(centerIndex);
+        double centerAngle = bank.full[centerIndex].relativeAngle;
+        for (int i = 0; i < static_cast<int>(bank.full.size()); i++)
+        {
+            if (i != centerIndex && std::abs(bank.full[i].relativeAngle - centerAngle) <= FINE_ANGLE_RANGE + 1e-6)
+                indices.push_back(i);
+        }
+        return indices;
+    }
+
+    // ===== FFT 상관 백엔드 =====
+    const int FFT_MIN_TEMPLATE_AREA = 64 * 64;    // Auto: 이보다 작은 템플릿은 공간 영역이 빠름
+    const int FFT_MIN_SEARCH_RATIO = 4;           // Auto: 검색 영역이 템플릿의 4배 이상일 때만 FFT
+
+    bool useFftBackend(InsProcessor::MatchBackend backend, const cv::Size& searchSize, const RotatedTemplate& entry,
+                       int matchMethod)
+    {
+        if (!entry.maskFull || (matchMethod != cv::TM_CCOEFF_NORMED && matchMethod != cv::TM_CCORR_NORMED))
+            return false;
+        if (backend == InsProcessor::MatchBackend::FFT)
+            return true;
+        if (backend == InsProcessor::MatchBackend::Spatial)
+            return false;
+        double templArea = static_cast<double>(entry.templ.cols) * entry.templ.rows;
+        return templArea >= FFT_MIN_TEMPLATE_AREA &&
+               static_cast<double>(searchSize.area()) >= templArea * FFT_MIN_SEARCH_RATIO;
+    }
+
+    // DFT 크기에 맞는 템플릿 스펙트럼 (캐시에 없거나 크기/방식이 다르면 다시 계산)
+    void acquireTemplateSpectrum(const RotatedTemplate& entry, const cv::Size& dftSize, bool zeroMean,
+                                 cv::Mat& spectrum, double& normSq)
+    {
+        TemplateSpectrum& cache = *entry.spectrum;
+        QMutexLocker locker(&cache.mutex);
+        if (cache.spectrum.empty() || cache.dftSize != dftSize || cache.zeroMean != zeroMean)
+        {
+            cv::Mat templFloat;
+            entry.templ.convertTo(templFloat, CV_32F);
+            if (zeroMean)
+                templFloat -= cv::mean(templFloat)[0];
+
+            cv::Mat padded = cv::Mat::zeros(dftSize, CV_32F);
+            templFloat.copyTo(padded(cv::Rect(0, 0, templFloat.cols, templFloat.rows)));
+
+            cv::Mat computed;
+            cv::dft(padded, computed, 0, templFloat.rows);
+            cache.spectrum = computed;  // 새 Mat으로 교체 (이미 넘겨준 스펙트럼은 그대로 유효)
+            cache.dftSize = dftSize;
+            cache.zeroMean = zeroMean;
+            cache.normSq = templFloat.dot(templFloat);
+        }
+        spectrum = cache.spectrum;
+        normSq = cache.normSq;
+    }
+
+    // 검색 영상 하나의 FFT 상관 준비물 (스펙트럼 + 적분 영상)
+    // 회전 뱅크의 모든 각도가 같은 검색 영상을 쓰므로 매칭 호출당 한 번만 계산해 공유한다.
+    struct SearchSpectrum {
+        const uchar* source = nullptr;          // 계산에 쓴 검색 영상 (다른 영상이면 다시 계산)
+        cv::Size imageSize;
+        cv::Size dftSize;
+        cv::Mat spectrum;                       // DFT 크기로 0 패딩한 검색 영상의 복소 스펙트럼
+        cv::Mat sum, sqsum;                     // 템플릿 창 단위 합/제곱합용 적분 영상
+    };
+
+    const SearchSpectrum& prepareSearchSpectrum(const cv::Mat& searchImage, SearchSpectrum& prepared)
+    {
+        if (!prepared.spectrum.empty() && prepared.source == searchImage.data &&
+            prepared.imageSize == searchImage.size())
+            return prepared;
+
+        prepared.source = searchImage.data;
+        prepared.imageSize = searchImage.size();
+        prepared.dftSize = cv::Size(cv::getOptimalDFTSize(searchImage.cols), cv::getOptimalDFTSize(searchImage.rows));
+
+        cv::Mat padded = cv::Mat::zeros(prepared.dftSize, CV_32F);
+        cv::Mat paddedImage = padded(cv::Rect(0, 0, searchImage.cols, searchImage.rows));
+        searchImage.convertTo(paddedImage, CV_32F);
+        cv::dft(padded, prepared.spectrum, 0, searchImage.rows);
+
+        cv::integral(searchImage, prepared.sum, prepared.sqsum, CV_64F, CV_64F);
+        return prepared;
+    }
+
+    // 주파수 영역 정규화 상호상관 (TM_CCORR_NORMED / TM_CCOEFF_NORMED, 마스크 없음)
+    // 상관은 검색 영상 스펙트럼 x 캐시된 템플릿 스펙트럼 켤레의 역변환, 정규화 분모는 적분 영상으로 계산
+    // search를 넘기면 검색 영상 스펙트럼/적분 영상을 여러 템플릿에서 재사용
+    void computeMatchMapFFT(const cv::Mat& searchImage, const RotatedTemplate& entry, int matchMethod, cv::Mat& result,
+                            SearchSpectrum* search = nullptr)
+    {
+        const cv::Size templSize = entry.templ.size();
+        const cv::Size resultSize(searchImage.cols - templSize.width + 1, searchImage.rows - templSize.height + 1);
+        const bool zeroMean = (matchMethod == cv::TM_CCOEFF_NORMED);
+
+        SearchSpectrum local;
+        const SearchSpectrum& prepared = prepareSearchSpectrum(searchImage, search ? *search : local);
+
+        cv::Mat templSpectrum;
+        double templNormSq = 0.0;
+        acquireTemplateSpectrum(entry, prepared.dftSize, zeroMean, templSpectrum, templNormSq);
+
+        cv::Mat product, correlation;
+        cv::mulSpectrums(prepared.spectrum, templSpectrum, product, 0, true);
+        cv::idft(product, correlation, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT, resultSize.height);
+
+        // 템플릿 창 단위 합/제곱합
+        const cv::Mat& sum = prepared.sum;
+        const cv::Mat& sqsum = prepared.sqsum;
+        const double count = static_cast<double>(templSize.area());
+
+        result.create(resultSize, CV_32F);
+        for (int y = 0; y < resultSize.height; y++)
+        {
+            const float* corrRow = correlation.ptr<float>(y);
+            const double* sumTop = sum.ptr<double>(y);
+            const double* sumBottom = sum.ptr<double>(y + templSize.height);
+            const double* sqTop = sqsum.ptr<double>(y);
+            const double* sqBottom = sqsum.ptr<double>(y + templSize.height);
+            float* dst = result.ptr<float>(y);
+            for (int x = 0; x < resultSize.width; x++)
+            {
+                int x2 = x + templSize.width;
+                double windowSq = sqBottom[x2] - sqBottom[x] - sqTop[x2] + sqTop[x];
+                if (zeroMean)
+                {
+                    double windowSum = sumBottom[x2] - sumBottom[x] - sumTop[x2] + sumTop[x];
+                    windowSq -= windowSum * windowSum / count;
+                }
+                double denominator = std::sqrt(std::max(0.0, windowSq) * templNormSq);
+                double value = denominator > 1e-6 ? corrRow[x] / denominator : 0.0;
+                dst[x] = static_cast<float>(std::max(-1.0, std::min(1.0, value)));
+            }
+        }
+    }
+
+    // 회전 템플릿 하나로 매칭 맵 계산 (마스크가 전체 유효면 마스크 없이 - 더 빠름)
+    bool computeMatchMap(const cv::Mat& searchImage, const RotatedTemplate& entry, int matchMethod, cv::Mat& result,
+                         InsProcessor::MatchBackend backend = InsProcessor::MatchBackend::Spatial,
+                         SearchSpectrum* search = nullptr)
+    {
+        if (entry.templ.empty() || entry.templ.cols > searchImage.cols || entry.templ.rows > searchImage.rows)
+            return false;
+        if (entry.maskNonZero == 0)
+            return false;
+
+        if (useFftBackend(backend, searchImage.size(), entry, matchMethod))
+        {
+            computeMatchMapFFT(searchImage, entry, matchMethod, result, search);
+            return !result.empty();
+        }
+
+        if (!entry.maskFull)
+            cv::matchTemplate(searchImage, entry.templ, result, matchMethod, entry.mask);
+        else
+            cv::matchTemplate(searchImage, entry.templ, result, matchMethod);
+        cv::patchNaNs(result, -1.0);  // 마스크 매칭 시 분산 0 구간의 NaN 제거
+        return !result.empty();
+    }
+
+    // 매칭 맵에서 점수 상위 피크 추출 (찾은 피크 주변은 억제)
+    struct MatchPeak {
+        double score = 0.0;
+        cv::Point center;      // 템플릿 중심 좌표 (매칭한 영상 기준)
+        int angleIndex = 0;    // 회전 뱅크 인덱스
+    };
+
+    void collectMatchPeaks(cv::Mat& result, const cv::Size& templSize, int angleIndex, int count,
+                           std::vector<MatchPeak>& peaks)
+    {
+        cv::Size suppress(std::max(1, templSize.width / 2), std::max(1, templSize.height / 2));
+        for (int i = 0; i < count; i++)
+        {
+            double maxVal;
+            cv::Point maxLoc;
+            cv::minMaxLoc(result, nullptr, &maxVal, nullptr, &maxLoc);
+            if (!std::isfinite(maxVal) || maxVal <= 0.0)
+                break;
+
+            MatchPeak peak;
+            peak.score = maxVal;
+            peak.center = cv::Point(static_cast<int>(maxLoc.x + templSize.width / 2.0 + 0.5),
+                                    static_cast<int>(maxLoc.y + templSize.height / 2.0 + 0.5));
+            peak.angleIndex = angleIndex;
+            peaks.push_back(peak);
+
+            cv::Rect around(maxLoc.x - suppress.width, maxLoc.y - suppress.height,
+                            suppress.width * 2 + 1, suppress.height * 2 + 1);
+            result(around & cv::Rect(0, 0, result.cols, result.rows)).setTo(-1.0f);
+        }
+    }
+
+    // ===== 서브픽셀/서브각도 보정 =====
+    // 세 점 (-1, 0, +1)을 지나는 포물선의 꼭짓점 위치 (봉우리가 아니면 0)
+    double parabolaPeakOffset(double minus, double center, double plus)
+    {
+        double denominator = minus - 2.0 * center + plus;
+        if (!std::isfinite(denominator) || denominator >= 0.0)
+            return 0.0;
+        double offset = 0.5 * (minus - plus) / denominator;
+        return std::max(-0.5, std::min(0.5, offset));
+    }
+
+    // 매칭 맵 최대점 주변 3x3에 2차 곡면 f = a + bx + cy + dx² + exy + gy²를 최소제곱 적합해 꼭짓점 계산
+    // 곡면이 봉우리가 아니거나 가장자리이면 축별 포물선으로 대체
+    cv::Point2f quadraticPeakOffset(const cv::Mat& result, const cv::Point& peak)
+    {
+        auto at = [&](int dx, int dy) { return static_cast<double>(result.at<float>(peak.y + dy, peak.x + dx)); };
+        bool hasX = peak.x >= 1 && peak.x < result.cols - 1;
+        bool hasY = peak.y >= 1 && peak.y < result.rows - 1;
+
+        if (hasX && hasY)
+        {
+            double b = 0.0, c = 0.0, d = 0.0, e = 0.0, g = 0.0;
+            for (int dy = -1; dy <= 1; dy++)
+            {
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    double f = at(dx, dy);
+                    b += dx * f;
+                    c += dy * f;
+                    d += (dx * dx - 2.0 / 3.0) * f;
+                    e += dx * dy * f;
+                    g += (dy * dy - 2.0 / 3.0) * f;
+                }
+            }
+            b /= 6.0;
+            c /= 6.0;
+            d /= 2.0;
+            e /= 4.0;
+            g /= 2.0;
+
+            // 기울기 0 조건: [2d e; e 2g] [x y]^T = -[b c]^T
+            double det = 4.0 * d * g - e * e;
+            if (d < 0.0 && g < 0.0 && det > 1e-12)
+            {
+                double x = (e * c - 2.0 * g * b) / det;
+                double y = (e * b - 2.0 * d * c) / det;
+                if (std::abs(x) <= 1.0 && std::abs(y) <= 1.0)
+                    return cv::Point2f(static_cast<float>(x), static_cast<float>(y));
+            }
+        }
+
+        cv::Point2f offset(0.0f, 0.0f);
+        if (hasX)
+            offset.x = static_cast<float>(parabolaPeakOffset(at(-1, 0), at(0, 0), at(1, 0)));
+        if (hasY)
+            offset.y = static_cast<float>(parabolaPeakOffset(at(0, -1), at(0, 0), at(0, 1)));
+        return offset;
+    }
+
+    // 정수 매칭 결과(bestIndex 각도, bestCenter 중심)를 작은 창에서 다시 매칭해
+    // 위치는 2차 곡면, 각도는 이웃 뱅크 각도 점수의 포물선으로 보정한다.
+    // 전체 검색 대신 작은 창 몇 번만 매칭하므로 뱅크 각도 간격을 굳이 촘촘하게 둘 필요가 없다.
+    void refineMatchPeak(const cv::Mat& imageGray, const RotatedTemplateBank& bank, int matchMethod,
+                         int bestIndex, const cv::Point& bestCenter, bool refineAngle,
+                         cv::Point2f& subPixelCenter, double& relativeAngle)
+    {
+        subPixelCenter = cv::Point2f(static_cast<float>(bestCenter.x), static_cast<float>(bestCenter.y));
+        relativeAngle = bank.full[bestIndex].relativeAngle;
+
+        const int margin = 2;
+        const cv::Rect imageRect(0, 0, imageGray.cols, imageGray.rows);
+
+        // bestCenter 주변 창에서 템플릿 하나의 매칭 맵과 최대점
+        auto peakAround = [&](const RotatedTemplate& entry, cv::Rect& window, cv::Mat& result,
+                              cv::Point& peak, double& peakScore) -> bool
+        {
+            window = cv::Rect(bestCenter.x - entry.templ.cols / 2 - margin, bestCenter.y - entry.templ.rows / 2 - margin,
+                              entry.templ.cols + margin * 2, entry.templ.rows + margin * 2) & imageRect;
+            if (!computeMatchMap(imageGray(window), entry, matchMethod, result))
+                return false;
+            cv::minMaxLoc(result, nullptr, &peakScore, nullptr, &peak);
+            return std::isfinite(peakScore);
+        };
+
+        try
+        {
+            // 위치: 최적 각도 템플릿 그대로
+            const RotatedTemplate& best = bank.full[bestIndex];
+            cv::Rect window;
+            cv::Mat result;
+            cv::Point peak;
+            double peakScore = 0.0;
+            if (!peakAround(best, window, result, peak, peakScore))
+                return;
+
+            cv::Point2f offset = quadraticPeakOffset(result, peak);
+            subPixelCenter.x = static_cast<float>(window.x + peak.x + offset.x + best.templ.cols / 2.0);
+            subPixelCenter.y = static_cast<float>(window.y + peak.y + offset.y + best.templ.rows / 2.0);
+
+            // 각도: 양쪽 이웃 각도가 모두 있어야 보간 (티칭 각도는 패딩본으로 점수 비교)
+            int count = static_cast<int>(bank.full.size());
+            if (!refineAngle || bestIndex <= 0 || bestIndex >= count - 1)
+                return;
+
+            auto comparable = [&](int index) -> const RotatedTemplate&
+            {
+                return (index == bank.zeroIndex && !bank.zeroPadded.templ.empty()) ? bank.zeroPadded : bank.full[index];
+            };
+
+            double scores[3];
+            for (int k = 0; k < 3; k++)
+            {
+                if (!peakAround(comparable(bestIndex - 1 + k), window, result, peak, scores[k]))
+                    return;
+            }
+
+            double step = bank.full[bestIndex + 1].relativeAngle - bank.full[bestIndex].relativeAngle;
+            relativeAngle += parabolaPeakOffset(scores[0], scores[1], scores[2]) * step;
+        }
+        catch (const cv::Exception&)
+        {
+            // 보정 실패 시 정수 결과 유지
+        }
+    }
+
+    // FID 매칭 작업판 (fidOrder 순번별 결과 슬롯)
+    // 아직 아무도 시작하지 않은 FID는 결과가 필요한 스레드가 직접 매칭하고,
+    // 다른 스레드가 매칭 중이면 끝날 때까지 기다린다. 그래서 풀이 바빠도 교착되지 않는다.
+    class FidTaskBoard
+    {
+    public:
+        struct Outcome {
+            bool matched = false;
+            double score = 0.0;
+            cv::Point location;
+            cv::Point2f subPixelLocation;
+            double angle = 0.0;
+            qint64 elapsedMs = 0;
+            qint64 elapsedUs = 0;
+            QString error;                      // 매칭 중 예외가 나면 메시지 (matched = false)
+        };
+
+        explicit FidTaskBoard(int count) : states(count, Pending), outcomes(count) {}
+
+        const Outcome& ensure(int slot, const std::function<void(Outcome&)>& match)
+        {
+            {
+                QMutexLocker locker(&mutex);
+                while (states[slot] == Running) {
+                    finished.wait(&mutex);
+                }
+                if (states[slot] == Done) {
+                    return outcomes[slot];
+                }
+                states[slot] = Running;
+            }
+
+            // 예외가 나도 슬롯은 반드시 Done으로 바꾸고 깨운다 (대기 중인 스레드가 영원히 막히지 않도록)
+            Outcome outcome;
+            try {
+                match(outcome);
+            } catch (const std::exception& e) {
+                outcome = Outcome();
+                outcome.error = QString::fromUtf8(e.what());
+            } catch (...) {
+                outcome = Outcome();
+                outcome.error = QStringLiteral("unknown exception");
+            }
+
+            QMutexLocker locker(&mutex);
+            outcomes[slot] = outcome;
+            states[slot] = Done;
+            finished.wakeAll();
+            return outcomes[slot];
+        }
+
+    private:
+        enum State { Pending, Running, Done };
+
+        QMutex mutex;
+        QWaitCondition finished;
+        QVector<int> states;
+        QVector<Outcome> outcomes;
+    };
 }
 
 InsProcessor::InsProcessor(QObject *parent) : QObject(parent)
 {
+    // INS 병렬 검사용 전용 풀 (프레임 검사 스레드는 전역 풀을 사용하므로 분리)
+    insThreadPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
     logDebug("InsProcessor initialized");
 }
 
 InsProcessor::~InsProcessor()
 {
+    insThreadPool.waitForDone();
     logDebug("InsProcessor destroyed");
 }
 
@@ -48,25 +768,16 @@ void InsProcessor::warmupAnomalyModels(const QList<PatternInfo>& patterns, const
     QMap<QString, QSize> modelSizes;  // 모델 경로 -> 패턴 크기
     for (const PatternInfo& pattern : patterns) {
         if (pattern.type == PatternType::INS && pattern.enabled) {
-            QString weightsDir = QCoreApplication::applicationDirPath() + "/recipes/" + recipeName + "/weights";
             QString modelPath;
             
             if (pattern.inspectionMethod == static_cast<int>(InspectionMethod::A_PC)) {
-#ifdef USE_TENSORRT
-                modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + ".trt";
-#else
-                modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + ".onnx";
-#endif
+                modelPath = anomalyModelPath(recipeName, pattern.name, false);
                 QSize patternSize(static_cast<int>(pattern.rect.width()), 
                                 static_cast<int>(pattern.rect.height()));
                 modelSizes[modelPath] = patternSize;
             }
             else if (pattern.inspectionMethod == static_cast<int>(InspectionMethod::A_PD)) {
-#ifdef USE_TENSORRT
-                modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + "_padim.trt";
-#else
-                modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + "_padim.onnx";
-#endif
+                modelPath = anomalyModelPath(recipeName, pattern.name, true);
                 QSize patternSize(static_cast<int>(pattern.rect.width()), 
                                 static_cast<int>(pattern.rect.height()));
                 modelSizes[modelPath] = patternSize;
@@ -153,127 +864,461 @@ void InsProcessor::warmupAnomalyModels(const QList<PatternInfo>& patterns, const
     logDebug(QString("Completed: %1/%2 models ready").arg(loadedCount).arg(modelSizes.size()));
 }
 
-InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QList<PatternInfo> &patterns, const QString& cameraName)
+size_t InsProcessor::computePlanSignature(const QList<PatternInfo>& patterns)
 {
-    InspectionResult result;
-
-    if (image.empty() || patterns.isEmpty())
-    {
-        logDebug("Inspection failed: image is empty or no patterns");
-        return result;
-    }
-
-    // 활성화된 INS 패턴 개수 카운트
-    int insCount = 0;
-    for (const PatternInfo &p : patterns) {
-        if (p.type == PatternType::INS && p.enabled) {
-            insCount++;
+    // 검사 계획에 영향을 주는 구조 정보만 해싱 (FID/INS 위치·각도는 제외 - 검사마다 갱신됨)
+    size_t seed = qHash(patterns.size());
+    for (const PatternInfo& p : patterns) {
+        seed = qHashMulti(seed, p.id, static_cast<int>(p.type), p.enabled, p.frameIndex,
+                          p.parentId, p.runInspection, p.inspectionMethod, p.name);
+        for (const QUuid& childId : p.childIds) {
+            seed = qHashMulti(seed, childId);
+        }
+        if (p.type == PatternType::ROI) {
+            seed = qHashMulti(seed, static_cast<int>(p.rect.x()), static_cast<int>(p.rect.y()),
+                              static_cast<int>(p.rect.width()), static_cast<int>(p.rect.height()));
         }
     }
-    
-    // 검사 시작 시간 측정
-    auto startTime = std::chrono::high_resolution_clock::now();
-    
-    // 패턴 프레임 인덱스 추출 (로그용)
-    int frameIndex = -1;
-    if (!patterns.isEmpty()) {
-        frameIndex = patterns.first().frameIndex;
-    }
-    
-    // 프레임별 레이블 (CommonDefs.h의 FRAME_LABELS 사용)
-    QString stageLabel = (frameIndex >= 0 && frameIndex < FRAME_LABELS.size()) ? FRAME_LABELS[frameIndex] : QString("Frame %1").arg(frameIndex);
-    
-    // 검사 시작 로그 (옵션 2 형식)
-    QString cameraInfo = cameraName.isEmpty() ? "" : QString(" (Cam %1)").arg(cameraName);
-    logDebug(QString("[Inspect Start] %1%2").arg(stageLabel).arg(cameraInfo));
+    // 0은 "계획 없음"으로 사용
+    return seed == 0 ? 1 : seed;
+}
 
-    result.isPassed = true;
-    
-    // PatchCore는 각 ANOMALY 패턴별로 개별 추론 (전체 영상 추론 제거)
+std::shared_ptr<const CompiledInspectionPlan> InsProcessor::buildInspectionPlan(const QList<PatternInfo>& patterns,
+                                                                                const QString& recipeName, size_t signature)
+{
+    auto plan = std::make_shared<CompiledInspectionPlan>();
+    plan->frameIndex = patterns.isEmpty() ? -1 : patterns.first().frameIndex;
+    plan->signature = signature;
+    plan->recipeName = recipeName.isEmpty() ? QString("default") : recipeName;
+
+    // 활성화된 패턴들을 유형별로 분류
+    for (int i = 0; i < patterns.size(); i++) {
+        const PatternInfo& pattern = patterns[i];
+        plan->indexById.insert(pattern.id, i);
+
+        // INS 패턴 매칭 검색 영역은 활성 여부와 무관하게 첫 번째 ROI 사용 (기존 동작)
+        if (pattern.type == PatternType::ROI && plan->searchRoiIndex < 0) {
+            plan->searchRoiIndex = i;
+        }
 
-    // 1. 활성화된 패턴들을 유형별로 분류
-    QList<PatternInfo> roiPatterns, fidPatterns, insPatterns;
-    for (const PatternInfo &pattern : patterns)
-    {
-        if (!pattern.enabled)
-        {
-            logDebug(QString("Pattern '%1' disabled - skip inspection").arg(pattern.name));
+        if (!pattern.enabled) {
             continue;
         }
 
-        switch (pattern.type)
-        {
+        switch (pattern.type) {
         case PatternType::ROI:
-            roiPatterns.append(pattern);
+            plan->roiOrder.append(i);
             break;
-
         case PatternType::FID:
-            fidPatterns.append(pattern);
+            plan->fidSlotById.insert(pattern.id, plan->fidOrder.size());
+            plan->fidOrder.append(i);
             break;
-
         case PatternType::INS:
-            insPatterns.append(pattern);
+            plan->insCount++;
+            if (pattern.inspectionMethod == InspectionMethod::A_PC) {
+                plan->anomalyGroupsAPC[anomalyModelPath(plan->recipeName, pattern.name, false)].append(i);
+                plan->anomalyCount++;
+            } else if (pattern.inspectionMethod == InspectionMethod::A_PD) {
+                plan->anomalyGroupsAPD[anomalyModelPath(plan->recipeName, pattern.name, true)].append(i);
+                plan->anomalyCount++;
+            } else {
+                plan->insOrder.append(i);
+            }
             break;
-
         case PatternType::FIL:
-            logDebug(QString("Filter pattern found (ignored): '%1'").arg(pattern.name));
             break;
         }
     }
 
-    // 2. ROI 그룹 분석 및 매핑
-    QMap<QUuid, QUuid> patternToRoiMap; // 패턴 ID -> 속한 ROI ID 매핑
-    QMap<QUuid, QRect> roiGroupAreas;   // ROI ID -> ROI 영역 매핑
-    QList<QRect> activeRoiRects;        // 전체 검사 영역 목록 (기존 호환성)
+    // ANOMALY 배치가 기다려야 하는 부모 FID (fidOrder 순번)
+    for (const auto* groups : {&plan->anomalyGroupsAPC, &plan->anomalyGroupsAPD}) {
+        for (const QList<int>& group : *groups) {
+            for (int idx : group) {
+                int fidSlot = plan->fidSlotById.value(patterns[idx].parentId, -1);
+                if (fidSlot >= 0 && !plan->anomalyFidSlots.contains(fidSlot)) {
+                    plan->anomalyFidSlots.append(fidSlot);
+                }
+            }
+        }
+    }
 
-    if (roiPatterns.isEmpty())
+    // ROI 그룹 분석 및 매핑
+    for (int roiIdx : plan->roiOrder) {
+        const PatternInfo& roiPattern = patterns[roiIdx];
+        QRect roiRect(static_cast<int>(roiPattern.rect.x()),
+                      static_cast<int>(roiPattern.rect.y()),
+                      static_cast<int>(roiPattern.rect.width()),
+                      static_cast<int>(roiPattern.rect.height()));
+        plan->activeRoiRects.append(roiRect);
+        plan->roiGroupAreas[roiPattern.id] = roiRect;
+
+        // ROI의 직접 자식들 (FID들) 및 FID의 자식들 (INS들)을 같은 ROI에 매핑
+        for (const QUuid& childId : roiPattern.childIds) {
+            plan->patternToRoiMap[childId] = roiPattern.id;
+
+            for (int fidIdx : plan->fidOrder) {
+                const PatternInfo& fidPattern = patterns[fidIdx];
+                if (fidPattern.id == childId) {
+                    for (const QUuid& insId : fidPattern.childIds) {
+                        plan->patternToRoiMap[insId] = roiPattern.id;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+
+    return plan;
+}
+
+std::shared_ptr<const CompiledInspectionPlan> InsProcessor::acquireInspectionPlan(const QList<PatternInfo>& patterns)
+{
+    int frameIndex = patterns.isEmpty() ? -1 : patterns.first().frameIndex;
+    size_t signature = computePlanSignature(patterns);
+
+    {
+        QMutexLocker locker(&planMutex);
+        auto it = compiledPlans.constFind(frameIndex);
+        if (it != compiledPlans.constEnd() && it.value() && it.value()->signature == signature) {
+            return it.value();
+        }
+    }
+
+    // 계획이 없거나 패턴 구성이 바뀜 → 현재 레시피 기준으로 재컴파일
+    QString recipeName = ConfigManager::instance()->getLastRecipePath();
+    auto plan = buildInspectionPlan(patterns, recipeName, signature);
+
+    QMutexLocker locker(&planMutex);
+    compiledPlans[frameIndex] = plan;
+    return plan;
+}
+
+void InsProcessor::compileInspectionPlan(const QList<PatternInfo>& patterns, const QString& recipeName)
+{
+    if (patterns.isEmpty()) {
+        return;
+    }
+
+    auto plan = buildInspectionPlan(patterns, recipeName, computePlanSignature(patterns));
+
+    // 템플릿 디코딩과 회전 템플릿 뱅크도 미리 생성 (첫 트리거에서 변환/회전 비용 생략)
+    for (int idx : plan->fidOrder) {
+        warmupRotationBank(patterns[idx]);
+    }
+    for (int idx : plan->insOrder) {
+        const PatternInfo& pattern = patterns[idx];
+        acquireTemplate(pattern, TemplateUsage::Inspection);
+        if (!pattern.filters.isEmpty()) {
+            acquireFilterChain(pattern);
+        }
+        if (pattern.patternMatchEnabled && !pattern.matchTemplate.isNull()) {
+            warmupRotationBank(pattern);
+        }
+    }
+
+    QMutexLocker locker(&planMutex);
+    compiledPlans[plan->frameIndex] = plan;
+}
+
+void InsProcessor::invalidateInspectionPlans()
+{
+    {
+        QMutexLocker locker(&planMutex);
+        compiledPlans.clear();
+    }
+    // 패턴이 바뀌면 직전 위치도 의미가 없음
+    resetFidTracking();
+}
+
+void InsProcessor::setFidTrackingEnabled(bool enabled)
+{
+    fidTrackingEnabled.store(enabled);
+    if (!enabled)
+        resetFidTracking();
+}
+
+void InsProcessor::resetFidTracking()
+{
+    QMutexLocker locker(&trackMutex);
+    fidTracks.clear();
+}
+
+std::shared_ptr<const CachedTemplate> InsProcessor::decodeTemplate(const QImage& image, const QImage& mask, TemplateUsage usage)
+{
+    auto entry = std::make_shared<CachedTemplate>();
+    entry->imageKey = image.cacheKey();
+    entry->maskKey = mask.isNull() ? 0 : mask.cacheKey();
+
+    if (usage == TemplateUsage::Inspection)
+    {
+        // 검사용: RGB888로 맞춘 뒤 BGR 변환
+        QImage converted = image.convertToFormat(QImage::Format_RGB888);
+        cv::Mat rgb(converted.height(), converted.width(), CV_8UC3,
+                    const_cast<uchar *>(converted.constBits()), converted.bytesPerLine());
+        cv::cvtColor(rgb, entry->bgr, cv::COLOR_RGB2BGR);
+    }
+    else if (image.format() == QImage::Format_RGB32 || image.format() == QImage::Format_ARGB32)
+    {
+        // 매칭용 RGB32 (4채널 -> 3채널)
+        cv::Mat rgba(image.height(), image.width(), CV_8UC4,
+                     const_cast<uchar *>(image.constBits()), image.bytesPerLine());
+        cv::cvtColor(rgba, entry->bgr, cv::COLOR_RGBA2BGR);
+    }
+    else if (image.format() == QImage::Format_Grayscale8)
     {
-        // ROI가 없으면 전체 이미지 영역을 활성 영역으로 간주
-        activeRoiRects.append(QRect(0, 0, image.cols, image.rows));
-        logDebug("No active ROI patterns, inspect entire area");
+        cv::Mat gray(image.height(), image.width(), CV_8UC1,
+                     const_cast<uchar *>(image.constBits()), image.bytesPerLine());
+        entry->gray = gray.clone();
+        cv::cvtColor(entry->gray, entry->bgr, cv::COLOR_GRAY2BGR);
     }
     else
     {
-        // ROI 기반 그룹 분석
-        for (const PatternInfo &roiPattern : roiPatterns)
+        // RGB888 및 기타 포맷
+        QImage converted = image.convertToFormat(QImage::Format_RGB888);
+        cv::Mat rgb(converted.height(), converted.width(), CV_8UC3,
+                    const_cast<uchar *>(converted.constBits()), converted.bytesPerLine());
+        cv::cvtColor(rgb, entry->bgr, cv::COLOR_RGB2BGR);
+    }
+
+    if (entry->bgr.empty())
+    {
+        return entry;
+    }
+
+    if (entry->gray.empty())
+    {
+        cv::cvtColor(entry->bgr, entry->gray, cv::COLOR_BGR2GRAY);
+    }
+
+    if (!mask.isNull())
+    {
+        QImage mask8 = mask.convertToFormat(QImage::Format_Grayscale8);
+        entry->mask = cv::Mat(mask8.height(), mask8.width(), CV_8UC1,
+                              const_cast<uchar *>(mask8.constBits()), mask8.bytesPerLine()).clone();
+        if (entry->mask.size() != entry->gray.size())
         {
-            activeRoiRects.append(QRect(
-                static_cast<int>(roiPattern.rect.x()),
-                static_cast<int>(roiPattern.rect.y()),
-                static_cast<int>(roiPattern.rect.width()),
-                static_cast<int>(roiPattern.rect.height())));
-            roiGroupAreas[roiPattern.id] = QRect(
-                static_cast<int>(roiPattern.rect.x()),
-                static_cast<int>(roiPattern.rect.y()),
-                static_cast<int>(roiPattern.rect.width()),
-                static_cast<int>(roiPattern.rect.height()));
-
-            // ROI의 직접 자식들 (FID들) 매핑
-            for (const QUuid &childId : roiPattern.childIds)
-            {
-                patternToRoiMap[childId] = roiPattern.id;
+            entry->mask.release();
+        }
+    }
 
-                // FID의 자식들 (INS들)도 같은 ROI에 매핑
-                for (const PatternInfo &fidPattern : fidPatterns)
-                {
-                    if (fidPattern.id == childId)
-                    {
-                        for (const QUuid &insId : fidPattern.childIds)
-                        {
-                            patternToRoiMap[insId] = roiPattern.id;
-                        }
-                        break;
-                    }
-                }
-            }
+    return entry;
+}
+
+std::shared_ptr<const CachedTemplate> InsProcessor::acquireTemplate(const PatternInfo& pattern, TemplateUsage usage)
+{
+    // 매칭용은 matchTemplate 우선, 없으면 templateImage 사용 (FID와 동일)
+    const QImage& image = (usage == TemplateUsage::Matching && !pattern.matchTemplate.isNull())
+                              ? pattern.matchTemplate : pattern.templateImage;
+    if (image.isNull())
+    {
+        return nullptr;
+    }
+
+    QImage mask = (usage == TemplateUsage::Matching && !pattern.matchTemplate.isNull())
+                      ? pattern.matchTemplateMask : QImage();
+    qint64 maskKey = mask.isNull() ? 0 : mask.cacheKey();
+
+    auto& cache = (usage == TemplateUsage::Matching) ? matchingTemplates : inspectionTemplates;
+    {
+        QMutexLocker locker(&templateMutex);
+        auto it = cache.constFind(pattern.id);
+        if (it != cache.constEnd() && (*it)->imageKey == image.cacheKey() && (*it)->maskKey == maskKey)
+        {
+            return *it;
+        }
+    }
+
+    // 캐시 미스 또는 템플릿 리비전 변경 -> 디코딩 (락 밖에서 수행)
+    auto entry = decodeTemplate(image, mask, usage);
+
+    QMutexLocker locker(&templateMutex);
+    cache[pattern.id] = entry;
+    return entry;
+}
+
+void InsProcessor::clearTemplateCache()
+{
+    QMutexLocker locker(&templateMutex);
+    inspectionTemplates.clear();
+    matchingTemplates.clear();
+    rotationBanks.clear();
+    filterChains.clear();
+}
+
+std::shared_ptr<const FilterChain> InsProcessor::acquireFilterChain(const PatternInfo& pattern)
+{
+    size_t signature = FilterChain::computeSignature(pattern.filters);
+    {
+        QMutexLocker locker(&templateMutex);
+        auto it = filterChains.constFind(pattern.id);
+        if (it != filterChains.constEnd() && (*it)->signature() == signature)
+        {
+            return *it;
+        }
+    }
+
+    auto chain = std::make_shared<const FilterChain>(pattern.filters);
+
+    QMutexLocker locker(&templateMutex);
+    filterChains[pattern.id] = chain;
+    return chain;
+}
+
+std::shared_ptr<const RotatedTemplateBank> InsProcessor::acquireRotationBank(const PatternInfo& pattern,
+                                                                             const cv::Mat& templ, const cv::Mat& templGray,
+                                                                             const cv::Mat& mask,
+                                                                             double minAngle, double maxAngle, double angleStep)
+{
+    // 캐시된 매칭 템플릿(BGR/그레이, 마스크)으로 호출된 경우에만 뱅크를 보관
+    auto cached = acquireTemplate(pattern, TemplateUsage::Matching);
+    bool cacheable = cached &&
+                     (templ.data == cached->bgr.data || templ.data == cached->gray.data) &&
+                     (mask.empty() || mask.data == cached->mask.data);
+    if (!cacheable)
+    {
+        return buildRotatedTemplateBank(templGray, mask, minAngle, maxAngle, angleStep);
+    }
+
+    qint64 maskKey = mask.empty() ? 0 : cached->maskKey;
+    {
+        QMutexLocker locker(&templateMutex);
+        auto it = rotationBanks.constFind(pattern.id);
+        if (it != rotationBanks.constEnd() &&
+            (*it)->imageKey == cached->imageKey && (*it)->maskKey == maskKey &&
+            (*it)->minAngle == minAngle && (*it)->maxAngle == maxAngle && (*it)->angleStep == angleStep)
+        {
+            return *it;
+        }
+    }
+
+    // 뱅크 생성은 락 밖에서 수행
+    auto bank = buildRotatedTemplateBank(cached->gray, mask.empty() ? cv::Mat() : cached->mask,
+                                         minAngle, maxAngle, angleStep);
+    bank->imageKey = cached->imageKey;
+    bank->maskKey = maskKey;
+
+    QMutexLocker locker(&templateMutex);
+    rotationBanks[pattern.id] = bank;
+    return bank;
+}
+
+void InsProcessor::warmupRotationBank(const PatternInfo& pattern)
+{
+    auto cached = acquireTemplate(pattern, TemplateUsage::Matching);
+    if (!cached || cached->bgr.empty())
+    {
+        return;
+    }
+
+    // 매칭 호출부와 같은 각도 범위/마스크 사용 (다르면 첫 트리거에서 뱅크를 다시 만든다)
+    const RotationSearch search = rotationSearchFor(pattern, *cached);
+    acquireRotationBank(pattern, cached->bgr, cached->gray, search.mask,
+                        search.minAngle, search.maxAngle, search.angleStep);
+}
+
+InsProcessor::RotationSearch InsProcessor::rotationSearchFor(const PatternInfo& pattern, const CachedTemplate& templ)
+{
+    RotationSearch search;
+    if (pattern.type == PatternType::FID)
+    {
+        // FID는 마스크 없이 매칭 (속도 최적화), 회전 미사용이면 티칭 각도 하나 (스텝 1도)
+        if (pattern.useRotation)
+        {
+            search.minAngle = pattern.minAngle;
+            search.maxAngle = pattern.maxAngle;
+            search.angleStep = pattern.angleStep;
         }
+        return search;
+    }
+
+    search.mask = templ.mask;
+    if (pattern.patternMatchUseRotation)
+    {
+        search.minAngle = pattern.patternMatchMinAngle;
+        search.maxAngle = pattern.patternMatchMaxAngle;
+        search.angleStep = pattern.patternMatchAngleStep;
+    }
+
+    // 패턴 회전이 꺼져 있으면 티칭 각도만 검색 (performTemplateMatching과 동일, 스텝은 유지)
+    if (!pattern.useRotation)
+    {
+        search.minAngle = 0.0;
+        search.maxAngle = 0.0;
+    }
+    return search;
+}
+
+FrameContext::FrameContext(const cv::Mat &image, const cv::Mat &gray, quint64 traceId)
+    : image(image), frameTraceId(traceId)
+{
+    if (!gray.empty() && gray.size() == image.size() && gray.type() == CV_8UC1)
+    {
+        grayPlane = gray;
+        std::call_once(grayOnce, [] {});
     }
+}
+
+const cv::Mat &FrameContext::gray() const
+{
+    std::call_once(grayOnce, [this] {
+        if (image.channels() == 3)
+            cv::cvtColor(image, grayPlane, cv::COLOR_BGR2GRAY);
+        else if (image.channels() == 4)
+            cv::cvtColor(image, grayPlane, cv::COLOR_BGRA2GRAY);
+        else
+            grayPlane = image;
+    });
+    return grayPlane;
+}
+
+InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QList<PatternInfo> &patterns, const QString& cameraName)
+{
+    return performInspection(FrameContext(image), patterns, cameraName);
+}
+
+InspectionResult InsProcessor::performInspection(const FrameContext &frame, const QList<PatternInfo> &patterns, const QString& cameraName)
+{
+    InspectionResult result;
+    const cv::Mat &image = frame.bgr();
+
+    if (image.empty() || patterns.isEmpty())
+    {
+        logDebug("Inspection failed: image is empty or no patterns");
+        return result;
+    }
+
+    // 검사 시작 시간 측정
+    auto startTime = std::chrono::high_resolution_clock::now();
+    
+    // 패턴 프레임 인덱스 추출 (로그용)
+    int frameIndex = -1;
+    if (!patterns.isEmpty()) {
+        frameIndex = patterns.first().frameIndex;
+    }
+    
+    // 프레임별 레이블 (CommonDefs.h의 FRAME_LABELS 사용)
+    QString stageLabel = (frameIndex >= 0 && frameIndex < FRAME_LABELS.size()) ? FRAME_LABELS[frameIndex] : QString("Frame %1").arg(frameIndex);
+    
+    // 검사 시작 로그 (옵션 2 형식)
+    QString cameraInfo = cameraName.isEmpty() ? "" : QString(" (Cam %1)").arg(cameraName);
+    logDebug(QString("[Inspect Start] %1%2").arg(stageLabel).arg(cameraInfo));
+
+    result.isPassed = true;
+    
+    // PatchCore는 각 ANOMALY 패턴별로 개별 추론 (전체 영상 추론 제거)
+
+    // 1~2. 패턴 분류 / ROI 그룹 매핑 / 모델 경로는 컴파일된 검사 계획에서 가져옴
+    std::shared_ptr<const CompiledInspectionPlan> plan = acquireInspectionPlan(patterns);
+    const QMap<QUuid, QUuid> &patternToRoiMap = plan->patternToRoiMap; // 패턴 ID -> 속한 ROI ID 매핑
+    const QMap<QUuid, QRect> &roiGroupAreas = plan->roiGroupAreas;     // ROI ID -> ROI 영역 매핑
+    const QList<QRect> &activeRoiRects = plan->activeRoiRects;         // 전체 검사 영역 목록 (기존 호환성)
+    const bool hasRoiPatterns = !plan->roiOrder.isEmpty();
 
     // 3. 패턴이 특정 ROI 그룹 내에 있는지 확인하는 헬퍼 함수 (FID 매칭 영역 제한용)
-    auto isInGroupROI = [&patternToRoiMap, &roiGroupAreas, &roiPatterns, this](const QUuid &patternId, const QPoint &center, bool isFidPattern) -> bool
+    auto isInGroupROI = [&patternToRoiMap, &roiGroupAreas, hasRoiPatterns, this](const QUuid &patternId, const QPoint &center, bool isFidPattern) -> bool
     {
         // ROI가 없으면 항상 true 반환 (기존 동작 유지)
-        if (roiPatterns.isEmpty())
+        if (!hasRoiPatterns)
             return true;
 
         // INS 패턴은 ROI 제한 없이 항상 검사 (ROI는 FID 매칭 영역만 제한)
@@ -310,9 +1355,9 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
     };
 
     // 4. 기존 ROI 영역 확인 함수 (기존 코드 호환성 유지)
-    auto isInROI = [&activeRoiRects, &roiPatterns](const QPoint &center) -> bool
+    auto isInROI = [&activeRoiRects, hasRoiPatterns](const QPoint &center) -> bool
     {
-        if (roiPatterns.isEmpty())
+        if (!hasRoiPatterns)
             return true;
 
         for (const QRect &roiRect : activeRoiRects)
@@ -325,324 +1370,988 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
     };
 
     // 5. FID 패턴 매칭 수행 (그룹 ROI 제한 적용)
-    if (!fidPatterns.isEmpty())
+    //    모든 FID를 동시에 시작하고, INS/ANOMALY는 전체 FID가 아니라 자기 부모 FID만 기다린다.
+    const int fidCount = plan->fidOrder.size();
+    QVector<bool> fidScheduled(fidCount, false);
+    for (int fidSlot = 0; fidSlot < fidCount; fidSlot++)
     {
-        for (const PatternInfo &pattern : fidPatterns)
+        const PatternInfo &pattern = patterns[plan->fidOrder[fidSlot]];
+
+        // 매칭 검사가 활성화된 경우에만 수행
+        if (!pattern.runInspection)
         {
-            // 매칭 검사가 활성화된 경우에만 수행
-            if (!pattern.runInspection)
-            {
-                logDebug(QString("FID pattern '%1': inspection disabled, skip").arg(pattern.name));
-                continue;
-            }
+            logDebug(QString("FID pattern '%1': inspection disabled, skip").arg(pattern.name));
+            continue;
+        }
 
-            // **중요**: ROI 영역은 FID 매칭 영역을 제한 (패턴 매칭 최적화)
-            QPoint patternCenter = QPoint(
-                static_cast<int>(pattern.rect.center().x()),
-                static_cast<int>(pattern.rect.center().y()));
-            if (!isInGroupROI(pattern.id, patternCenter, true))  // true = FID 패턴
-            {
-                logDebug(QString("FID pattern '%1': outside ROI, excluded from matching").arg(pattern.name));
-                continue;
-            }
+        // **중요**: ROI 영역은 FID 매칭 영역을 제한 (패턴 매칭 최적화)
+        QPoint patternCenter = QPoint(
+            static_cast<int>(pattern.rect.center().x()),
+            static_cast<int>(pattern.rect.center().y()));
+        if (!isInGroupROI(pattern.id, patternCenter, true))  // true = FID 패턴
+        {
+            logDebug(QString("FID pattern '%1': outside ROI, excluded from matching").arg(pattern.name));
+            continue;
+        }
 
-            // 기존 ROI 검사도 유지 (하위 호환성)
-            if (!isInROI(patternCenter))
-            {
-                logDebug(QString("FID pattern '%1': outside ROI, excluded from inspection").arg(pattern.name));
-                continue;
-            }
+        // 기존 ROI 검사도 유지 (하위 호환성)
+        if (!isInROI(patternCenter))
+        {
+            logDebug(QString("FID pattern '%1': outside ROI, excluded from inspection").arg(pattern.name));
+            continue;
+        }
 
-            double matchScore = 0.0;
-            cv::Point matchLoc;
-            double matchAngle = 0.0;
+        fidScheduled[fidSlot] = true;
+    }
 
-            // **중요**: matchFiducial에 그룹 ROI 정보도 전달
-            auto fidStart = std::chrono::high_resolution_clock::now();
-            bool fidMatched = matchFiducial(image, pattern, matchScore, matchLoc, matchAngle, patterns);
-            auto fidEnd = std::chrono::high_resolution_clock::now();
-            auto fidDuration = std::chrono::duration_cast<std::chrono::milliseconds>(fidEnd - fidStart).count();
-            
-            // FID 패턴 로그 (점수 포함)
-            logDebug(QString("  └─ <font color='#7094DB'>FID: %1</font> [%2%/%3%] (%4ms)")
-                .arg(pattern.name)
-                .arg(matchScore * 100.0, 0, 'f', 1)
-                .arg(pattern.matchThreshold, 0, 'f', 1)
-                .arg(fidDuration));
-
-            // 매칭 성공 시 검출된 각도를 FID 그룹 전체에 적용
-            if (fidMatched)
-            {
-                // FID 패턴의 각도를 검출된 각도로 업데이트
-                double oldAngle = pattern.angle;
-                const_cast<PatternInfo &>(pattern).angle = matchAngle;
-                result.angles[pattern.id] = matchAngle;
-            }
-            else
-            {
-                // 매칭 실패 시에도 검출된 각도는 적용
-                logDebug(QString("FID pattern '%1' match failed - but detected angle applied: %2°")
-                             .arg(pattern.name)
-                             .arg(matchAngle, 0, 'f', 2));
+    FidTaskBoard fidBoard(fidCount);
+    auto matchFidSlot = [&](int fidSlot, FidTaskBoard::Outcome &outcome)
+    {
+        const PatternInfo &pattern = patterns[plan->fidOrder[fidSlot]];
+        InspectionTraceScope fidTrace(frame.traceId(), "FID", pattern.name);
+
+        // **중요**: matchFiducial에 그룹 ROI 정보도 전달
+        auto fidStart = std::chrono::high_resolution_clock::now();
+        outcome.matched = matchFiducial(frame, pattern, outcome.score, outcome.location, outcome.angle, patterns,
+                                        &outcome.subPixelLocation);
+        auto fidEnd = std::chrono::high_resolution_clock::now();
+        outcome.elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(fidEnd - fidStart).count();
+        outcome.elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(fidEnd - fidStart).count();
+    };
 
-                // FID 패턴의 각도를 검출된 각도로 업데이트 (매칭 실패와 무관)
-                double oldAngle = pattern.angle;
-                const_cast<PatternInfo &>(pattern).angle = matchAngle;
-                result.angles[pattern.id] = matchAngle;
+    // FID 결과 조회 (아직 시작 안 됐으면 현재 스레드에서 매칭, 매칭 중이면 대기). 매칭 대상이 아니면 nullptr
+    auto awaitFid = [&](int fidSlot) -> const FidTaskBoard::Outcome *
+    {
+        if (fidSlot < 0 || !fidScheduled[fidSlot])
+            return nullptr;
+        return &fidBoard.ensure(fidSlot, [&matchFidSlot, fidSlot](FidTaskBoard::Outcome &outcome) {
+            matchFidSlot(fidSlot, outcome);
+        });
+    };
 
-                // 마찬가지로 매칭 실패 시에도 자식 INS의 티칭 각도는 유지합니다.
-            }
+    // 비어 있는 풀 스레드에서 FID 매칭 시작 (못 띄운 FID는 결과가 필요한 스레드가 직접 처리)
+    const bool parallelEnabled = parallelInspectionEnabled.load();
+    int fidHelpers = 0;
+    QSemaphore fidHelpersDone;
+    for (int fidSlot = 0; parallelEnabled && fidSlot < fidCount; fidSlot++)
+    {
+        if (!fidScheduled[fidSlot])
+            continue;
+        if (!insThreadPool.tryStart([&awaitFid, &fidHelpersDone, fidSlot]() {
+                auto releaseHelper = qScopeGuard([&fidHelpersDone]() { fidHelpersDone.release(); });
+                try {
+                    awaitFid(fidSlot);
+                } catch (...) {
+                    // 결과는 작업판에 남으므로 여기서는 풀 스레드 밖으로 예외가 나가지 않게만 한다
+                }
+            }))
+            break;
+        fidHelpers++;
+    }
 
-            // 결과 기록
-            result.fidResults[pattern.id] = fidMatched;
-            result.matchScores[pattern.id] = matchScore;
-            result.locations[pattern.id] = matchLoc;    
-            result.isPassed = result.isPassed && fidMatched;
+    // 어떤 경로로 빠져나가든(예외 포함) 풀에서 띄운 FID 작업이 끝난 뒤에 지역 변수가 사라지도록 대기
+    auto joinFidHelpers = qScopeGuard([&fidHelpersDone, &fidHelpers]() {
+        fidHelpersDone.acquire(fidHelpers);
+        fidHelpers = 0;
+    });
+
+    // FID 결과를 result에 기록 (검사 스레드에서만 호출, FID당 한 번)
+    QVector<bool> fidCommitted(fidCount, false);
+    auto commitFid = [&](int fidSlot)
+    {
+        if (fidSlot < 0 || fidCommitted[fidSlot])
+            return;
+        fidCommitted[fidSlot] = true;
+
+        const FidTaskBoard::Outcome *outcome = awaitFid(fidSlot);
+        if (!outcome)
+            return;
+        const PatternInfo &pattern = patterns[plan->fidOrder[fidSlot]];
+
+        if (!outcome->error.isEmpty())
+        {
+            logDebug(QString("FID pattern '%1': 매칭 중 예외 발생 - %2").arg(pattern.name).arg(outcome->error));
+        }
+
+        // FID 패턴 로그 (점수 포함)
+        logDebug(QString("  └─ <font color='#7094DB'>FID: %1</font> [%2%/%3%] (%4ms)")
+            .arg(pattern.name)
+            .arg(outcome->score * 100.0, 0, 'f', 1)
+            .arg(pattern.matchThreshold, 0, 'f', 1)
+            .arg(outcome->elapsedMs));
+
+        // 매칭 성공/실패와 무관하게 검출된 각도를 FID 그룹 전체에 적용
+        // (patterns는 티칭 원본이므로 수정하지 않고 result.angles로만 전달)
+        if (!outcome->matched)
+        {
+            logDebug(QString("FID pattern '%1' match failed - but detected angle applied: %2°")
+                         .arg(pattern.name)
+                         .arg(outcome->angle, 0, 'f', 2));
         }
+
+        // 결과 기록
+        result.angles[pattern.id] = outcome->angle;
+        result.fidResults[pattern.id] = outcome->matched;
+        result.patternTimesUs[pattern.id] = outcome->elapsedUs;
+        result.matchScores[pattern.id] = outcome->score;
+        result.locations[pattern.id] = outcome->location;
+        if (outcome->matched)
+            result.subPixelLocations[pattern.id] = outcome->subPixelLocation;
+        result.isPassed = result.isPassed && outcome->matched;
+    };
+
+    // 병렬 실행이 꺼져 있으면 기존처럼 FID를 모두 끝낸 뒤 INS 검사
+    if (!parallelEnabled)
+    {
+        for (int fidSlot = 0; fidSlot < fidCount; fidSlot++)
+            commitFid(fidSlot);
     }
 
     // 6. INS 패턴 검사 수행 (그룹 ROI 제한 적용)
-    if (!insPatterns.isEmpty())
+    if (plan->insCount > 0)
     {
-        // ===== ANOMALY 패턴 배치 처리 =====
-        // 같은 모델을 사용하는 ANOMALY 패턴들을 그룹화
-        QMap<QString, QList<PatternInfo>> anomalyGroupsAPC; // key: 모델 경로 (A-PC)
-        QMap<QString, QList<PatternInfo>> anomalyGroupsAPD; // key: 모델 경로 (A-PD)
-        QMap<QUuid, int> anomalyPatternIndexMap; // 패턴 ID -> 배치 내 인덱스
-        
-        int totalAnomalyCount = 0;
-        for (const PatternInfo &pattern : insPatterns)
+        // ===== 일반 INS 패턴 처리 (A-PC, A-PD 제외 - 아래 ANOMALY 배치에서 처리) =====
+        // 각 INS 패턴은 자기 부모 FID 결과만 기다리고(fidBoard), 자기 결과 슬롯(slot)에만 기록한다.
+        // result는 검사 스레드가 FID/ANOMALY 결과를 쓰는 중이므로 읽지 않는다. 슬롯은 마지막에 검사 순서대로 병합한다.
+        auto runInsPattern = [&](int insIdx, InspectionResult &slot, QString &summary)
         {
-            if (pattern.inspectionMethod == InspectionMethod::A_PC)
+            const PatternInfo &pattern = patterns[insIdx];
+            
+            // 패턴 매칭(Fine Alignment)으로 갱신될 수 있는 INS 각도 (원본 패턴은 수정하지 않음)
+            double insAngle = pattern.angle;
+            
+            // 마스크 필터가 활성화되어 있으면 검사 PASS 처리
+            bool hasMaskFilter = false;
+            for (const FilterInfo &filter : pattern.filters)
             {
-                totalAnomalyCount++;
-                // 현재 레시피명 가져오기
-                QString recipeName = ConfigManager::instance()->getLastRecipePath();
-                if (recipeName.isEmpty()) {
-                    recipeName = "default";
+                if (filter.enabled && filter.type == FILTER_MASK)
+                {
+                    hasMaskFilter = true;
+                    break;
                 }
-                
-                // 모델 파일 경로 (레시피별)
-                QString weightsDir = QCoreApplication::applicationDirPath() + "/recipes/" + recipeName + "/weights";
-#ifdef USE_TENSORRT
-                QString modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + ".trt";
-#else
-                QString modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + ".onnx";
-#endif
-                anomalyGroupsAPC[modelPath].append(pattern);
             }
-            else if (pattern.inspectionMethod == InspectionMethod::A_PD)
+            if (hasMaskFilter)
+            {
+                logDebug(QString("INS 패턴 '%1': 마스크 필터 활성화 → 검사 PASS 처리").arg(pattern.name));
+                slot.insResults[pattern.id] = true;
+                slot.insScores[pattern.id] = 1.0;
+                slot.adjustedRects[pattern.id] = pattern.rect;
+                slot.insMethodTypes[pattern.id] = InspectionMethod::DIFF;
+                return;
+            }
+
+            // 기본 검사 영역은 패턴의 원본 영역
+            QRect originalRect = QRect(
+                static_cast<int>(pattern.rect.x()),
+                static_cast<int>(pattern.rect.y()),
+                static_cast<int>(pattern.rect.width()),
+                static_cast<int>(pattern.rect.height()));
+            QRect adjustedRect = originalRect;
+
+            // ===== INS 패턴 매칭 (Fine Alignment) =====
+            // 부모 FID와 무관하게 독립적으로 동작
+            if (pattern.patternMatchEnabled && !pattern.matchTemplate.isNull())
             {
-                totalAnomalyCount++;
-                // 현재 레시피명 가져오기
-                QString recipeName = ConfigManager::instance()->getLastRecipePath();
-                if (recipeName.isEmpty()) {
-                    recipeName = "default";
+                // 검색 범위: 부모 ROI 전체 영역 (현재 STRIP/CRIMP 모드에 맞는 ROI)
+                cv::Rect searchROI;
+                
+                // 부모 ROI (검사 계획에서 미리 찾아둔 첫 번째 ROI)
+                if (plan->searchRoiIndex >= 0) {
+                    const PatternInfo& p = patterns[plan->searchRoiIndex];
+                    searchROI = cv::Rect(
+                        static_cast<int>(p.rect.x()),
+                        static_cast<int>(p.rect.y()),
+                        static_cast<int>(p.rect.width()),
+                        static_cast<int>(p.rect.height())
+                    );
                 }
                 
-                // 모델 파일 경로 (레시피별, _padim suffix)
-                QString weightsDir = QCoreApplication::applicationDirPath() + "/recipes/" + recipeName + "/weights";
-#ifdef USE_TENSORRT
-                QString modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + "_padim.trt";
-#else
-                QString modelPath = weightsDir + "/" + pattern.name + "/" + pattern.name + "_padim.onnx";
-#endif
-                anomalyGroupsAPD[modelPath].append(pattern);
-            }
-        }
-        
-        // ANOMALY 전체 처리 시작
-        auto anomalyBatchStart = std::chrono::high_resolution_clock::now();
-        int anomalyGroupCount = anomalyGroupsAPC.size() + anomalyGroupsAPD.size();
-        
-        // 변수 선언을 ifdef 밖에서 (밖에서 사용하기 위해)
-        auto apcBatchStart = std::chrono::high_resolution_clock::now();
-        int apcPatternCount = 0;
-        auto apdBatchStart = std::chrono::high_resolution_clock::now();
-        int apdPatternCount = 0;
-        
-#ifdef USE_TENSORRT
-        // ===== A-PC TensorRT 멀티모델 병렬 처리 =====
-        if (anomalyGroupsAPC.size() >= 1) {
-            // 모든 모델 로드
-            QMap<QString, std::vector<cv::Mat>> modelImages;
-            QMap<QString, QList<PatternInfo>> modelValidPatterns;
-            
-            int loadedModelCount = 0;
-            for (auto groupIt = anomalyGroupsAPC.begin(); groupIt != anomalyGroupsAPC.end(); ++groupIt) {
-                const QString& modelPath = groupIt.key();
-                const QList<PatternInfo>& group = groupIt.value();
-                
-                if (group.isEmpty()) continue;
-                
-                // 모델 로드
-                if (!initPatchCoreModel(modelPath)) {
-                    logDebug(QString("ANOMALY: 모델 로드 실패 - %1").arg(modelPath));
-                    for (const PatternInfo& pattern : group) {
-                        result.insResults[pattern.id] = false;
-                        result.insScores[pattern.id] = 0.0;
-                        result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
-                        result.isPassed = false;
+                // ROI를 못 찾으면 전체 이미지 사용
+                if (searchROI.area() == 0) {
+                    searchROI = cv::Rect(0, 0, image.cols, image.rows);
+                }
+
+                // 캐시된 매칭용 템플릿 (BGR + 마스크)
+                auto matchTmpl = acquireTemplate(pattern, TemplateUsage::Matching);
+                cv::Mat templateMat = matchTmpl ? matchTmpl->bgr : cv::Mat();
+
+                if (!templateMat.empty() && searchROI.width > 0 && searchROI.height > 0)
+                {
+                    // 검색 영역 추출 (프레임 공용 흑백 평면에서 복사 없이)
+                    cv::Mat searchRegion = frame.grayRegion(searchROI);
+
+                    // 패턴 매칭 수행
+                    cv::Point matchLoc;
+                    double matchScore = 0.0;
+                    double matchAngle = insAngle;
+
+                    const RotationSearch search = rotationSearchFor(pattern, *matchTmpl);
+                    auto insMatchStart = std::chrono::high_resolution_clock::now();
+                    bool matched = performTemplateMatching(
+                        searchRegion,
+                        templateMat,
+                        matchLoc,
+                        matchScore,
+                        matchAngle,
+                        pattern,
+                        search.minAngle,
+                        search.maxAngle,
+                        search.angleStep,
+                        search.mask  // 마스크 전달
+                    );
+                    // 패턴 매칭 완료
+
+                    if (matched && (matchScore * 100.0) >= pattern.patternMatchThreshold)
+                    {
+                        // 패턴 매칭 성공 - 찾은 위치로 검사 영역 업데이트
+                        int matchedCenterX = searchROI.x + matchLoc.x;
+                        int matchedCenterY = searchROI.y + matchLoc.y;
+
+                        // 패턴 매칭 성공
+
+                        // 검사 영역을 매칭된 위치로 업데이트
+                        adjustedRect = QRect(
+                            matchedCenterX - pattern.rect.width() / 2,
+                            matchedCenterY - pattern.rect.height() / 2,
+                            pattern.rect.width(),
+                            pattern.rect.height()
+                        );
+
+                        // 각도도 업데이트 (검사 시 사용)
+                        insAngle = matchAngle;
+                    }
+                    else
+                    {
+                        logDebug(QString("INS 패턴 '%1': 패턴 매칭 실패 (Score=%2% < Threshold=%3%), 원본 위치 사용")
+                                     .arg(pattern.name)
+                                     .arg(matchScore * 100.0, 0, 'f', 1)
+                                     .arg(pattern.patternMatchThreshold, 0, 'f', 1));
                     }
-                    continue;
                 }
-                loadedModelCount++;
-                
-                std::vector<cv::Mat> roiImages;
-                QList<PatternInfo> validPatterns;
-                
-                // ROI 추출 (기존 로직과 동일)
-                for (const PatternInfo &pattern : group) {
-                    QRect adjustedRect = QRect(
-                        static_cast<int>(pattern.rect.x()),
-                        static_cast<int>(pattern.rect.y()),
-                        static_cast<int>(pattern.rect.width()),
-                        static_cast<int>(pattern.rect.height()));
-                    
-                    // 부모 FID 정보 확인 및 위치 조정
-                    if (!pattern.parentId.isNull())
+                else
+                {
+                    logDebug(QString("INS 패턴 '%1': 패턴 매칭 실패 - templateMat.empty()=%2, searchROI 유효=%3")
+                                 .arg(pattern.name)
+                                 .arg(templateMat.empty())
+                                 .arg(searchROI.width > 0 && searchROI.height > 0));
+                }
+            }
+
+            // 부모 FID 정보가 있는 경우 처리 (패턴 매칭 후에 추가 조정)
+            cv::Point parentOffset(0, 0);
+            double parentAngle = 0.0;
+            double parentFidTeachingAngle = 0.0;
+            bool hasParentInfo = false;
+
+            // 부모 FID 매칭 결과 (부모 FID가 끝날 때까지만 대기, 매칭 대상이 아니면 nullptr)
+            const FidTaskBoard::Outcome *parentFid = pattern.parentId.isNull()
+                ? nullptr : awaitFid(plan->fidSlotById.value(pattern.parentId, -1));
+
+            // 부모 FID가 있는지 확인
+            if (!pattern.parentId.isNull())
+            {
+                // 부모 FID의 매칭 결과가 있는지 확인
+                if (parentFid)
+                {
+                    // 부모 FID가 매칭에 실패했을 경우 이 INS 패턴은 FAIL (검사 불가)
+                    if (!parentFid->matched)
                     {
-                        if (result.fidResults.contains(pattern.parentId))
+                        logDebug(QString("INS pattern '%1': FAIL - Cannot inspect (parent FID match failed)")
+                                     .arg(pattern.name));
+                        slot.insResults[pattern.id] = false;
+                        slot.insScores[pattern.id] = 0.0;
+                        slot.isPassed = false;
+                        return;
+                    }
+
+                    // FID 점수 확인 - 1.0이면 위치 조정 생략
+                    double fidScore = parentFid->score;
+                    if (fidScore >= 0.999)
+                    {
+
+                        // 위치 조정하지 않고 원래 패턴 위치 그대로 사용
+                        adjustedRect = originalRect;
+                    }
+                    else
+                    {
+
+                        // 부모 FID의 위치 정보가 있는 경우 조정
+                        if (parentFid)
                         {
-                            if (!result.fidResults[pattern.parentId])
+                            cv::Point fidLoc = parentFid->location;
+                            cv::Point2f fidLocPrecise = parentFid->matched ? parentFid->subPixelLocation
+                                                                           : cv::Point2f(fidLoc.x, fidLoc.y);
+                            double fidAngle = parentFid->angle;
+
+                            // FID의 원래 정보 찾기 (검사 계획의 ID -> 인덱스 맵 사용)
+                            int parentFidIdx = plan->indexById.value(pattern.parentId, -1);
+                            if (parentFidIdx < 0 || patterns[parentFidIdx].type != PatternType::FID)
                             {
-                                // 부모 FID 매칭 실패
-                                result.insResults[pattern.id] = false;
-                                result.insScores[pattern.id] = 0.0;
-                                result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
-                                result.isPassed = false;
-                                continue;
+                                logDebug(QString("INS 패턴 '%1': 부모 FID 정보를 찾을 수 없음")
+                                             .arg(pattern.name));
+                                return;
                             }
-                            
-                            // FID 기반 위치 조정
-                            double fidScore = result.matchScores.value(pattern.parentId, 0.0);
-                            if (fidScore < 0.999 && result.locations.contains(pattern.parentId))
+                            const PatternInfo &parentFidInfo = patterns[parentFidIdx];
+                            QPoint originalFidCenter(
+                                static_cast<int>(parentFidInfo.rect.center().x()),
+                                static_cast<int>(parentFidInfo.rect.center().y()));
+                            parentFidTeachingAngle = parentFidInfo.angle; // 원본 티칭 각도 사용
+
+                            // 부모 FID의 위치와 각도 정보를 저장
+                            parentOffset = cv::Point(
+                                fidLoc.x - originalFidCenter.x(),
+                                fidLoc.y - originalFidCenter.y());
+
+                            // **중요**: INS 패턴의 회전 각도는 티칭 각도 + FID 회전 차이
+                            // FID 티칭 각도와 검출 각도의 차이를 INS 패턴에 적용
+                            double fidAngleDiff = fidAngle - parentFidTeachingAngle;
+                            parentAngle = insAngle + fidAngleDiff;
+                            hasParentInfo = true;
+
+                            // ===== 패턴 매칭 (Fine Alignment) 디버그 =====
+                            // ===== 패턴 매칭 (Fine Alignment) 수행 =====
+                            if (pattern.patternMatchEnabled && !pattern.matchTemplate.isNull())
                             {
-                                cv::Point fidLoc = result.locations[pattern.parentId];
-                                double fidAngle = result.angles[pattern.parentId];
+                                // 1. Coarse Alignment: FID 기반 대략 위치
+                                cv::Point coarseCenter(fidLoc.x, fidLoc.y);
+                                double coarseAngle = fidAngle;
+
+                                // 2. Fine Alignment: 부모 ROI 전체 영역에서 패턴 매칭
+                                cv::Rect searchROI;
                                 
-                                // FID 원래 정보 찾기
-                                QPoint originalFidCenter;
-                                for (const PatternInfo &fid : fidPatterns)
-                                {
-                                    if (fid.id == pattern.parentId)
-                                    {
-                                        originalFidCenter = QPoint(
-                                            static_cast<int>(fid.rect.center().x()),
-                                            static_cast<int>(fid.rect.center().y()));
-                                        break;
-                                    }
+                                // 부모 ROI (검사 계획에서 미리 찾아둔 첫 번째 ROI)
+                                if (plan->searchRoiIndex >= 0) {
+                                    const PatternInfo& p = patterns[plan->searchRoiIndex];
+                                    searchROI = cv::Rect(
+                                        static_cast<int>(p.rect.x()),
+                                        static_cast<int>(p.rect.y()),
+                                        static_cast<int>(p.rect.width()),
+                                        static_cast<int>(p.rect.height())
+                                    );
                                 }
                                 
-                                // 위치 오프셋 계산
-                                cv::Point parentOffset(
-                                    fidLoc.x - originalFidCenter.x(),
-                                    fidLoc.y - originalFidCenter.y());
-                                
-                                // 회전 각도 차이 계산
-                                double parentFidTeachingAngle = 0.0;
-                                for (const PatternInfo &p : patterns)
+                                // ROI를 못 찾으면 전체 이미지 사용
+                                if (searchROI.area() == 0) {
+                                    searchROI = cv::Rect(0, 0, image.cols, image.rows);
+                                }
+
+                                // 캐시된 매칭용 템플릿 (BGR + 마스크)
+                                auto matchTmpl = acquireTemplate(pattern, TemplateUsage::Matching);
+                                cv::Mat templateMat = matchTmpl ? matchTmpl->bgr : cv::Mat();
+
+                                if (templateMat.empty())
+                                {
+                                    // 변환 실패
+                                }
+                                else
                                 {
-                                    if (p.id == pattern.parentId)
+                                    // ★ 회전 범위와 마스크 (FID 기반도 마스크 지원)
+                                    const RotationSearch search = rotationSearchFor(pattern, *matchTmpl);
+                                    
+                                    // 검색 영역 추출 (프레임 공용 흑백 평면에서 복사 없이)
+                                    cv::Mat searchRegion = frame.grayRegion(searchROI);
+
+                                    // 패턴 매칭 수행 (FID와 동일한 함수 사용)
+                                    cv::Point matchLoc;
+                                    cv::Point2f matchSubPixelLoc(-1.0f, -1.0f);
+                                    double matchScore = 0.0;
+                                    double matchAngle = coarseAngle;
+
+                                    bool matched = performTemplateMatching(
+                                        searchRegion,
+                                        templateMat,
+                                        matchLoc,
+                                        matchScore,
+                                        matchAngle,
+                                        pattern,
+                                        search.minAngle,
+                                        search.maxAngle,
+                                        search.angleStep,
+                                        search.mask,  // ★ 마스크 전달
+                                        &matchSubPixelLoc
+                                    );
+
+                                    if (matched && (matchScore * 100.0) >= pattern.patternMatchThreshold)
                                     {
-                                        parentFidTeachingAngle = p.angle;
-                                        break;
+                                        // 패턴 매칭 성공 - Fine 위치/각도로 업데이트
+                                        int fineX = searchROI.x + matchLoc.x;
+                                        int fineY = searchROI.y + matchLoc.y;
+                                        
+                                        fidLoc.x = fineX;
+                                        fidLoc.y = fineY;
+                                        fidLocPrecise = matchSubPixelLoc.x >= 0.0f
+                                            ? cv::Point2f(searchROI.x + matchSubPixelLoc.x, searchROI.y + matchSubPixelLoc.y)
+                                            : cv::Point2f(fineX, fineY);
+                                        parentAngle = matchAngle;
+
+                                        // 오프셋 재계산
+                                        parentOffset = cv::Point(
+                                            fidLoc.x - originalFidCenter.x(),
+                                            fidLoc.y - originalFidCenter.y()
+                                        );
+                                    }
+                                    else
+                                    {
+                                        // 매칭 실패 - Coarse 위치 사용
                                     }
                                 }
-                                double fidAngleDiff = fidAngle - parentFidTeachingAngle;
-                                
-                                // INS 패턴 중심점 계산
-                                QPointF insOriginalCenter = pattern.rect.center();
-                                QPointF relativePos(
-                                    insOriginalCenter.x() - originalFidCenter.x(),
-                                    insOriginalCenter.y() - originalFidCenter.y());
-                                
-                                // 회전 적용
-                                double rad = fidAngleDiff * M_PI / 180.0;
-                                double rotatedX = relativePos.x() * cos(rad) - relativePos.y() * sin(rad);
-                                double rotatedY = relativePos.x() * sin(rad) + relativePos.y() * cos(rad);
-                                
-                                // 새로운 중심점 계산
-                                int newCenterX = static_cast<int>(std::lround(fidLoc.x + rotatedX));
-                                int newCenterY = static_cast<int>(std::lround(fidLoc.y + rotatedY));
-                                
-                                adjustedRect = QRect(
-                                    newCenterX - pattern.rect.width() / 2,
-                                    newCenterY - pattern.rect.height() / 2,
-                                    pattern.rect.width(),
-                                    pattern.rect.height());
                             }
+
+                            // 부모 FID 위치에 따른 검사 영역 조정 구현
+                            // 1. 티칭 시점의 FID/INS 중심을 부동소수점으로 사용하여 상대 벡터 계산
+                            QPointF fidTeachingCenterF = parentFidInfo.rect.center();
+                            QPointF insTeachingCenterF = pattern.rect.center();
+                            double relX = insTeachingCenterF.x() - fidTeachingCenterF.x();
+                            double relY = insTeachingCenterF.y() - fidTeachingCenterF.y();
+
+                            // 2. 각도 차이 계산 (FID 검출 각도 - FID 티칭 각도)
+                            double angleDiff = fidAngle - parentFidTeachingAngle;
+                            double radians = angleDiff * M_PI / 180.0;
+
+                            // 3. 상대 벡터를 각도만큼 회전 (부동소수점 정밀도 유지)
+                            // 이미지 좌표계(Y 증가 방향이 아래)를 고려해 회전 방향을 반전
+                            double cosA = std::cos(radians);
+                            double sinA = std::sin(radians);
+                            // 회전 부호를 반대로 하여 화면에서 기대하는 회전 방향으로 맞춤
+                            double rotatedX = relX * cosA + relY * sinA; // using -radians
+                            double rotatedY = -relX * sinA + relY * cosA;
+
+                            // 4. FID 검출 위치(서브픽셀 좌표) + 회전된 상대 벡터 = INS 새 중심 (부동소수점)
+                            double newCenterX_d = static_cast<double>(fidLocPrecise.x) + rotatedX;
+                            double newCenterY_d = static_cast<double>(fidLocPrecise.y) + rotatedY;
+
+                            // 정수 좌표로 반올림하여 QRect 계산
+                            int newCenterX = static_cast<int>(std::lround(newCenterX_d));
+                            int newCenterY = static_cast<int>(std::lround(newCenterY_d));
+
+                            int width = pattern.rect.width();
+                            int height = pattern.rect.height();
+
+                            // 중심점 기준으로 새로운 조정된 검사 영역 계산
+                            adjustedRect = QRect(
+                                newCenterX - width / 2,  // 회전된 새 x 좌표
+                                newCenterY - height / 2, // 회전된 새 y 좌표
+                                width,                   // 너비 동일
+                                height                   // 높이 동일
+                            );
                         }
                     }
-                    
-                    // ROI 유효성 검사 제거: INS 패턴은 ROI 영역 밖에서도 검사
-                    // (ROI는 FID 매칭 영역만 제한하는 용도)
-                    
-                    // 경계 조정
-                    if (adjustedRect.x() < 0 || adjustedRect.y() < 0 ||
-                        adjustedRect.x() + adjustedRect.width() > image.cols ||
-                        adjustedRect.y() + adjustedRect.height() > image.rows) {
-                        int x = std::max(0, adjustedRect.x());
-                        int y = std::max(0, adjustedRect.y());
-                        int width = std::min(image.cols - x, adjustedRect.width());
-                        int height = std::min(image.rows - y, adjustedRect.height());
-                        if (width < 10 || height < 10) {
-                            result.insResults[pattern.id] = false;
-                            result.insScores[pattern.id] = 0.0;
-                            result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
-                            result.isPassed = false;
-                            continue;
-                        }
-                        adjustedRect = QRect(x, y, width, height);
-                    }
-                    
-                    cv::Rect roiRect(adjustedRect.x(), adjustedRect.y(), adjustedRect.width(), adjustedRect.height());
-                    cv::Mat roiImage = image(roiRect).clone();
-                    
-                    roiImages.push_back(roiImage);
-                    validPatterns.append(pattern);
-                    result.adjustedRects[pattern.id] = adjustedRect;
                 }
-                
-                if (!roiImages.empty()) {
-                    modelImages[modelPath] = roiImages;
-                    modelValidPatterns[modelPath] = validPatterns;
+            }
+
+            // INS 패턴은 ROI 체크를 하지 않음 (전체 이미지에서 검사)
+            QPoint adjustedCenter = adjustedRect.center();
+
+            // 조정된 영역이 이미지 경계를 벗어나는지 확인
+            if (adjustedRect.x() < 0 || adjustedRect.y() < 0 ||
+                adjustedRect.x() + adjustedRect.width() > image.cols ||
+                adjustedRect.y() + adjustedRect.height() > image.rows)
+            {
+
+                logDebug(QString("INS 패턴 '%1': 조정된 영역이 이미지 경계를 벗어남, 영역 조정").arg(pattern.name));
+
+                // 이미지 경계 내로 영역 조정
+                int x = std::max(0, adjustedRect.x());
+                int y = std::max(0, adjustedRect.y());
+                int width = std::min(image.cols - x, adjustedRect.width());
+                int height = std::min(image.rows - y, adjustedRect.height());
+
+                // 조정된 영역이 너무 작으면 검사 실패
+                if (width < 10 || height < 10)
+                {
+                    logDebug(QString("INS 패턴 '%1': 조정된 영역이 너무 작음, 검사 실패").arg(pattern.name));
+                    slot.insResults[pattern.id] = false;
+                    slot.insScores[pattern.id] = 0.0;
+                    if (hasParentInfo)
+                    {
+                        slot.parentOffsets[pattern.id] = parentOffset;
+                        slot.parentAngles[pattern.id] = parentAngle;
+                    }
+                    slot.isPassed = false;
+                    return;
                 }
+
+                // 유효한 영역으로 조정
+                adjustedRect = QRect(x, y, width, height);
+                logDebug(QString("INS 패턴 '%1': 영역 조정됨 - (%2,%3,%4,%5)")
+                             .arg(pattern.name)
+                             .arg(adjustedRect.x())
+                             .arg(adjustedRect.y())
+                             .arg(adjustedRect.width())
+                             .arg(adjustedRect.height()));
             }
+
+            double inspScore = 0.0;
+            bool inspPassed = false;
+
+            // 검사 방법에 따른 분기 - 패턴 복제하여 조정된 영역으로 설정
+            PatternInfo adjustedPattern = pattern;
+            adjustedPattern.rect = adjustedRect;
+
+            // 최종 계산된 각도 설정 (INS 원본 각도 + FID 회전 차이)
+
+            if (hasParentInfo)
+            {
+                // FID 회전 차이만큼 INS 원본 각도에 추가
+                double fidAngleDiff = parentAngle - parentFidTeachingAngle;
+                adjustedPattern.angle = insAngle + fidAngleDiff; // INS 원본 각도 + FID 회전 차이
+            }
+            else
+            {
+                adjustedPattern.angle = insAngle; // 패턴 각도만
+            }
+
+            // 검사 시간 측정
+            InspectionTraceScope insTrace(frame.traceId(), "INS", pattern.name);
+            auto insStart = std::chrono::high_resolution_clock::now();
             
-            // 멀티모델 병렬 추론 실행
-            QMap<QString, std::vector<float>> modelScores;
-            QMap<QString, std::vector<cv::Mat>> modelMaps;
-            
-            auto inferenceStart = std::chrono::high_resolution_clock::now();
-            bool multiSuccess = ImageProcessor::runPatchCoreTensorRTMultiModelInference(
-                modelImages, modelScores, modelMaps);
-            auto inferenceEnd = std::chrono::high_resolution_clock::now();
-            auto inferenceDuration = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
+            switch (pattern.inspectionMethod)
+            {
+            case InspectionMethod::DIFF:
+                inspPassed = checkDiff(frame, adjustedPattern, inspScore, slot);
+                logDebug(QString("DIFF 검사 수행: %1 (method=%2)").arg(pattern.name).arg(pattern.inspectionMethod));
+                break;
+
+            case InspectionMethod::STRIP:
+            {
+                // 디버그: STRIP 검사 직전 각도 확인
+
+                inspPassed = checkStrip(frame, adjustedPattern, inspScore, slot, patterns);
+
+                break;
+            }
+
+            case InspectionMethod::CRIMP:
+            {
+                inspPassed = checkCrimp(frame, adjustedPattern, inspScore, slot, patterns);
+                break;
+            }
+
+            case InspectionMethod::SSIM:
+            {
+                inspPassed = checkSSIM(frame, adjustedPattern, inspScore, slot);
+                break;
+            }
+
+            case InspectionMethod::A_PC:
+            case InspectionMethod::A_PD:
+                // A-PC와 A-PD는 ANOMALY 배치에서 처리됨 (검사 계획의 insOrder에 포함되지 않음)
+                return;
+
+            default:
+                // 이전 PATTERN 타입은 DIFF로 처리
+                inspPassed = checkDiff(frame, adjustedPattern, inspScore, slot);
+                logDebug(QString("알 수 없는 검사 방법 %1, DIFF 검사로 수행: %2")
+                             .arg(pattern.inspectionMethod)
+                             .arg(pattern.name));
+                break;
+            }
             
-            // 전체 패턴 수 계산
-            int totalPatterns = 0;
-            for (auto it = modelValidPatterns.begin(); it != modelValidPatterns.end(); ++it) {
-                totalPatterns += it.value().size();
+            // 검사 시간 종료
+            auto insEnd = std::chrono::high_resolution_clock::now();
+            auto insDuration = std::chrono::duration_cast<std::chrono::milliseconds>(insEnd - insStart).count();
+
+            // 결과 기록
+            slot.insResults[pattern.id] = inspPassed;
+            slot.patternTimesUs[pattern.id] = std::chrono::duration_cast<std::chrono::microseconds>(insEnd - insStart).count();
+            slot.insScores[pattern.id] = inspScore;
+            slot.adjustedRects[pattern.id] = adjustedRect;
+
+            // 부모 FID 위치 정보가 있으면 저장
+            if (hasParentInfo)
+            {
+                slot.parentOffsets[pattern.id] = parentOffset;
+                slot.parentAngles[pattern.id] = parentAngle;
             }
-            int avgPatternTime = (totalPatterns > 0) ? (inferenceDuration / totalPatterns) : 0;
+            else
+            {
+                // 그룹화되지 않은 INS 패턴은 티칭한 각도 그대로 사용
+                slot.parentAngles[pattern.id] = insAngle;
+            }
+
+            // INS 검사 결과 로그 (개별 출력)
+            QString insResultText;
+            if (parentFid && !parentFid->matched)
+            {
+                // 부모 FID 매칭 실패로 검사 불가
+                insResultText = "FAIL";
+            }
+            else if (inspPassed)
+            {
+                insResultText = "PASS";
+            }
+            else
+            {
+                insResultText = "NG";
+            }
+
+            // HTML 색상 태그 (Qt 로그용)
+            QString colorGreen = "<font color='#8BCB8B'>";    // 연한 초록색 (INS 패턴)
+            QString colorPass = "<font color='#00FF00'>";     // 초록색 (PASS)
+            QString colorNG = "<font color='#FF0000'>";       // 빨간색 (NG, FAIL)
+            QString colorEnd = "</font>";                      // 색상 종료
             
-            if (multiSuccess) {
-                // 결과 처리 (기존 로직과 동일)
-                for (auto it = modelValidPatterns.begin(); it != modelValidPatterns.end(); ++it) {
-                    const QString& modelPath = it.key();
-                    const QList<PatternInfo>& validPatterns = it.value();
-                    
-                    if (!modelScores.contains(modelPath) || !modelMaps.contains(modelPath)) {
-                        continue;
+            // 결과 색상 선택
+            QString resultColor = inspPassed ? colorPass : colorNG;
+
+            // 검사 방법별 결과 포맷팅
+            QString resultDetail;
+            if (pattern.inspectionMethod == InspectionMethod::A_PC ||
+                pattern.inspectionMethod == InspectionMethod::A_PD)
+            {
+                // A-PC/A-PD: 불량 개수 및 최대 W/H 표시
+                QString methodName = InspectionMethod::getName(pattern.inspectionMethod);
+                int defectCount = slot.anomalyDefectContours.value(pattern.id).size();
+                if (defectCount > 0) {
+                    // 최대 컨투어 W/H 찾기
+                    int maxW = 0, maxH = 0;
+                    for (const auto& contour : slot.anomalyDefectContours.value(pattern.id)) {
+                        cv::Rect bbox = cv::boundingRect(contour);
+                        if (bbox.width > maxW) maxW = bbox.width;
+                        if (bbox.height > maxH) maxH = bbox.height;
                     }
+                    resultDetail = QString("  └─ %1%2(%3)%4: W:%5 H:%6 Detects:%7 (%8ms)")
+                                       .arg(colorGreen).arg(pattern.name)
+                                       .arg(methodName).arg(colorEnd)
+                                       .arg(maxW)
+                                       .arg(maxH)
+                                       .arg(defectCount)
+                                       .arg(insDuration);
+                } else {
+                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
+                                       .arg(colorGreen).arg(pattern.name)
+                                       .arg(methodName).arg(colorEnd)
+                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                       .arg(insDuration);
+                }
+            }
+            else if (pattern.inspectionMethod == InspectionMethod::STRIP)
+            {
+                // STRIP: 세부 결과 한 줄로
+                QStringList stripDetails;
+                
+                // gradient points 부족으로 검사 실패한 경우 (score = 0.0)
+                if (inspScore == 0.0 && !slot.stripPointsValid.value(pattern.id, false)) {
+                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (insufficient gradient points) (%8ms)")
+                                       .arg(colorGreen).arg(pattern.name)
+                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                       .arg(insDuration);
+                } else {
+                    if (slot.frontResult != "PASS") stripDetails << QString("FRONT:%1").arg(slot.frontDetail);
+                    if (slot.rearResult != "PASS") stripDetails << QString("REAR:%1").arg(slot.rearDetail);
+                    if (slot.edgeResult != "PASS") stripDetails << QString("EDGE:%1").arg(slot.edgeDetail);
                     
-                    const std::vector<float>& anomalyScores = modelScores[modelPath];
-                    const std::vector<cv::Mat>& anomalyMaps = modelMaps[modelPath];
-                    
-                    for (int i = 0; i < validPatterns.size(); i++) {
-                        const PatternInfo& pattern = validPatterns[i];
-                        
+                    if (stripDetails.isEmpty()) {
+                        resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
+                                           .arg(colorGreen).arg(pattern.name)
+                                           .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                           .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                           .arg(insDuration);
+                    } else {
+                        resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8) (%9ms)")
+                                           .arg(colorGreen).arg(pattern.name)
+                                           .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                           .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                           .arg(stripDetails.join(", "))
+                                           .arg(insDuration);
+                    }
+                }
+            }
+            else if (pattern.inspectionMethod == InspectionMethod::CRIMP)
+            {
+                // CRIMP: YOLO 검출 정보
+                bool crimpLeft = slot.barrelLeftResults.value(pattern.id, false);
+                bool crimpRight = slot.barrelRightResults.value(pattern.id, false);
+                
+                QStringList crimpDetails;
+                if (!crimpLeft) crimpDetails << "L:FAIL";
+                if (!crimpRight) crimpDetails << "R:FAIL";
+                
+                if (crimpDetails.isEmpty()) {
+                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
+                                       .arg(colorGreen).arg(pattern.name)
+                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                       .arg(insDuration);
+                } else {
+                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8) (%9ms)")
+                                       .arg(colorGreen).arg(pattern.name)
+                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                       .arg(crimpDetails.join(", "))
+                                       .arg(insDuration);
+                }
+            }
+            else
+            {
+                // 기본 형식 (DIFF, SSIM 등)
+                resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
+                                   .arg(colorGreen).arg(pattern.name)
+                                   .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
+                                   .arg(resultColor).arg(insResultText).arg(colorEnd)
+                                   .arg(insDuration);
+            }
+            
+            summary = resultDetail;
+
+            // 패턴 결과 갱신 (전체 결과는 병합 단계에서 반영)
+            slot.isPassed = slot.isPassed && inspPassed;
+        };
+
+        const int insPatternCount = plan->insOrder.size();
+        QVector<InspectionResult> insSlots(insPatternCount);
+        QVector<QString> insSummaries(insPatternCount);
+        for (InspectionResult &slot : insSlots) {
+            slot.isPassed = true;
+        }
+
+        // 다음에 처리할 INS 순번 (놀고 있는 스레드가 하나씩 가져감)
+        std::atomic<int> nextInsOrder{0};
+        auto drainInsPatterns = [&]() {
+            for (int order = nextInsOrder.fetch_add(1); order < insPatternCount; order = nextInsOrder.fetch_add(1)) {
+                try {
+                    runInsPattern(plan->insOrder[order], insSlots[order], insSummaries[order]);
+                } catch (const std::exception& e) {
+                    // 풀 스레드 밖으로 예외가 나가지 않도록 해당 패턴만 NG 처리
+                    const PatternInfo &failed = patterns[plan->insOrder[order]];
+                    insSlots[order].insResults[failed.id] = false;
+                    insSlots[order].insScores[failed.id] = 0.0;
+                    insSlots[order].isPassed = false;
+                    insSummaries[order] = QString("INS 패턴 '%1': 검사 중 예외 발생 - %2").arg(failed.name).arg(e.what());
+                } catch (...) {
+                    const PatternInfo &failed = patterns[plan->insOrder[order]];
+                    insSlots[order].insResults[failed.id] = false;
+                    insSlots[order].insScores[failed.id] = 0.0;
+                    insSlots[order].isPassed = false;
+                    insSummaries[order] = QString("INS 패턴 '%1': 검사 중 알 수 없는 예외 발생").arg(failed.name);
+                }
+            }
+        };
+
+        int insHelpers = 0;
+        QSemaphore insHelpersDone;
+        if (parallelEnabled)
+        {
+            // 비어 있는 풀 스레드만 사용 (다른 프레임 검사가 풀을 점유 중이면 현재 스레드가 나머지 처리)
+            // 현재 스레드는 ANOMALY 배치를 먼저 처리하므로 INS 패턴 수만큼 띄운다.
+            for (int i = 0; i < insPatternCount; i++) {
+                if (!insThreadPool.tryStart([&]() {
+                        auto releaseHelper = qScopeGuard([&insHelpersDone]() { insHelpersDone.release(); });
+                        drainInsPatterns();
+                    })) {
+                    break;
+                }
+                insHelpers++;
+            }
+        }
+
+        // ANOMALY 배치/FID 기록에서 예외가 나도 INS 작업이 지역 변수를 쓰는 동안 빠져나가지 않도록 대기
+        // (남은 INS 순번은 건너뛰게 해서 바로 끝나도록 한다)
+        auto joinInsHelpers = qScopeGuard([&]() {
+            if (insHelpers > 0) {
+                nextInsOrder.store(insPatternCount);
+                insHelpersDone.acquire(insHelpers);
+                insHelpers = 0;
+            }
+        });
+
+        // ANOMALY 배치는 자기 부모 FID 결과만 필요 (나머지 FID는 계속 병렬 매칭)
+        for (int fidSlot : plan->anomalyFidSlots)
+            commitFid(fidSlot);
+
+        // ===== ANOMALY 패턴 배치 처리 =====
+        // 같은 모델을 사용하는 ANOMALY 패턴들의 그룹 (검사 계획에서 모델 경로별로 미리 분류됨)
+        const QMap<QString, QList<int>> &anomalyGroupsAPC = plan->anomalyGroupsAPC; // key: 모델 경로 (A-PC)
+        const QMap<QString, QList<int>> &anomalyGroupsAPD = plan->anomalyGroupsAPD; // key: 모델 경로 (A-PD)
+        int totalAnomalyCount = plan->anomalyCount;
+        
+        // ANOMALY 전체 처리 시작
+        auto anomalyBatchStart = std::chrono::high_resolution_clock::now();
+        const qint64 anomalyTraceStart = InspectionTracer::nowUs();
+        int anomalyGroupCount = anomalyGroupsAPC.size() + anomalyGroupsAPD.size();
+        
+        // 변수 선언을 ifdef 밖에서 (밖에서 사용하기 위해)
+        auto apcBatchStart = std::chrono::high_resolution_clock::now();
+        int apcPatternCount = 0;
+        auto apdBatchStart = std::chrono::high_resolution_clock::now();
+        int apdPatternCount = 0;
+        
+#ifdef USE_TENSORRT
+        // ===== A-PC TensorRT 멀티모델 병렬 처리 =====
+        if (anomalyGroupsAPC.size() >= 1) {
+            // 모든 모델 로드
+            QMap<QString, std::vector<cv::Mat>> modelImages;
+            QMap<QString, QList<PatternInfo>> modelValidPatterns;
+            
+            int loadedModelCount = 0;
+            for (auto groupIt = anomalyGroupsAPC.begin(); groupIt != anomalyGroupsAPC.end(); ++groupIt) {
+                const QString& modelPath = groupIt.key();
+                const QList<int>& group = groupIt.value();
+                
+                if (group.isEmpty()) continue;
+                
+                // 모델 로드
+                if (!initPatchCoreModel(modelPath)) {
+                    logDebug(QString("ANOMALY: 모델 로드 실패 - %1").arg(modelPath));
+                    for (int patternIdx : group) {
+                        const PatternInfo& pattern = patterns[patternIdx];
+                        result.insResults[pattern.id] = false;
+                        result.insScores[pattern.id] = 0.0;
+                        result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
+                        result.isPassed = false;
+                    }
+                    continue;
+                }
+                loadedModelCount++;
+                
+                std::vector<cv::Mat> roiImages;
+                QList<PatternInfo> validPatterns;
+                
+                // ROI 추출 (기존 로직과 동일)
+                for (int patternIdx : group) {
+                    const PatternInfo& pattern = patterns[patternIdx];
+                    QRect adjustedRect = QRect(
+                        static_cast<int>(pattern.rect.x()),
+                        static_cast<int>(pattern.rect.y()),
+                        static_cast<int>(pattern.rect.width()),
+                        static_cast<int>(pattern.rect.height()));
+                    
+                    // 부모 FID 정보 확인 및 위치 조정
+                    if (!pattern.parentId.isNull())
+                    {
+                        if (result.fidResults.contains(pattern.parentId))
+                        {
+                            if (!result.fidResults[pattern.parentId])
+                            {
+                                // 부모 FID 매칭 실패
+                                result.insResults[pattern.id] = false;
+                                result.insScores[pattern.id] = 0.0;
+                                result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
+                                result.isPassed = false;
+                                continue;
+                            }
+                            
+                            // FID 기반 위치 조정
+                            double fidScore = result.matchScores.value(pattern.parentId, 0.0);
+                            if (fidScore < 0.999 && result.locations.contains(pattern.parentId))
+                            {
+                                cv::Point fidLoc = result.locations[pattern.parentId];
+                                double fidAngle = result.angles[pattern.parentId];
+                                
+                                // FID 원래 정보 찾기
+                                const PatternInfo &parentFid = patterns[plan->indexById.value(pattern.parentId)];
+                                QPoint originalFidCenter(
+                                    static_cast<int>(parentFid.rect.center().x()),
+                                    static_cast<int>(parentFid.rect.center().y()));
+                                
+                                // 위치 오프셋 계산
+                                cv::Point parentOffset(
+                                    fidLoc.x - originalFidCenter.x(),
+                                    fidLoc.y - originalFidCenter.y());
+                                
+                                // 회전 각도 차이 계산
+                                double parentFidTeachingAngle = parentFid.angle;
+                                double fidAngleDiff = fidAngle - parentFidTeachingAngle;
+                                
+                                // INS 패턴 중심점 계산
+                                QPointF insOriginalCenter = pattern.rect.center();
+                                QPointF relativePos(
+                                    insOriginalCenter.x() - originalFidCenter.x(),
+                                    insOriginalCenter.y() - originalFidCenter.y());
+                                
+                                // 회전 적용
+                                double rad = fidAngleDiff * M_PI / 180.0;
+                                double rotatedX = relativePos.x() * cos(rad) - relativePos.y() * sin(rad);
+                                double rotatedY = relativePos.x() * sin(rad) + relativePos.y() * cos(rad);
+                                
+                                // 새로운 중심점 계산
+                                int newCenterX = static_cast<int>(std::lround(fidLoc.x + rotatedX));
+                                int newCenterY = static_cast<int>(std::lround(fidLoc.y + rotatedY));
+                                
+                                adjustedRect = QRect(
+                                    newCenterX - pattern.rect.width() / 2,
+                                    newCenterY - pattern.rect.height() / 2,
+                                    pattern.rect.width(),
+                                    pattern.rect.height());
+                            }
+                        }
+                    }
+                    
+                    // ROI 유효성 검사 제거: INS 패턴은 ROI 영역 밖에서도 검사
+                    // (ROI는 FID 매칭 영역만 제한하는 용도)
+                    
+                    // 경계 조정
+                    if (adjustedRect.x() < 0 || adjustedRect.y() < 0 ||
+                        adjustedRect.x() + adjustedRect.width() > image.cols ||
+                        adjustedRect.y() + adjustedRect.height() > image.rows) {
+                        int x = std::max(0, adjustedRect.x());
+                        int y = std::max(0, adjustedRect.y());
+                        int width = std::min(image.cols - x, adjustedRect.width());
+                        int height = std::min(image.rows - y, adjustedRect.height());
+                        if (width < 10 || height < 10) {
+                            result.insResults[pattern.id] = false;
+                            result.insScores[pattern.id] = 0.0;
+                            result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
+                            result.isPassed = false;
+                            continue;
+                        }
+                        adjustedRect = QRect(x, y, width, height);
+                    }
+                    
+                    cv::Rect roiRect(adjustedRect.x(), adjustedRect.y(), adjustedRect.width(), adjustedRect.height());
+                    cv::Mat roiImage = image(roiRect).clone();
+                    
+                    roiImages.push_back(roiImage);
+                    validPatterns.append(pattern);
+                    result.adjustedRects[pattern.id] = adjustedRect;
+                }
+                
+                if (!roiImages.empty()) {
+                    modelImages[modelPath] = roiImages;
+                    modelValidPatterns[modelPath] = validPatterns;
+                }
+            }
+            
+            // 멀티모델 병렬 추론 실행
+            QMap<QString, std::vector<float>> modelScores;
+            QMap<QString, std::vector<cv::Mat>> modelMaps;
+            
+            auto inferenceStart = std::chrono::high_resolution_clock::now();
+            const qint64 inferenceTraceStart = InspectionTracer::nowUs();
+            bool multiSuccess = ImageProcessor::runPatchCoreTensorRTMultiModelInference(
+                modelImages, modelScores, modelMaps);
+            auto inferenceEnd = std::chrono::high_resolution_clock::now();
+            InspectionTracer::instance().addSpan(frame.traceId(), "ANOMALY", QStringLiteral("PatchCore TensorRT 추론"),
+                                                 inferenceTraceStart, InspectionTracer::nowUs());
+            auto inferenceDuration = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
+            
+            // 전체 패턴 수 계산
+            int totalPatterns = 0;
+            for (auto it = modelValidPatterns.begin(); it != modelValidPatterns.end(); ++it) {
+                totalPatterns += it.value().size();
+            }
+            int avgPatternTime = (totalPatterns > 0) ? (inferenceDuration / totalPatterns) : 0;
+            // 배치 추론이므로 패턴별 시간은 전체 추론 시간을 패턴 수로 나눈 값
+            const qint64 avgPatternUs = (totalPatterns > 0)
+                ? std::chrono::duration_cast<std::chrono::microseconds>(inferenceEnd - inferenceStart).count() / totalPatterns : 0;
+            
+            if (multiSuccess) {
+                // 결과 처리 (기존 로직과 동일)
+                for (auto it = modelValidPatterns.begin(); it != modelValidPatterns.end(); ++it) {
+                    const QString& modelPath = it.key();
+                    const QList<PatternInfo>& validPatterns = it.value();
+                    
+                    if (!modelScores.contains(modelPath) || !modelMaps.contains(modelPath)) {
+                        continue;
+                    }
+                    
+                    const std::vector<float>& anomalyScores = modelScores[modelPath];
+                    const std::vector<cv::Mat>& anomalyMaps = modelMaps[modelPath];
+                    
+                    for (int i = 0; i < validPatterns.size(); i++) {
+                        const PatternInfo& pattern = validPatterns[i];
+                        
                         if (i >= anomalyScores.size() || i >= anomalyMaps.size()) {
                             break;
                         }
@@ -686,6 +2395,7 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                         result.insScores[pattern.id] = static_cast<double>(roiAnomalyScore);
                         result.insResults[pattern.id] = !hasDefect;
                         result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
+                        result.patternTimesUs[pattern.id] = avgPatternUs;
                         result.anomalyDefectContours[pattern.id] = defectContours;
                         result.anomalyRawMap[pattern.id] = anomalyMap.clone();
                         
@@ -739,14 +2449,15 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
             int loadedModelCount = 0;
             for (auto groupIt = anomalyGroupsAPD.begin(); groupIt != anomalyGroupsAPD.end(); ++groupIt) {
                 const QString& modelPath = groupIt.key();
-                const QList<PatternInfo>& group = groupIt.value();
+                const QList<int>& group = groupIt.value();
                 
                 if (group.isEmpty()) continue;
                 
                 // PaDiM 모델 로드
                 if (!ImageProcessor::initPaDiMTensorRT(modelPath)) {
                     logDebug(QString("A-PD: 모델 로드 실패 - %1").arg(modelPath));
-                    for (const PatternInfo& pattern : group) {
+                    for (int patternIdx : group) {
+                        const PatternInfo& pattern = patterns[patternIdx];
                         result.insResults[pattern.id] = false;
                         result.insScores[pattern.id] = 0.0;
                         result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
@@ -760,7 +2471,8 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                 QList<PatternInfo> validPatterns;
                 
                 // ROI 추출 (A-PC와 동일한 로직)
-                for (const PatternInfo &pattern : group) {
+                for (int patternIdx : group) {
+                    const PatternInfo& pattern = patterns[patternIdx];
                     QRect adjustedRect = QRect(
                         static_cast<int>(pattern.rect.x()),
                         static_cast<int>(pattern.rect.y()),
@@ -790,17 +2502,10 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                                 double fidAngle = result.angles[pattern.parentId];
                                 
                                 // FID 원래 정보 찾기
-                                QPoint originalFidCenter;
-                                for (const PatternInfo &fid : fidPatterns)
-                                {
-                                    if (fid.id == pattern.parentId)
-                                    {
-                                        originalFidCenter = QPoint(
-                                            static_cast<int>(fid.rect.center().x()),
-                                            static_cast<int>(fid.rect.center().y()));
-                                        break;
-                                    }
-                                }
+                                const PatternInfo &parentFid = patterns[plan->indexById.value(pattern.parentId)];
+                                QPoint originalFidCenter(
+                                    static_cast<int>(parentFid.rect.center().x()),
+                                    static_cast<int>(parentFid.rect.center().y()));
                                 
                                 // 위치 오프셋 계산
                                 cv::Point parentOffset(
@@ -808,15 +2513,7 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                                     fidLoc.y - originalFidCenter.y());
                                 
                                 // 회전 각도 차이 계산
-                                double parentFidTeachingAngle = 0.0;
-                                for (const PatternInfo &p : patterns)
-                                {
-                                    if (p.id == pattern.parentId)
-                                    {
-                                        parentFidTeachingAngle = p.angle;
-                                        break;
-                                    }
-                                }
+                                double parentFidTeachingAngle = parentFid.angle;
                                 double fidAngleDiff = fidAngle - parentFidTeachingAngle;
                                 
                                 // INS 패턴 중심점 계산
@@ -880,9 +2577,12 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
             QMap<QString, std::vector<cv::Mat>> modelMaps;
             
             auto inferenceStart = std::chrono::high_resolution_clock::now();
+            const qint64 inferenceTraceStart = InspectionTracer::nowUs();
             bool multiSuccess = ImageProcessor::runPaDiMTensorRTMultiModelInference(
                 modelImages, modelScores, modelMaps);
             auto inferenceEnd = std::chrono::high_resolution_clock::now();
+            InspectionTracer::instance().addSpan(frame.traceId(), "ANOMALY", QStringLiteral("PaDiM TensorRT 추론"),
+                                                 inferenceTraceStart, InspectionTracer::nowUs());
             auto inferenceDuration = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
             
             // 전체 패턴 수 계산
@@ -891,6 +2591,9 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                 totalPatterns += it.value().size();
             }
             int avgPatternTime = (totalPatterns > 0) ? (inferenceDuration / totalPatterns) : 0;
+            // 배치 추론이므로 패턴별 시간은 전체 추론 시간을 패턴 수로 나눈 값
+            const qint64 avgPatternUs = (totalPatterns > 0)
+                ? std::chrono::duration_cast<std::chrono::microseconds>(inferenceEnd - inferenceStart).count() / totalPatterns : 0;
             
             if (multiSuccess) {
                 // 결과 처리
@@ -951,6 +2654,7 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                         result.insScores[pattern.id] = static_cast<double>(roiAnomalyScore);
                         result.insResults[pattern.id] = !hasDefect;
                         result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
+                        result.patternTimesUs[pattern.id] = avgPatternUs;
                         result.anomalyDefectContours[pattern.id] = defectContours;
                         result.anomalyRawMap[pattern.id] = anomalyMap.clone();
                         
@@ -997,14 +2701,15 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
         if (anomalyGroupsAPC.size() >= 1) {
             for (auto groupIt = anomalyGroupsAPC.begin(); groupIt != anomalyGroupsAPC.end(); ++groupIt) {
                 const QString& modelPath = groupIt.key();
-                const QList<PatternInfo>& group = groupIt.value();
+                const QList<int>& group = groupIt.value();
                 
                 if (group.isEmpty()) continue;
                 
                 // 모델 로드
                 if (!initPatchCoreModel(modelPath)) {
                     logDebug(QString("ANOMALY: 모델 로드 실패 - %1").arg(modelPath));
-                    for (const PatternInfo& pattern : group) {
+                    for (int patternIdx : group) {
+                        const PatternInfo& pattern = patterns[patternIdx];
                         result.insResults[pattern.id] = false;
                         result.insScores[pattern.id] = 0.0;
                         result.insMethodTypes[pattern.id] = InspectionMethod::A_PC;
@@ -1014,7 +2719,8 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                 }
                 
                 // 각 패턴별로 순차 처리
-                for (const PatternInfo &pattern : group) {
+                for (int patternIdx : group) {
+                    const PatternInfo& pattern = patterns[patternIdx];
                     QRect adjustedRect = QRect(
                         static_cast<int>(pattern.rect.x()),
                         static_cast<int>(pattern.rect.y()),
@@ -1041,31 +2747,16 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                                 cv::Point fidLoc = result.locations[pattern.parentId];
                                 double fidAngle = result.angles[pattern.parentId];
                                 
-                                QPoint originalFidCenter;
-                                for (const PatternInfo &fid : fidPatterns)
-                                {
-                                    if (fid.id == pattern.parentId)
-                                    {
-                                        originalFidCenter = QPoint(
-                                            static_cast<int>(fid.rect.center().x()),
-                                            static_cast<int>(fid.rect.center().y()));
-                                        break;
-                                    }
-                                }
+                                const PatternInfo &parentFid = patterns[plan->indexById.value(pattern.parentId)];
+                                QPoint originalFidCenter(
+                                    static_cast<int>(parentFid.rect.center().x()),
+                                    static_cast<int>(parentFid.rect.center().y()));
                                 
                                 cv::Point parentOffset(
                                     fidLoc.x - originalFidCenter.x(),
                                     fidLoc.y - originalFidCenter.y());
                                 
-                                double parentFidTeachingAngle = 0.0;
-                                for (const PatternInfo &p : patterns)
-                                {
-                                    if (p.id == pattern.parentId)
-                                    {
-                                        parentFidTeachingAngle = p.angle;
-                                        break;
-                                    }
-                                }
+                                double parentFidTeachingAngle = parentFid.angle;
                                 double fidAngleDiff = fidAngle - parentFidTeachingAngle;
                                 
                                 QPointF insOriginalCenter = pattern.rect.center();
@@ -1113,6 +2804,7 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                     
                     // ONNX 추론
                     auto inferenceStart = std::chrono::high_resolution_clock::now();
+                    const qint64 inferenceTraceStart = InspectionTracer::nowUs();
                     float anomalyScore = 0.0f;
                     cv::Mat anomalyMap;
                     
@@ -1120,7 +2812,10 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                         modelPath, roiImage, anomalyScore, anomalyMap, pattern.passThreshold);
                     
                     auto inferenceEnd = std::chrono::high_resolution_clock::now();
+                    InspectionTracer::instance().addSpan(frame.traceId(), "ANOMALY", pattern.name,
+                                                         inferenceTraceStart, InspectionTracer::nowUs());
                     auto patternTime = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
+                    result.patternTimesUs[pattern.id] = std::chrono::duration_cast<std::chrono::microseconds>(inferenceEnd - inferenceStart).count();
                     
                     if (!inferenceSuccess) {
                         result.insResults[pattern.id] = false;
@@ -1212,14 +2907,15 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
         if (anomalyGroupsAPD.size() >= 1) {
             for (auto groupIt = anomalyGroupsAPD.begin(); groupIt != anomalyGroupsAPD.end(); ++groupIt) {
                 const QString& modelPath = groupIt.key();
-                const QList<PatternInfo>& group = groupIt.value();
+                const QList<int>& group = groupIt.value();
                 
                 if (group.isEmpty()) continue;
                 
                 // PaDiM 모델 로드
                 if (!ImageProcessor::initPaDiMONNX(modelPath)) {
                     logDebug(QString("A-PD: 모델 로드 실패 - %1").arg(modelPath));
-                    for (const PatternInfo& pattern : group) {
+                    for (int patternIdx : group) {
+                        const PatternInfo& pattern = patterns[patternIdx];
                         result.insResults[pattern.id] = false;
                         result.insScores[pattern.id] = 0.0;
                         result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
@@ -1229,7 +2925,8 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                 }
                 
                 // 각 패턴별로 순차 처리
-                for (const PatternInfo &pattern : group) {
+                for (int patternIdx : group) {
+                    const PatternInfo& pattern = patterns[patternIdx];
                     QRect adjustedRect = QRect(
                         static_cast<int>(pattern.rect.x()),
                         static_cast<int>(pattern.rect.y()),
@@ -1256,31 +2953,16 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                                 cv::Point fidLoc = result.locations[pattern.parentId];
                                 double fidAngle = result.angles[pattern.parentId];
                                 
-                                QPoint originalFidCenter;
-                                for (const PatternInfo &fid : fidPatterns)
-                                {
-                                    if (fid.id == pattern.parentId)
-                                    {
-                                        originalFidCenter = QPoint(
-                                            static_cast<int>(fid.rect.center().x()),
-                                            static_cast<int>(fid.rect.center().y()));
-                                        break;
-                                    }
-                                }
+                                const PatternInfo &parentFid = patterns[plan->indexById.value(pattern.parentId)];
+                                QPoint originalFidCenter(
+                                    static_cast<int>(parentFid.rect.center().x()),
+                                    static_cast<int>(parentFid.rect.center().y()));
                                 
                                 cv::Point parentOffset(
                                     fidLoc.x - originalFidCenter.x(),
                                     fidLoc.y - originalFidCenter.y());
                                 
-                                double parentFidTeachingAngle = 0.0;
-                                for (const PatternInfo &p : patterns)
-                                {
-                                    if (p.id == pattern.parentId)
-                                    {
-                                        parentFidTeachingAngle = p.angle;
-                                        break;
-                                    }
-                                }
+                                double parentFidTeachingAngle = parentFid.angle;
                                 double fidAngleDiff = fidAngle - parentFidTeachingAngle;
                                 
                                 QPointF insOriginalCenter = pattern.rect.center();
@@ -1328,829 +3010,144 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
                     
                     // ONNX 추론
                     auto inferenceStart = std::chrono::high_resolution_clock::now();
+                    const qint64 inferenceTraceStart = InspectionTracer::nowUs();
                     float anomalyScore = 0.0f;
                     cv::Mat anomalyMap;
                     
                     bool inferenceSuccess = ImageProcessor::runPaDiMONNXInference(
                         modelPath, roiImage, anomalyScore, anomalyMap, pattern.passThreshold);
-                    
-                    auto inferenceEnd = std::chrono::high_resolution_clock::now();
-                    auto patternTime = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
-                    
-                    if (!inferenceSuccess) {
-                        result.insResults[pattern.id] = false;
-                        result.insScores[pattern.id] = 0.0;
-                        result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
-                        result.isPassed = false;
-                        continue;
-                    }
-                    
-                    float roiAnomalyScore = std::max(0.0f, std::min(100.0f, anomalyScore));
-                    
-                    // Threshold 처리
-                    cv::Mat binaryMask;
-                    cv::threshold(anomalyMap, binaryMask, pattern.passThreshold, 255, cv::THRESH_BINARY);
-                    binaryMask.convertTo(binaryMask, CV_8U);
-                    
-                    std::vector<std::vector<cv::Point>> contours;
-                    cv::findContours(binaryMask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
-                    
-                    bool hasDefect = false;
-                    std::vector<std::vector<cv::Point>> defectContours;
-                    int adjustedX = adjustedRect.x();
-                    int adjustedY = adjustedRect.y();
-                    
-                    for (const auto& contour : contours) {
-                        int blobSize = static_cast<int>(cv::contourArea(contour));
-                        cv::Rect bbox = cv::boundingRect(contour);
-                        
-                        bool sizeCheck = (blobSize >= pattern.anomalyMinBlobSize);
-                        bool widthCheck = (bbox.width >= pattern.anomalyMinDefectWidth);
-                        bool heightCheck = (bbox.height >= pattern.anomalyMinDefectHeight);
-                        
-                        if (sizeCheck || (widthCheck && heightCheck)) {
-                            hasDefect = true;
-                            std::vector<cv::Point> absoluteContour;
-                            for (const auto& pt : contour) {
-                                absoluteContour.push_back(cv::Point(pt.x + adjustedX, pt.y + adjustedY));
-                            }
-                            defectContours.push_back(absoluteContour);
-                        }
-                    }
-                    
-                    result.insScores[pattern.id] = static_cast<double>(roiAnomalyScore);
-                    result.insResults[pattern.id] = !hasDefect;
-                    result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
-                    result.anomalyDefectContours[pattern.id] = defectContours;
-                    result.anomalyRawMap[pattern.id] = anomalyMap.clone();
-                    
-                    // 히트맵 생성
-                    cv::Mat normalized;
-                    anomalyMap.convertTo(normalized, CV_8U, 255.0 / 100.0);
-                    cv::Mat colorHeatmap;
-                    cv::applyColorMap(normalized, colorHeatmap, cv::COLORMAP_JET);
-                    result.anomalyHeatmap[pattern.id] = colorHeatmap.clone();
-                    result.anomalyHeatmapRect[pattern.id] = pattern.rect;
-                    
-                    result.isPassed = result.isPassed && !hasDefect;
-                    apdPatternCount++;
-                    
-                    QString insResultText = !hasDefect ? "PASS" : "NG";
-                    QString resultColor = !hasDefect ? "<font color='#00FF00'>" : "<font color='#FF0000'>";
-                    int defectCount = defectContours.size();
-                    
-                    if (defectCount > 0)
-                    {
-                        int maxW = 0, maxH = 0;
-                        for (const auto& contour : defectContours)
-                        {
-                            cv::Rect bbox = cv::boundingRect(contour);
-                            if (bbox.width > maxW) maxW = bbox.width;
-                            if (bbox.height > maxH) maxH = bbox.height;
-                        }
-                        logDebug(QString("  └─ <font color='#8BCB8B'>%1(A-PD)</font>: W:%2 H:%3 Detects:%4 (score=%5, thr=%6) [%7ms]")
-                            .arg(pattern.name).arg(maxW).arg(maxH).arg(defectCount)
-                            .arg(roiAnomalyScore, 0, 'f', 2).arg(pattern.passThreshold, 0, 'f', 2).arg(patternTime));
-                    }
-                    else
-                    {
-                        logDebug(QString("  └─ <font color='#8BCB8B'>%1(A-PD)</font>: %2%3</font> (score=%4, thr=%5) [%6ms]")
-                            .arg(pattern.name).arg(resultColor).arg(insResultText)
-                            .arg(roiAnomalyScore, 0, 'f', 2).arg(pattern.passThreshold, 0, 'f', 2).arg(patternTime));
-                    }
-                }
-            }
-        }
-#endif
-        
-        // Anomaly 전체 처리 완료 요약
-        if (totalAnomalyCount > 0) {
-            auto anomalyBatchEnd = std::chrono::high_resolution_clock::now();
-            
-            long long apcDuration = 0;
-            long long apdDuration = 0;
-            if (apcPatternCount > 0) {
-                apcDuration = std::chrono::duration_cast<std::chrono::milliseconds>(apdBatchStart - apcBatchStart).count();
-            }
-            if (apdPatternCount > 0) {
-                apdDuration = std::chrono::duration_cast<std::chrono::milliseconds>(anomalyBatchEnd - apdBatchStart).count();
-            }
-        }
-        
-        // ===== 일반 INS 패턴 처리 (A-PC, A-PD 제외) =====
-        for (const PatternInfo &pattern : insPatterns)
-        {
-            // A-PC와 A-PD는 이미 배치로 처리됨
-            if (pattern.inspectionMethod == InspectionMethod::A_PC ||
-                pattern.inspectionMethod == InspectionMethod::A_PD)
-            {
-                continue;
-            }
-            
-            // 마스크 필터가 활성화되어 있으면 검사 PASS 처리
-            bool hasMaskFilter = false;
-            for (const FilterInfo &filter : pattern.filters)
-            {
-                if (filter.enabled && filter.type == FILTER_MASK)
-                {
-                    hasMaskFilter = true;
-                    break;
-                }
-            }
-            if (hasMaskFilter)
-            {
-                logDebug(QString("INS 패턴 '%1': 마스크 필터 활성화 → 검사 PASS 처리").arg(pattern.name));
-                result.insResults[pattern.id] = true;
-                result.insScores[pattern.id] = 1.0;
-                result.adjustedRects[pattern.id] = pattern.rect;
-                result.insMethodTypes[pattern.id] = InspectionMethod::DIFF;
-                continue;
-            }
-
-            // 기본 검사 영역은 패턴의 원본 영역
-            QRect originalRect = QRect(
-                static_cast<int>(pattern.rect.x()),
-                static_cast<int>(pattern.rect.y()),
-                static_cast<int>(pattern.rect.width()),
-                static_cast<int>(pattern.rect.height()));
-            QRect adjustedRect = originalRect;
-
-            // ===== INS 패턴 매칭 (Fine Alignment) =====
-            // 부모 FID와 무관하게 독립적으로 동작
-            if (pattern.patternMatchEnabled && !pattern.matchTemplate.isNull())
-            {
-                // 검색 범위: 부모 ROI 전체 영역 (현재 STRIP/CRIMP 모드에 맞는 ROI)
-                cv::Rect searchROI;
-                
-                // 부모 ROI 찾기
-                QUuid parentRoiId;
-                for (const PatternInfo& p : patterns) {
-                    if (p.type == PatternType::ROI) {
-                        parentRoiId = p.id;
-                        searchROI = cv::Rect(
-                            static_cast<int>(p.rect.x()),
-                            static_cast<int>(p.rect.y()),
-                            static_cast<int>(p.rect.width()),
-                            static_cast<int>(p.rect.height())
-                        );
-                        break;
-                    }
-                }
-                
-                // ROI를 못 찾으면 전체 이미지 사용
-                if (searchROI.area() == 0) {
-                    searchROI = cv::Rect(0, 0, image.cols, image.rows);
-                }
-
-                // matchTemplate을 cv::Mat으로 변환
-                cv::Mat templateMat;
-                cv::Mat maskMat;  // 마스크 추가
-                
-                if (pattern.matchTemplate.format() == QImage::Format_RGB888)
-                {
-                    templateMat = cv::Mat(
-                        pattern.matchTemplate.height(),
-                        pattern.matchTemplate.width(),
-                        CV_8UC3,
-                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                        pattern.matchTemplate.bytesPerLine()
-                    ).clone();
-                    cv::cvtColor(templateMat, templateMat, cv::COLOR_RGB2BGR);
-                }
-                else if (pattern.matchTemplate.format() == QImage::Format_RGB32 ||
-                         pattern.matchTemplate.format() == QImage::Format_ARGB32)
-                {
-                    templateMat = cv::Mat(
-                        pattern.matchTemplate.height(),
-                        pattern.matchTemplate.width(),
-                        CV_8UC4,
-                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                        pattern.matchTemplate.bytesPerLine()
-                    ).clone();
-                    cv::cvtColor(templateMat, templateMat, cv::COLOR_RGBA2BGR);
-                }
-                else if (pattern.matchTemplate.format() == QImage::Format_Grayscale8)
-                {
-                    templateMat = cv::Mat(
-                        pattern.matchTemplate.height(),
-                        pattern.matchTemplate.width(),
-                        CV_8UC1,
-                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                        pattern.matchTemplate.bytesPerLine()
-                    ).clone();
-                }
-                
-                // 마스크 변환 (있는 경우)
-                if (!pattern.matchTemplateMask.isNull())
-                {
-                    maskMat = cv::Mat(
-                        pattern.matchTemplateMask.height(),
-                        pattern.matchTemplateMask.width(),
-                        CV_8UC1,
-                        const_cast<uchar*>(pattern.matchTemplateMask.bits()),
-                        pattern.matchTemplateMask.bytesPerLine()
-                    ).clone();
-                }
-
-                if (!templateMat.empty() && searchROI.width > 0 && searchROI.height > 0)
-                {
-                    // 검색 영역 추출
-                    cv::Mat searchRegion = image(searchROI).clone();
-
-                    // 패턴 매칭 수행
-                    cv::Point matchLoc;
-                    double matchScore = 0.0;
-                    double matchAngle = pattern.angle;
-
-                    auto insMatchStart = std::chrono::high_resolution_clock::now();
-                    bool matched = performTemplateMatching(
-                        searchRegion,
-                        templateMat,
-                        matchLoc,
-                        matchScore,
-                        matchAngle,
-                        pattern,
-                        pattern.patternMatchUseRotation ? pattern.patternMatchMinAngle : 0.0,
-                        pattern.patternMatchUseRotation ? pattern.patternMatchMaxAngle : 0.0,
-                        pattern.patternMatchUseRotation ? pattern.patternMatchAngleStep : 1.0,
-                        maskMat  // 마스크 전달
-                    );
-                    // 패턴 매칭 완료
-
-                    if (matched && (matchScore * 100.0) >= pattern.patternMatchThreshold)
-                    {
-                        // 패턴 매칭 성공 - 찾은 위치로 검사 영역 업데이트
-                        int matchedCenterX = searchROI.x + matchLoc.x;
-                        int matchedCenterY = searchROI.y + matchLoc.y;
-
-                        // 패턴 매칭 성공
-
-                        // 검사 영역을 매칭된 위치로 업데이트
-                        adjustedRect = QRect(
-                            matchedCenterX - pattern.rect.width() / 2,
-                            matchedCenterY - pattern.rect.height() / 2,
-                            pattern.rect.width(),
-                            pattern.rect.height()
-                        );
-
-                        // 각도도 업데이트 (검사 시 사용)
-                        const_cast<PatternInfo&>(pattern).angle = matchAngle;
-                    }
-                    else
-                    {
-                        logDebug(QString("INS 패턴 '%1': 패턴 매칭 실패 (Score=%2% < Threshold=%3%), 원본 위치 사용")
-                                     .arg(pattern.name)
-                                     .arg(matchScore * 100.0, 0, 'f', 1)
-                                     .arg(pattern.patternMatchThreshold, 0, 'f', 1));
-                    }
-                }
-                else
-                {
-                    logDebug(QString("INS 패턴 '%1': 패턴 매칭 실패 - templateMat.empty()=%2, searchROI 유효=%3")
-                                 .arg(pattern.name)
-                                 .arg(templateMat.empty())
-                                 .arg(searchROI.width > 0 && searchROI.height > 0));
-                }
-            }
-
-            // 부모 FID 정보가 있는 경우 처리 (패턴 매칭 후에 추가 조정)
-            cv::Point parentOffset(0, 0);
-            double parentAngle = 0.0;
-            double parentFidTeachingAngle = 0.0;
-            bool hasParentInfo = false;
-
-            // 부모 FID가 있는지 확인
-            if (!pattern.parentId.isNull())
-            {
-                // 부모 FID의 매칭 결과가 있는지 확인
-                if (result.fidResults.contains(pattern.parentId))
-                {
-                    // 부모 FID가 매칭에 실패했을 경우 이 INS 패턴은 FAIL (검사 불가)
-                    if (!result.fidResults[pattern.parentId])
-                    {
-                        logDebug(QString("INS pattern '%1': FAIL - Cannot inspect (parent FID match failed)")
-                                     .arg(pattern.name));
-                        result.insResults[pattern.id] = false;
-                        result.insScores[pattern.id] = 0.0;
-                        result.isPassed = false;
-                        continue;
-                    }
-
-                    // FID 점수 확인 - 1.0이면 위치 조정 생략
-                    double fidScore = result.matchScores.value(pattern.parentId, 0.0);
-                    if (fidScore >= 0.999)
-                    {
-
-                        // 위치 조정하지 않고 원래 패턴 위치 그대로 사용
-                        adjustedRect = originalRect;
-                    }
-                    else
-                    {
-
-                        // 부모 FID의 위치 정보가 있는 경우 조정
-                        if (result.locations.contains(pattern.parentId))
-                        {
-                            cv::Point fidLoc = result.locations[pattern.parentId];
-                            double fidAngle = result.angles[pattern.parentId];
-
-                            // FID의 원래 정보 찾기
-                            QPoint originalFidCenter;
-                            // double parentFidTeachingAngle = 0.0; // 제거: 위에서 이미 선언됨
-                            PatternInfo parentFidInfo;
-                            bool foundFid = false;
-
-                            for (const PatternInfo &fid : fidPatterns)
-                            {
-                                if (fid.id == pattern.parentId)
-                                {
-                                    originalFidCenter = QPoint(
-                                        static_cast<int>(fid.rect.center().x()),
-                                        static_cast<int>(fid.rect.center().y()));
-                                    // 백업된 패턴에서 원본 티칭 각도 가져오기 (검출 각도가 아닌 원본 각도)
-                                    auto backupIt = std::find_if(patterns.begin(), patterns.end(),
-                                                                 [&](const PatternInfo &p)
-                                                                 { return p.id == pattern.parentId; });
-                                    if (backupIt != patterns.end())
-                                    {
-                                        parentFidTeachingAngle = backupIt->angle; // 원본 티칭 각도 사용
-                                    }
-                                    else
-                                    {
-                                        parentFidTeachingAngle = 0.0; // 백업이 없으면 0도로 가정
-                                    }
-                                    parentFidInfo = fid;
-                                    foundFid = true;
-                                    break;
-                                }
-                            }
-
-                            if (!foundFid)
-                            {
-                                logDebug(QString("INS 패턴 '%1': 부모 FID 정보를 찾을 수 없음")
-                                             .arg(pattern.name));
-                                continue;
-                            }
-
-                            // 부모 FID의 위치와 각도 정보를 저장
-                            parentOffset = cv::Point(
-                                fidLoc.x - originalFidCenter.x(),
-                                fidLoc.y - originalFidCenter.y());
-
-                            // **중요**: INS 패턴의 회전 각도는 티칭 각도 + FID 회전 차이
-                            // FID 티칭 각도와 검출 각도의 차이를 INS 패턴에 적용
-                            double fidAngleDiff = fidAngle - parentFidTeachingAngle;
-                            parentAngle = pattern.angle + fidAngleDiff;
-                            hasParentInfo = true;
-
-                            // ===== 패턴 매칭 (Fine Alignment) 디버그 =====
-                            // ===== 패턴 매칭 (Fine Alignment) 수행 =====
-                            if (pattern.patternMatchEnabled && !pattern.matchTemplate.isNull())
-                            {
-                                // 1. Coarse Alignment: FID 기반 대략 위치
-                                cv::Point coarseCenter(fidLoc.x, fidLoc.y);
-                                double coarseAngle = fidAngle;
-
-                                // 2. Fine Alignment: 부모 ROI 전체 영역에서 패턴 매칭
-                                cv::Rect searchROI;
-                                
-                                // 부모 ROI 찾기
-                                for (const PatternInfo& p : patterns) {
-                                    if (p.type == PatternType::ROI) {
-                                        searchROI = cv::Rect(
-                                            static_cast<int>(p.rect.x()),
-                                            static_cast<int>(p.rect.y()),
-                                            static_cast<int>(p.rect.width()),
-                                            static_cast<int>(p.rect.height())
-                                        );
-                                        break;
-                                    }
-                                }
-                                
-                                // ROI를 못 찾으면 전체 이미지 사용
-                                if (searchROI.area() == 0) {
-                                    searchROI = cv::Rect(0, 0, image.cols, image.rows);
-                                }
-
-                                // matchTemplate을 cv::Mat으로 변환
-                                cv::Mat templateMat;
-                                if (pattern.matchTemplate.format() == QImage::Format_RGB888)
-                                {
-                                    templateMat = cv::Mat(
-                                        pattern.matchTemplate.height(),
-                                        pattern.matchTemplate.width(),
-                                        CV_8UC3,
-                                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                                        pattern.matchTemplate.bytesPerLine()
-                                    ).clone();
-                                    cv::cvtColor(templateMat, templateMat, cv::COLOR_RGB2BGR);
-                                }
-                                else if (pattern.matchTemplate.format() == QImage::Format_RGB32 ||
-                                         pattern.matchTemplate.format() == QImage::Format_ARGB32)
-                                {
-                                    templateMat = cv::Mat(
-                                        pattern.matchTemplate.height(),
-                                        pattern.matchTemplate.width(),
-                                        CV_8UC4,
-                                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                                        pattern.matchTemplate.bytesPerLine()
-                                    ).clone();
-                                    cv::cvtColor(templateMat, templateMat, cv::COLOR_RGBA2BGR);
-                                }
-                                else if (pattern.matchTemplate.format() == QImage::Format_Grayscale8)
-                                {
-                                    templateMat = cv::Mat(
-                                        pattern.matchTemplate.height(),
-                                        pattern.matchTemplate.width(),
-                                        CV_8UC1,
-                                        const_cast<uchar*>(pattern.matchTemplate.bits()),
-                                        pattern.matchTemplate.bytesPerLine()
-                                    ).clone();
-                                }
-
-                                if (templateMat.empty())
-                                {
-                                    // 변환 실패
-                                }
-                                else
-                                {
-                                    // ★ 마스크 변환 (FID 기반도 마스크 지원)
-                                    cv::Mat maskMat;
-                                    if (!pattern.matchTemplateMask.isNull())
-                                    {
-                                        maskMat = cv::Mat(
-                                            pattern.matchTemplateMask.height(),
-                                            pattern.matchTemplateMask.width(),
-                                            CV_8UC1,
-                                            const_cast<uchar*>(pattern.matchTemplateMask.bits()),
-                                            pattern.matchTemplateMask.bytesPerLine()
-                                        ).clone();
-                                    }
-                                    
-                                    // 검색 영역 추출
-                                    cv::Mat searchRegion = image(searchROI).clone();
-
-                                    // 패턴 매칭 수행 (FID와 동일한 함수 사용)
-                                    cv::Point matchLoc;
-                                    double matchScore = 0.0;
-                                    double matchAngle = coarseAngle;
-
-                                    bool matched = performTemplateMatching(
-                                        searchRegion,
-                                        templateMat,
-                                        matchLoc,
-                                        matchScore,
-                                        matchAngle,
-                                        pattern,
-                                        pattern.patternMatchUseRotation ? pattern.patternMatchMinAngle : 0.0,
-                                        pattern.patternMatchUseRotation ? pattern.patternMatchMaxAngle : 0.0,
-                                        pattern.patternMatchUseRotation ? pattern.patternMatchAngleStep : 1.0,
-                                        maskMat  // ★ 마스크 전달
-                                    );
-
-                                    if (matched && (matchScore * 100.0) >= pattern.patternMatchThreshold)
-                                    {
-                                        // 패턴 매칭 성공 - Fine 위치/각도로 업데이트
-                                        int fineX = searchROI.x + matchLoc.x;
-                                        int fineY = searchROI.y + matchLoc.y;
-                                        
-                                        fidLoc.x = fineX;
-                                        fidLoc.y = fineY;
-                                        parentAngle = matchAngle;
-
-                                        // 오프셋 재계산
-                                        parentOffset = cv::Point(
-                                            fidLoc.x - originalFidCenter.x(),
-                                            fidLoc.y - originalFidCenter.y()
-                                        );
-                                    }
-                                    else
-                                    {
-                                        // 매칭 실패 - Coarse 위치 사용
-                                    }
-                                }
-                            }
-
-                            // 부모 FID 위치에 따른 검사 영역 조정 구현
-                            // 1. 티칭 시점의 FID/INS 중심을 부동소수점으로 사용하여 상대 벡터 계산
-                            QPointF fidTeachingCenterF = parentFidInfo.rect.center();
-                            QPointF insTeachingCenterF = pattern.rect.center();
-                            double relX = insTeachingCenterF.x() - fidTeachingCenterF.x();
-                            double relY = insTeachingCenterF.y() - fidTeachingCenterF.y();
-
-                            // 2. 각도 차이 계산 (FID 검출 각도 - FID 티칭 각도)
-                            double angleDiff = fidAngle - parentFidTeachingAngle;
-                            double radians = angleDiff * M_PI / 180.0;
-
-                            // 3. 상대 벡터를 각도만큼 회전 (부동소수점 정밀도 유지)
-                            // 이미지 좌표계(Y 증가 방향이 아래)를 고려해 회전 방향을 반전
-                            double cosA = std::cos(radians);
-                            double sinA = std::sin(radians);
-                            // 회전 부호를 반대로 하여 화면에서 기대하는 회전 방향으로 맞춤
-                            double rotatedX = relX * cosA + relY * sinA; // using -radians
-                            double rotatedY = -relX * sinA + relY * cosA;
-
-                            // 4. FID 검출 위치(정확한 픽셀 좌표) + 회전된 상대 벡터 = INS 새 중심 (부동소수점)
-                            double newCenterX_d = static_cast<double>(fidLoc.x) + rotatedX;
-                            double newCenterY_d = static_cast<double>(fidLoc.y) + rotatedY;
-
-                            // 정수 좌표로 반올림하여 QRect 계산
-                            int newCenterX = static_cast<int>(std::lround(newCenterX_d));
-                            int newCenterY = static_cast<int>(std::lround(newCenterY_d));
-
-                            int width = pattern.rect.width();
-                            int height = pattern.rect.height();
-
-                            // 중심점 기준으로 새로운 조정된 검사 영역 계산
-                            adjustedRect = QRect(
-                                newCenterX - width / 2,  // 회전된 새 x 좌표
-                                newCenterY - height / 2, // 회전된 새 y 좌표
-                                width,                   // 너비 동일
-                                height                   // 높이 동일
-                            );
-                        }
-                    }
-                }
-            }
-
-            // INS 패턴은 ROI 체크를 하지 않음 (전체 이미지에서 검사)
-            QPoint adjustedCenter = adjustedRect.center();
-
-            // 조정된 영역이 이미지 경계를 벗어나는지 확인
-            if (adjustedRect.x() < 0 || adjustedRect.y() < 0 ||
-                adjustedRect.x() + adjustedRect.width() > image.cols ||
-                adjustedRect.y() + adjustedRect.height() > image.rows)
-            {
-
-                logDebug(QString("INS 패턴 '%1': 조정된 영역이 이미지 경계를 벗어남, 영역 조정").arg(pattern.name));
-
-                // 이미지 경계 내로 영역 조정
-                int x = std::max(0, adjustedRect.x());
-                int y = std::max(0, adjustedRect.y());
-                int width = std::min(image.cols - x, adjustedRect.width());
-                int height = std::min(image.rows - y, adjustedRect.height());
-
-                // 조정된 영역이 너무 작으면 검사 실패
-                if (width < 10 || height < 10)
-                {
-                    logDebug(QString("INS 패턴 '%1': 조정된 영역이 너무 작음, 검사 실패").arg(pattern.name));
-                    result.insResults[pattern.id] = false;
-                    result.insScores[pattern.id] = 0.0;
-                    if (hasParentInfo)
-                    {
-                        result.parentOffsets[pattern.id] = parentOffset;
-                        result.parentAngles[pattern.id] = parentAngle;
-                    }
-                    result.isPassed = false;
-                    continue;
-                }
-
-                // 유효한 영역으로 조정
-                adjustedRect = QRect(x, y, width, height);
-                logDebug(QString("INS 패턴 '%1': 영역 조정됨 - (%2,%3,%4,%5)")
-                             .arg(pattern.name)
-                             .arg(adjustedRect.x())
-                             .arg(adjustedRect.y())
-                             .arg(adjustedRect.width())
-                             .arg(adjustedRect.height()));
-            }
-
-            double inspScore = 0.0;
-            bool inspPassed = false;
-
-            // 검사 방법에 따른 분기 - 패턴 복제하여 조정된 영역으로 설정
-            PatternInfo adjustedPattern = pattern;
-            adjustedPattern.rect = adjustedRect;
-
-            // 최종 계산된 각도 설정 (INS 원본 각도 + FID 회전 차이)
-
-            if (hasParentInfo)
-            {
-                // FID 회전 차이만큼 INS 원본 각도에 추가
-                double fidAngleDiff = parentAngle - parentFidTeachingAngle;
-                adjustedPattern.angle = pattern.angle + fidAngleDiff; // INS 원본 각도 + FID 회전 차이
-            }
-            else
-            {
-                adjustedPattern.angle = pattern.angle; // 패턴 각도만
-            }
-
-            // 검사 시간 측정
-            auto insStart = std::chrono::high_resolution_clock::now();
-            
-            switch (pattern.inspectionMethod)
-            {
-            case InspectionMethod::DIFF:
-                inspPassed = checkDiff(image, adjustedPattern, inspScore, result);
-                logDebug(QString("DIFF 검사 수행: %1 (method=%2)").arg(pattern.name).arg(pattern.inspectionMethod));
-                break;
-
-            case InspectionMethod::STRIP:
-            {
-                // 디버그: STRIP 검사 직전 각도 확인
-
-                inspPassed = checkStrip(image, adjustedPattern, inspScore, result, patterns);
-
-                break;
-            }
-
-            case InspectionMethod::CRIMP:
-            {
-                inspPassed = checkCrimp(image, adjustedPattern, inspScore, result, patterns);
-                break;
-            }
-
-            case InspectionMethod::SSIM:
-            {
-                inspPassed = checkSSIM(image, adjustedPattern, inspScore, result);
-                break;
-            }
-
-            case InspectionMethod::A_PC:
-            case InspectionMethod::A_PD:
-            {
-                // A-PC와 A-PD는 배치로 이미 처리됨 - 로그만 출력하고 continue
-                // 결과는 배치 처리 단계에서 이미 result에 저장됨
-                inspPassed = result.insResults.value(pattern.id, false);
-                inspScore = result.insScores.value(pattern.id, 0.0);
-                
-                // 검사 시간은 0으로 설정 (배치 처리에서 전체 시간 측정됨)
-                auto insEnd = std::chrono::high_resolution_clock::now();
-                auto insDuration = 0; // 배치 처리에서 이미 측정
-                
-                // 결과 로그 출력
-                QString insResultText = inspPassed ? "PASS" : "NG";
-                QString resultColor = inspPassed ? "<font color='#00FF00'>" : "<font color='#FF0000'>";
-                QString colorGreen = "<font color='#8BCB8B'>";
-                QString colorEnd = "</font>";
-                
-                // 이미 배치 처리에서 로그 출력했으므로 여기서는 건너뜀
-                // (중복 로그 방지)
-                
-                continue; // 다음 패턴으로
-            }
-
-            default:
-                // 이전 PATTERN 타입은 DIFF로 처리
-                inspPassed = checkDiff(image, adjustedPattern, inspScore, result);
-                logDebug(QString("알 수 없는 검사 방법 %1, DIFF 검사로 수행: %2")
-                             .arg(pattern.inspectionMethod)
-                             .arg(pattern.name));
-                break;
-            }
-            
-            // 검사 시간 종료
-            auto insEnd = std::chrono::high_resolution_clock::now();
-            auto insDuration = std::chrono::duration_cast<std::chrono::milliseconds>(insEnd - insStart).count();
-
-            // 결과 기록
-            result.insResults[pattern.id] = inspPassed;
-            result.insScores[pattern.id] = inspScore;
-            result.adjustedRects[pattern.id] = adjustedRect;
-
-            // 부모 FID 위치 정보가 있으면 저장
-            if (hasParentInfo)
-            {
-                result.parentOffsets[pattern.id] = parentOffset;
-                result.parentAngles[pattern.id] = parentAngle;
-            }
-            else
-            {
-                // 그룹화되지 않은 INS 패턴은 티칭한 각도 그대로 사용
-                result.parentAngles[pattern.id] = pattern.angle;
-            }
-
-            // INS 검사 결과 로그 (개별 출력)
-            QString insResultText;
-            if (!result.fidResults.value(pattern.parentId, true) && !pattern.parentId.isNull())
-            {
-                // 부모 FID 매칭 실패로 검사 불가
-                insResultText = "FAIL";
-            }
-            else if (inspPassed)
-            {
-                insResultText = "PASS";
-            }
-            else
-            {
-                insResultText = "NG";
-            }
-
-            // HTML 색상 태그 (Qt 로그용)
-            QString colorGreen = "<font color='#8BCB8B'>";    // 연한 초록색 (INS 패턴)
-            QString colorPass = "<font color='#00FF00'>";     // 초록색 (PASS)
-            QString colorNG = "<font color='#FF0000'>";       // 빨간색 (NG, FAIL)
-            QString colorEnd = "</font>";                      // 색상 종료
-            
-            // 결과 색상 선택
-            QString resultColor = inspPassed ? colorPass : colorNG;
-
-            // 검사 방법별 결과 포맷팅
-            QString resultDetail;
-            if (pattern.inspectionMethod == InspectionMethod::A_PC ||
-                pattern.inspectionMethod == InspectionMethod::A_PD)
-            {
-                // A-PC/A-PD: 불량 개수 및 최대 W/H 표시
-                QString methodName = InspectionMethod::getName(pattern.inspectionMethod);
-                int defectCount = result.anomalyDefectContours.value(pattern.id).size();
-                if (defectCount > 0) {
-                    // 최대 컨투어 W/H 찾기
-                    int maxW = 0, maxH = 0;
-                    for (const auto& contour : result.anomalyDefectContours.value(pattern.id)) {
+                    
+                    auto inferenceEnd = std::chrono::high_resolution_clock::now();
+                    InspectionTracer::instance().addSpan(frame.traceId(), "ANOMALY", pattern.name,
+                                                         inferenceTraceStart, InspectionTracer::nowUs());
+                    auto patternTime = std::chrono::duration_cast<std::chrono::milliseconds>(inferenceEnd - inferenceStart).count();
+                    result.patternTimesUs[pattern.id] = std::chrono::duration_cast<std::chrono::microseconds>(inferenceEnd - inferenceStart).count();
+                    
+                    if (!inferenceSuccess) {
+                        result.insResults[pattern.id] = false;
+                        result.insScores[pattern.id] = 0.0;
+                        result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
+                        result.isPassed = false;
+                        continue;
+                    }
+                    
+                    float roiAnomalyScore = std::max(0.0f, std::min(100.0f, anomalyScore));
+                    
+                    // Threshold 처리
+                    cv::Mat binaryMask;
+                    cv::threshold(anomalyMap, binaryMask, pattern.passThreshold, 255, cv::THRESH_BINARY);
+                    binaryMask.convertTo(binaryMask, CV_8U);
+                    
+                    std::vector<std::vector<cv::Point>> contours;
+                    cv::findContours(binaryMask, contours, cv::RETR_EXTERNAL, cv::CHAIN_APPROX_SIMPLE);
+                    
+                    bool hasDefect = false;
+                    std::vector<std::vector<cv::Point>> defectContours;
+                    int adjustedX = adjustedRect.x();
+                    int adjustedY = adjustedRect.y();
+                    
+                    for (const auto& contour : contours) {
+                        int blobSize = static_cast<int>(cv::contourArea(contour));
                         cv::Rect bbox = cv::boundingRect(contour);
-                        if (bbox.width > maxW) maxW = bbox.width;
-                        if (bbox.height > maxH) maxH = bbox.height;
+                        
+                        bool sizeCheck = (blobSize >= pattern.anomalyMinBlobSize);
+                        bool widthCheck = (bbox.width >= pattern.anomalyMinDefectWidth);
+                        bool heightCheck = (bbox.height >= pattern.anomalyMinDefectHeight);
+                        
+                        if (sizeCheck || (widthCheck && heightCheck)) {
+                            hasDefect = true;
+                            std::vector<cv::Point> absoluteContour;
+                            for (const auto& pt : contour) {
+                                absoluteContour.push_back(cv::Point(pt.x + adjustedX, pt.y + adjustedY));
+                            }
+                            defectContours.push_back(absoluteContour);
+                        }
                     }
-                    resultDetail = QString("  └─ %1%2(%3)%4: W:%5 H:%6 Detects:%7 (%8ms)")
-                                       .arg(colorGreen).arg(pattern.name)
-                                       .arg(methodName).arg(colorEnd)
-                                       .arg(maxW)
-                                       .arg(maxH)
-                                       .arg(defectCount)
-                                       .arg(insDuration);
-                } else {
-                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
-                                       .arg(colorGreen).arg(pattern.name)
-                                       .arg(methodName).arg(colorEnd)
-                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                       .arg(insDuration);
-                }
-            }
-            else if (pattern.inspectionMethod == InspectionMethod::STRIP)
-            {
-                // STRIP: 세부 결과 한 줄로
-                QStringList stripDetails;
-                
-                // gradient points 부족으로 검사 실패한 경우 (score = 0.0)
-                if (inspScore == 0.0 && !result.stripPointsValid.value(pattern.id, false)) {
-                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (insufficient gradient points) (%8ms)")
-                                       .arg(colorGreen).arg(pattern.name)
-                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                       .arg(insDuration);
-                } else {
-                    if (result.frontResult != "PASS") stripDetails << QString("FRONT:%1").arg(result.frontDetail);
-                    if (result.rearResult != "PASS") stripDetails << QString("REAR:%1").arg(result.rearDetail);
-                    if (result.edgeResult != "PASS") stripDetails << QString("EDGE:%1").arg(result.edgeDetail);
                     
-                    if (stripDetails.isEmpty()) {
-                        resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
-                                           .arg(colorGreen).arg(pattern.name)
-                                           .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                           .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                           .arg(insDuration);
-                    } else {
-                        resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8) (%9ms)")
-                                           .arg(colorGreen).arg(pattern.name)
-                                           .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                           .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                           .arg(stripDetails.join(", "))
-                                           .arg(insDuration);
+                    result.insScores[pattern.id] = static_cast<double>(roiAnomalyScore);
+                    result.insResults[pattern.id] = !hasDefect;
+                    result.insMethodTypes[pattern.id] = InspectionMethod::A_PD;
+                    result.anomalyDefectContours[pattern.id] = defectContours;
+                    result.anomalyRawMap[pattern.id] = anomalyMap.clone();
+                    
+                    // 히트맵 생성
+                    cv::Mat normalized;
+                    anomalyMap.convertTo(normalized, CV_8U, 255.0 / 100.0);
+                    cv::Mat colorHeatmap;
+                    cv::applyColorMap(normalized, colorHeatmap, cv::COLORMAP_JET);
+                    result.anomalyHeatmap[pattern.id] = colorHeatmap.clone();
+                    result.anomalyHeatmapRect[pattern.id] = pattern.rect;
+                    
+                    result.isPassed = result.isPassed && !hasDefect;
+                    apdPatternCount++;
+                    
+                    QString insResultText = !hasDefect ? "PASS" : "NG";
+                    QString resultColor = !hasDefect ? "<font color='#00FF00'>" : "<font color='#FF0000'>";
+                    int defectCount = defectContours.size();
+                    
+                    if (defectCount > 0)
+                    {
+                        int maxW = 0, maxH = 0;
+                        for (const auto& contour : defectContours)
+                        {
+                            cv::Rect bbox = cv::boundingRect(contour);
+                            if (bbox.width > maxW) maxW = bbox.width;
+                            if (bbox.height > maxH) maxH = bbox.height;
+                        }
+                        logDebug(QString("  └─ <font color='#8BCB8B'>%1(A-PD)</font>: W:%2 H:%3 Detects:%4 (score=%5, thr=%6) [%7ms]")
+                            .arg(pattern.name).arg(maxW).arg(maxH).arg(defectCount)
+                            .arg(roiAnomalyScore, 0, 'f', 2).arg(pattern.passThreshold, 0, 'f', 2).arg(patternTime));
+                    }
+                    else
+                    {
+                        logDebug(QString("  └─ <font color='#8BCB8B'>%1(A-PD)</font>: %2%3</font> (score=%4, thr=%5) [%6ms]")
+                            .arg(pattern.name).arg(resultColor).arg(insResultText)
+                            .arg(roiAnomalyScore, 0, 'f', 2).arg(pattern.passThreshold, 0, 'f', 2).arg(patternTime));
                     }
                 }
             }
-            else if (pattern.inspectionMethod == InspectionMethod::CRIMP)
-            {
-                // CRIMP: YOLO 검출 정보
-                bool crimpLeft = result.barrelLeftResults.value(pattern.id, false);
-                bool crimpRight = result.barrelRightResults.value(pattern.id, false);
-                
-                QStringList crimpDetails;
-                if (!crimpLeft) crimpDetails << "L:FAIL";
-                if (!crimpRight) crimpDetails << "R:FAIL";
-                
-                if (crimpDetails.isEmpty()) {
-                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
-                                       .arg(colorGreen).arg(pattern.name)
-                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                       .arg(insDuration);
-                } else {
-                    resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8) (%9ms)")
-                                       .arg(colorGreen).arg(pattern.name)
-                                       .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                       .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                       .arg(crimpDetails.join(", "))
-                                       .arg(insDuration);
-                }
+        }
+#endif
+        
+        // Anomaly 전체 처리 완료 요약
+        if (totalAnomalyCount > 0) {
+            auto anomalyBatchEnd = std::chrono::high_resolution_clock::now();
+            InspectionTracer::instance().addSpan(frame.traceId(), "ANOMALY", QStringLiteral("ANOMALY 전체"),
+                                                 anomalyTraceStart, InspectionTracer::nowUs());
+            
+            long long apcDuration = 0;
+            long long apdDuration = 0;
+            if (apcPatternCount > 0) {
+                apcDuration = std::chrono::duration_cast<std::chrono::milliseconds>(apdBatchStart - apcBatchStart).count();
             }
-            else
-            {
-                // 기본 형식 (DIFF, SSIM 등)
-                resultDetail = QString("  └─ %1%2(%3)%4: %5%6%7 (%8ms)")
-                                   .arg(colorGreen).arg(pattern.name)
-                                   .arg(InspectionMethod::getName(pattern.inspectionMethod)).arg(colorEnd)
-                                   .arg(resultColor).arg(insResultText).arg(colorEnd)
-                                   .arg(insDuration);
+            if (apdPatternCount > 0) {
+                apdDuration = std::chrono::duration_cast<std::chrono::milliseconds>(anomalyBatchEnd - apdBatchStart).count();
+            }
+        }
+        
+        // ===== 일반 INS 패턴 처리 마무리 (남은 패턴은 현재 스레드에서 처리) =====
+        drainInsPatterns();
+        insHelpersDone.acquire(insHelpers);
+        insHelpers = 0;
+
+        // 남은 FID 결과 기록 후 INS 결과를 검사 순서대로 병합 및 로그 출력
+        for (int fidSlot = 0; fidSlot < fidCount; fidSlot++)
+            commitFid(fidSlot);
+        for (int order = 0; order < insPatternCount; order++)
+        {
+            result.merge(insSlots[order]);
+            if (!insSummaries[order].isEmpty()) {
+                logDebug(insSummaries[order]);
             }
-            
-            logDebug(resultDetail);
-
-            // 전체 결과 갱신
-            result.isPassed = result.isPassed && inspPassed;
-            // qDebug() << "[INS 검사]" << pattern.name << "결과:" << inspPassed << "→ 전체 result.isPassed =" << result.isPassed;
         }
     }
 
+    // INS가 없는 프레임도 FID 결과는 모두 기록, 풀에서 띄운 FID 작업 종료 대기 (지역 변수 참조)
+    for (int fidSlot = 0; fidSlot < fidCount; fidSlot++)
+        commitFid(fidSlot);
+    fidHelpersDone.acquire(fidHelpers);
+    fidHelpers = 0;
+
     // 전체 검사 결과 로그
     // FID 매칭 실패가 있는지 확인
     bool hasFidFailure = false;
@@ -2213,9 +3210,11 @@ InspectionResult InsProcessor::performInspection(const cv::Mat &image, const QLi
     return result;
 }
 
-bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &pattern,
-                                 double &score, cv::Point &matchLoc, double &matchAngle, const QList<PatternInfo> &allPatterns)
+bool InsProcessor::matchFiducial(const FrameContext &frame, const PatternInfo &pattern,
+                                 double &score, cv::Point &matchLoc, double &matchAngle, const QList<PatternInfo> &allPatterns,
+                                 cv::Point2f *subPixelLoc)
 {
+    const cv::Mat &image = frame.bgr();
 
     // 초기 점수 설정
     score = 0.0;
@@ -2236,36 +3235,9 @@ bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &patter
 
     try
     {
-        // ★ matchTemplate 사용 (RGB32 포맷 - INS와 동일)
-        QImage qimg = pattern.matchTemplate.isNull() ? pattern.templateImage : pattern.matchTemplate;
-        cv::Mat templateMat;
-
-        // QImage를 cv::Mat로 정확하게 변환 (RGB32 포맷 처리)
-        if (qimg.format() == QImage::Format_RGB32)
-        {
-            // RGB32 포맷인 경우 직접 변환 (4채널 -> 3채널)
-            cv::Mat temp(qimg.height(), qimg.width(), CV_8UC4,
-                        (void *)qimg.constBits(), qimg.bytesPerLine());
-            cv::cvtColor(temp, templateMat, cv::COLOR_RGBA2BGR);
-        }
-        else if (qimg.format() == QImage::Format_RGB888)
-        {
-            // RGB888 포맷인 경우 직접 변환
-            templateMat = cv::Mat(qimg.height(), qimg.width(), CV_8UC3,
-                                  (void *)qimg.constBits(), qimg.bytesPerLine())
-                              .clone();
-            // RGB를 BGR로 변환 (OpenCV는 BGR 사용)
-            cv::cvtColor(templateMat, templateMat, cv::COLOR_RGB2BGR);
-        }
-        else
-        {
-            // 다른 포맷인 경우 RGB888로 변환 후 처리
-            qimg = qimg.convertToFormat(QImage::Format_RGB888);
-            templateMat = cv::Mat(qimg.height(), qimg.width(), CV_8UC3,
-                                  (void *)qimg.constBits(), qimg.bytesPerLine())
-                              .clone();
-            cv::cvtColor(templateMat, templateMat, cv::COLOR_RGB2BGR);
-        }
+        // ★ matchTemplate 사용 (RGB32 포맷 - INS와 동일), 디코딩 결과는 캐시에서 재사용
+        auto matchTmpl = acquireTemplate(pattern, TemplateUsage::Matching);
+        cv::Mat templateMat = matchTmpl ? matchTmpl->bgr : cv::Mat();
 
         // 템플릿 이미지 유효성 확인
         if (templateMat.empty())
@@ -2362,35 +3334,56 @@ bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &patter
             return false;
         }
 
-        // 검색 영역 추출
-        cv::Mat roi = image(searchRoi).clone();
+        // ★ 추적 모드: 직전에 합격한 위치/각도 주변 작은 창을 먼저 검색 (점수 미달이면 아래 전체 검색)
+        const QPair<int, QUuid> trackKey(pattern.frameIndex, pattern.id);
+        bool trackingEnabled = fidTrackingEnabled.load();
+        if (trackingEnabled)
+        {
+            FidTrack track;
+            bool hasTrack = false;
+            {
+                QMutexLocker locker(&trackMutex);
+                auto it = fidTracks.constFind(trackKey);
+                if (it != fidTracks.constEnd())
+                {
+                    track = *it;
+                    hasTrack = true;
+                }
+            }
 
-        // **수정**: 템플릿은 티칭할 때 저장된 원본 그대로 사용 (검사 시 갱신하지 않음)
-        cv::Mat processedTemplate = templateMat.clone();
+            cv::Point2f trackedLoc;
+            if (hasTrack && trackFiducial(frame.gray(), pattern, *matchTmpl, searchRoi, track,
+                                          score, matchLoc, matchAngle, trackedLoc))
+            {
+                if (subPixelLoc)
+                    *subPixelLoc = trackedLoc;
+                QMutexLocker locker(&trackMutex);
+                fidTracks[trackKey] = FidTrack{trackedLoc, matchAngle - pattern.angle};
+                return true;
+            }
+        }
+
+        // 검색 영역 추출 (프레임 공용 흑백 평면에서 복사 없이, 매칭은 흑백으로 수행)
+        cv::Mat roi = frame.grayRegion(searchRoi);
 
-        // FID는 마스크를 사용하지 않음 (속도 최적화)
-        cv::Mat maskMat; // 빈 마스크
+        // **수정**: 템플릿은 티칭할 때 저장된 원본 그대로 사용 (검사 시 갱신하지 않음)
+        const cv::Mat& processedTemplate = templateMat;
 
         // FID는 필터를 사용하지 않음 (원본 이미지로만 매칭)
 
         // 매칭 수행
         bool matched = false;
         cv::Point localMatchLoc; // ROI 내에서의 매칭 위치
+        cv::Point2f localSubPixelLoc(-1.0f, -1.0f); // ROI 내에서의 서브픽셀 매칭 위치
         double tempAngle = 0.0;  // 임시 각도 변수 (switch 밖에서 선언)
 
-        // 회전 매칭 파라미터 설정
-        double tmplMinA = 0.0, tmplMaxA = 0.0, tmplStep = 1.0;
-        if (pattern.useRotation)
-        {
-            tmplMinA = pattern.minAngle;
-            tmplMaxA = pattern.maxAngle;
-            tmplStep = pattern.angleStep;
-        }
+        // 회전 매칭 파라미터 설정 (FID는 마스크 없이 매칭 - 속도 최적화)
+        const RotationSearch search = rotationSearchFor(pattern, *matchTmpl);
 
         // fidMatchMethod: 0=Coefficient (TM_CCOEFF_NORMED), 1=Correlation (TM_CCORR_NORMED)
-        // FID는 마스크 없이 매칭 (속도 최적화)
         matched = performTemplateMatching(roi, processedTemplate, localMatchLoc, score, tempAngle,
-                                          pattern, tmplMinA, tmplMaxA, tmplStep, maskMat);
+                                          pattern, search.minAngle, search.maxAngle, search.angleStep,
+                                          search.mask, &localSubPixelLoc);
 
         // 회전 매칭이 적용된 경우 탐지된 각도 사용
         if (pattern.useRotation && matched)
@@ -2411,6 +3404,15 @@ bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &patter
             matchLoc.x = searchRoi.x + localMatchLoc.x;
             matchLoc.y = searchRoi.y + localMatchLoc.y;
 
+            // 서브픽셀 위치 (보정되지 않았으면 정수 위치)
+            if (subPixelLoc)
+            {
+                if (localSubPixelLoc.x >= 0.0f)
+                    *subPixelLoc = cv::Point2f(searchRoi.x + localSubPixelLoc.x, searchRoi.y + localSubPixelLoc.y);
+                else
+                    *subPixelLoc = cv::Point2f(static_cast<float>(matchLoc.x), static_cast<float>(matchLoc.y));
+            }
+
             // 회전 매칭이 활성화된 경우 검출된 각도를 사용
             matchAngle = tempAngle;
         }
@@ -2418,6 +3420,14 @@ bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &patter
         // 매칭 임계값과 비교
         if (matched && (score * 100.0) >= pattern.matchThreshold)
         { // score(0-1)를 100% 단위로 변환하여 비교
+            if (trackingEnabled)
+            {
+                cv::Point2f trackedLoc = localSubPixelLoc.x >= 0.0f
+                    ? cv::Point2f(searchRoi.x + localSubPixelLoc.x, searchRoi.y + localSubPixelLoc.y)
+                    : cv::Point2f(matchLoc.x, matchLoc.y);
+                QMutexLocker locker(&trackMutex);
+                fidTracks[trackKey] = FidTrack{trackedLoc, matchAngle - pattern.angle};
+            }
             return true;
         }
         else
@@ -2428,19 +3438,139 @@ bool InsProcessor::matchFiducial(const cv::Mat &image, const PatternInfo &patter
     }
     catch (const cv::Exception &e)
     {
-        logDebug(QString("FID 매칭 중 OpenCV 예외 발생: %1").arg(e.what()));
-        return false;
-    }
-    catch (const std::exception &e)
-    {
-        logDebug(QString("FID 매칭 중 일반 예외 발생: %1").arg(e.what()));
+        logDebug(QString("FID 매칭 중 OpenCV 예외 발생: %1").arg(e.what()));
+        return false;
+    }
+    catch (const std::exception &e)
+    {
+        logDebug(QString("FID 매칭 중 일반 예외 발생: %1").arg(e.what()));
+        return false;
+    }
+    catch (...)
+    {
+        logDebug("FID 매칭 중 알 수 없는 예외 발생");
+        return false;
+    }
+}
+
+// 직전 위치/각도 주변 작은 창에서 FID 검색
+// 직전 각도의 뱅크 템플릿에서 시작해 점수가 오르는 이웃 각도로만 이동한 뒤 서브픽셀/서브각도 보정
+bool InsProcessor::trackFiducial(const cv::Mat &image, const PatternInfo &pattern, const CachedTemplate &templ,
+                                 const cv::Rect &searchRoi, const FidTrack &track,
+                                 double &score, cv::Point &matchLoc, double &matchAngle, cv::Point2f &subPixelLoc)
+{
+    // matchFiducial 전체 검색과 같은 뱅크 (캐시 재사용)
+    const RotationSearch search = rotationSearchFor(pattern, templ);
+    std::shared_ptr<const RotatedTemplateBank> bank = acquireRotationBank(
+        pattern, templ.bgr, templ.gray, search.mask, search.minAngle, search.maxAngle, search.angleStep);
+    const int count = static_cast<int>(bank->full.size());
+
+    // 직전 각도와 가장 가까운 뱅크 인덱스
+    int startIndex = bank->zeroIndex;
+    for (int i = 0; i < count; i++)
+    {
+        if (std::abs(bank->full[i].relativeAngle - track.relativeAngle) <
+            std::abs(bank->full[startIndex].relativeAngle - track.relativeAngle))
+            startIndex = i;
+    }
+
+    // 추적 창: 회전 템플릿(대각선 크기)이 모두 들어가도록 + 여유, 전체 검색 영역 안으로 제한
+    int half = static_cast<int>(std::ceil(std::sqrt(double(templ.gray.cols * templ.gray.cols +
+                                                          templ.gray.rows * templ.gray.rows)) / 2.0)) +
+               TRACK_SEARCH_MARGIN;
+    cv::Rect window(static_cast<int>(std::lround(track.location.x)) - half,
+                    static_cast<int>(std::lround(track.location.y)) - half, half * 2, half * 2);
+    window &= searchRoi;
+    if (window.empty())
+        return false;
+
+    cv::Mat windowGray;
+    if (image.channels() == 3)
+        cv::cvtColor(image(window), windowGray, cv::COLOR_BGR2GRAY);
+    else
+        windowGray = image(window);
+
+    // 형상 매칭은 추적 창 안에서 같은 형상 검색 수행
+    if (pattern.fidMatchMethod == 2)
+    {
+        cv::Point localLoc;
+        cv::Point2f localSubPixelLoc;
+        double localScore = 0.0;
+        double localAngle = 0.0;
+        if (!performShapeMatching(windowGray, *bank, pattern, localLoc, localScore, localAngle, &localSubPixelLoc) ||
+            localScore * 100.0 < pattern.matchThreshold)
+            return false;
+
+        score = localScore;
+        matchLoc = cv::Point(window.x + localLoc.x, window.y + localLoc.y);
+        matchAngle = localAngle;
+        subPixelLoc = cv::Point2f(window.x + localSubPixelLoc.x, window.y + localSubPixelLoc.y);
+        return true;
+    }
+
+    int matchMethod = (pattern.fidMatchMethod == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+
+    double bestScore = -1.0;
+    int bestIndex = startIndex;
+    cv::Point bestLocation;
+    std::vector<bool> tested(count, false);
+
+    auto matchAngleAt = [&](int index)
+    {
+        tested[index] = true;
+        const RotatedTemplate &entry = bank->full[index];
+        cv::Mat result;
+        if (!computeMatchMap(windowGray, entry, matchMethod, result))
+            return;
+
+        double maxVal;
+        cv::Point maxLoc;
+        cv::minMaxLoc(result, nullptr, &maxVal, nullptr, &maxLoc);
+        if (maxVal > bestScore)
+        {
+            bestScore = maxVal;
+            bestIndex = index;
+            bestLocation.x = static_cast<int>(maxLoc.x + entry.templ.cols / 2.0 + 0.5);
+            bestLocation.y = static_cast<int>(maxLoc.y + entry.templ.rows / 2.0 + 0.5);
+        }
+    };
+
+    try
+    {
+        matchAngleAt(startIndex);
+        if (pattern.useRotation)
+        {
+            int current = -1;
+            while (current != bestIndex)
+            {
+                current = bestIndex;
+                for (int neighbor : {current - 1, current + 1})
+                {
+                    if (neighbor >= 0 && neighbor < count && !tested[neighbor])
+                        matchAngleAt(neighbor);
+                }
+            }
+        }
+    }
+    catch (const cv::Exception &e)
+    {
+        logDebug(QString("FID 패턴 '%1': 추적 매칭 오류 - %2").arg(pattern.name).arg(e.what()));
         return false;
     }
-    catch (...)
-    {
-        logDebug("FID 매칭 중 알 수 없는 예외 발생");
+
+    if (bestScore * 100.0 < pattern.matchThreshold)
         return false;
-    }
+
+    cv::Point2f refinedLoc;
+    double relativeAngle = 0.0;
+    refineMatchPeak(windowGray, *bank, matchMethod, bestIndex, bestLocation, pattern.useRotation,
+                    refinedLoc, relativeAngle);
+
+    score = bestScore;
+    matchLoc = cv::Point(window.x + bestLocation.x, window.y + bestLocation.y);
+    matchAngle = pattern.angle + relativeAngle;
+    subPixelLoc = cv::Point2f(window.x + refinedLoc.x, window.y + refinedLoc.y);
+    return true;
 }
 
 // 패턴 정보를 받는 템플릿 매칭 함수 (헤더에 선언된 버전)
@@ -2448,7 +3578,7 @@ bool InsProcessor::performTemplateMatching(const cv::Mat &image, const cv::Mat &
                                            cv::Point &matchLoc, double &score, double &angle,
                                            const PatternInfo &pattern,
                                            double minAngle, double maxAngle, double angleStep,
-                                           const cv::Mat &mask)
+                                           const cv::Mat &mask, cv::Point2f *subPixelLoc)
 {
 
     if (image.empty() || templ.empty())
@@ -2463,379 +3593,510 @@ bool InsProcessor::performTemplateMatching(const cv::Mat &image, const cv::Mat &
     if (image.channels() == 3)
         cv::cvtColor(image, imageGray, cv::COLOR_BGR2GRAY);
     else
-        image.copyTo(imageGray);
+        imageGray = image;
 
     if (templ.channels() == 3)
         cv::cvtColor(templ, templGray, cv::COLOR_BGR2GRAY);
     else
-        templ.copyTo(templGray);
+        templGray = templ;
 
-    if (!pattern.useRotation)
+    const cv::Mat validMask = (!mask.empty() && mask.size() == templGray.size()) ? mask : cv::Mat();
+
+    // 매칭 메트릭 선택: 0=Coefficient, 1=Correlation, 2=Shape (에지 그래디언트, 아래에서 분기)
+    // FID: fidMatchMethod, INS: patternMatchMethod 사용 (통합)
+    int methodValue = (pattern.type == PatternType::FID) ? pattern.fidMatchMethod : pattern.patternMatchMethod;
+    int matchMethod = (methodValue == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+
+    // 회전 템플릿 뱅크 (레시피 로드 시 미리 생성됨, 회전 미사용이면 티칭 각도 하나)
+    std::shared_ptr<const RotatedTemplateBank> bank = acquireRotationBank(
+        pattern, templ, templGray, validMask,
+        pattern.useRotation ? minAngle : 0.0, pattern.useRotation ? maxAngle : 0.0, angleStep);
+
+    // ★ 형상(에지 그래디언트) 매칭: 조명 변화에 강하고 넓은 검색 영역에서 빠름
+    if (methodValue == 2)
     {
-        // 회전 허용 안함: 원본 템플릿 그대로 매칭
+        return performShapeMatching(imageGray, *bank, pattern, matchLoc, score, angle, subPixelLoc);
+    }
 
-        cv::Mat templateForMatching = templGray.clone();
+    // ★ 피라미드 매칭: 축소 영상에서 전체 검색 후 상위 후보만 원본 해상도 작은 창에서 정밀 검색
+    if (pyramidMatchingEnabled.load() && bank->pyramidLevel > 0 &&
+        pyramidWorthwhile(templGray.size(), imageGray.size()))
+    {
+        return performPyramidMatching(imageGray, *bank, pattern, matchMethod, matchLoc, score, angle, subPixelLoc);
+    }
 
-        // 매칭 메트릭 선택: 0=Coefficient, 1=Correlation
-        // FID: fidMatchMethod, INS: patternMatchMethod 사용 (통합)
-        int methodValue = (pattern.type == PatternType::FID) ? pattern.fidMatchMethod : pattern.patternMatchMethod;
-        int matchMethod = (methodValue == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+    // FFT 백엔드용 검색 영상 스펙트럼 (모든 각도에서 공유, FFT를 쓸 때만 처음 한 번 계산)
+    SearchSpectrum searchSpectrum;
 
+    if (!pattern.useRotation)
+    {
+        // 회전 허용 안함: 원본 템플릿 그대로 매칭
+        const RotatedTemplate &entry = bank->full[bank->zeroIndex];
         cv::Mat result;
-        
-        // ★ 마스크가 있으면 마스크를 사용한 매칭
-        if (!mask.empty() && mask.size() == templGray.size())
-        {
-            cv::matchTemplate(imageGray, templateForMatching, result, matchMethod, mask);
-        }
-        else
+        if (!computeMatchMap(imageGray, entry, matchMethod, result, matchBackend.load(), &searchSpectrum))
         {
-            cv::matchTemplate(imageGray, templateForMatching, result, matchMethod);
+            score = 0.0;
+            return false;
         }
 
-        double minVal, maxVal;
-        cv::Point minLoc, maxLoc;
-        cv::minMaxLoc(result, &minVal, &maxVal, &minLoc, &maxLoc);
+        double maxVal;
+        cv::Point maxLoc;
+        cv::minMaxLoc(result, nullptr, &maxVal, nullptr, &maxLoc);
 
         // 템플릿 매칭은 왼쪽 상단 좌표를 반환하므로, 중심점을 계산
-        matchLoc.x = static_cast<int>(maxLoc.x + templateForMatching.cols / 2.0 + 0.5);
-        matchLoc.y = static_cast<int>(maxLoc.y + templateForMatching.rows / 2.0 + 0.5);
+        matchLoc.x = static_cast<int>(maxLoc.x + entry.templ.cols / 2.0 + 0.5);
+        matchLoc.y = static_cast<int>(maxLoc.y + entry.templ.rows / 2.0 + 0.5);
         score = maxVal;
         angle = pattern.angle; // 패턴에 저장된 각도 그대로 반환
 
+        // 서브픽셀 위치 보정 (각도 보정 없음)
+        if (subPixelLoc)
+        {
+            double relativeAngle = 0.0;
+            refineMatchPeak(imageGray, *bank, matchMethod, bank->zeroIndex, matchLoc, false, *subPixelLoc, relativeAngle);
+        }
+
         return true;
     }
 
-    // 회전 허용: 티칭 각도를 기준으로 +/- 범위에서 모든 각도 시도
+    // 회전 허용: 티칭 각도를 기준으로 +/- 범위의 미리 회전된 템플릿으로 2단계 검색 + 조기 종료
+    double bestScore = -1.0;
+    int bestIndex = bank->zeroIndex;
+    cv::Point bestLocation;
+    std::vector<bool> tested(bank->full.size(), false);
+
+    // 각도 하나 매칭 후 최고 점수 갱신
+    auto matchAngleAt = [&](int index) -> double
+    {
+        tested[index] = true;
+        const RotatedTemplate &entry = bank->full[index];
+        double currentAngle = pattern.angle + entry.relativeAngle;
 
-    // 티칭 각도 기준으로 상대 범위 적용
-    double adjustedMinAngle = pattern.angle + minAngle;
-    double adjustedMaxAngle = pattern.angle + maxAngle;
+        cv::Mat result;
+        try
+        {
+            if (!computeMatchMap(imageGray, entry, matchMethod, result, matchBackend.load(), &searchSpectrum))
+            {
+                logDebug(QString("각도 %1°: 템플릿이 이미지보다 크거나 비어있음 (템플릿:%2x%3, 이미지:%4x%5)")
+                             .arg(currentAngle)
+                             .arg(entry.templ.cols)
+                             .arg(entry.templ.rows)
+                             .arg(imageGray.cols)
+                             .arg(imageGray.rows));
+                return -1.0;
+            }
+        }
+        catch (const cv::Exception &e)
+        {
+            logDebug(QString("각도 %1°: 템플릿 매칭 오류 - %2").arg(currentAngle).arg(e.what()));
+            return -1.0;
+        }
 
-    // 템플릿의 원본 크기 저장
-    int originalWidth = templGray.cols;
-    int originalHeight = templGray.rows;
+        // 최대값과 위치 찾기
+        double maxVal;
+        cv::Point maxLoc;
+        cv::minMaxLoc(result, nullptr, &maxVal, nullptr, &maxLoc);
 
-    // 회전 시 잘림 방지를 위해 여백이 있는 더 큰 이미지 생성
-    int diagonal = static_cast<int>(std::sqrt(originalWidth * originalWidth +
-                                              originalHeight * originalHeight));
-    int offsetX = (diagonal - originalWidth) / 2;
-    int offsetY = (diagonal - originalHeight) / 2;
+        if (maxVal > bestScore)
+        {
+            bestScore = maxVal;
+            bestIndex = index;
+            bestLocation.x = static_cast<int>(maxLoc.x + entry.templ.cols / 2.0 + 0.5);
+            bestLocation.y = static_cast<int>(maxLoc.y + entry.templ.rows / 2.0 + 0.5);
+        }
+        return maxVal;
+    };
 
-    cv::Mat paddedTempl = cv::Mat::zeros(diagonal, diagonal, templGray.type());
-    cv::Rect roi(offsetX, offsetY, originalWidth, originalHeight);
-    templGray.copyTo(paddedTempl(roi));
-    
-    // ★ 마스크도 동일하게 패딩 처리
-    cv::Mat paddedMask;
-    if (!mask.empty() && mask.size() == templGray.size())
+    // === 1단계: 티칭 각도 + 5도 간격 빠른 검색 ===
+    bool earlyExit = false;
+    for (int index : coarseAngleIndices(*bank))
     {
-        paddedMask = cv::Mat::zeros(diagonal, diagonal, CV_8UC1);
-        mask.copyTo(paddedMask(roi));
+        // 조기 종료: 95% 이상 점수면 검색 중단
+        if (matchAngleAt(index) >= 0.95)
+        {
+            earlyExit = true;
+            break;
+        }
     }
 
-    // 최적 매칭을 위한 변수들
-    double bestScore = -1.0;
-    double bestAngle = adjustedMinAngle;
-    cv::Point bestLocation;
-    cv::Mat bestTemplate; // 최고 점수를 얻은 템플릿 저장용
-    cv::Mat bestMask;     // 최고 점수를 얻은 마스크 저장용
-
-    // 각도 범위 내에서 최적 매칭 검색
-    // 각도 리스트 생성: 2단계 적응적 검색 + 조기 종료
-    std::vector<double> angleList;
-
-    // 1. 티칭 각도를 첫 번째로 추가 (가장 우선)
-    angleList.push_back(pattern.angle);
-
-    // 2. 1단계: 큰 스텝(5도)으로 빠른 검색을 위한 각도 추가
-    std::vector<double> coarseAngles;
-    for (double currentAngle = adjustedMinAngle; currentAngle <= adjustedMaxAngle; currentAngle += 5.0)
+    // === 2단계: 1단계 최적 각도에서 점수가 오르는 이웃 각도로 한 칸씩 이동 (+/-3도 이내) ===
+    // 범위 전체를 훑지 않고 봉우리만 찾은 뒤 3단계 보간으로 각도를 보정한다.
+    if (!earlyExit)
     {
-        if (std::abs(currentAngle - pattern.angle) >= 2.5)
-        { // 티칭 각도와 충분히 떨어진 경우만
-            coarseAngles.push_back(currentAngle);
+        const int count = static_cast<int>(bank->full.size());
+        const double coarseAngle = bank->full[bestIndex].relativeAngle;
+        int current = -1;
+        while (current != bestIndex)
+        {
+            current = bestIndex;
+            for (int neighbor : {current - 1, current + 1})
+            {
+                if (neighbor < 0 || neighbor >= count || tested[neighbor])
+                    continue;
+                if (std::abs(bank->full[neighbor].relativeAngle - coarseAngle) > FINE_ANGLE_RANGE + 1e-6)
+                    continue;
+                matchAngleAt(neighbor);
+            }
         }
     }
 
-    // === 1단계: 티칭 각도 + 5도 간격 빠른 검색 ===
+    // 결과 반환
+    matchLoc = bestLocation;
+    score = bestScore;
+    angle = pattern.angle + bank->full[bestIndex].relativeAngle;
+
+    // === 3단계: 서브픽셀 위치 + 이웃 각도 포물선 보간 ===
+    if (bestScore > 0.0)
+    {
+        cv::Point2f refinedLoc;
+        double relativeAngle = 0.0;
+        refineMatchPeak(imageGray, *bank, matchMethod, bestIndex, bestLocation, true, refinedLoc, relativeAngle);
+        angle = pattern.angle + relativeAngle;
+        if (subPixelLoc)
+            *subPixelLoc = refinedLoc;
+    }
 
-    double bestCoarseScore = -1.0;
-    double bestCoarseAngle = pattern.angle;
-    cv::Point bestCoarseLocation;
+    return bestScore > 0.0;
+}
 
-    // 첫 번째로 티칭 각도 시도
-    angleList.clear();
-    angleList.push_back(pattern.angle);
+bool InsProcessor::performPyramidMatching(const cv::Mat &imageGray, const RotatedTemplateBank &bank,
+                                          const PatternInfo &pattern, int matchMethod,
+                                          cv::Point &matchLoc, double &score, double &angle,
+                                          cv::Point2f *subPixelLoc)
+{
+    // === 1단계: 축소 영상에서 1단계 각도 전체 검색 ===
+    const int scale = 1 << bank.pyramidLevel;
+    cv::Mat coarseImage = pyramidDown(imageGray, bank.pyramidLevel);
 
-    // 1단계 각도들 추가
-    for (double angle : coarseAngles)
+    std::vector<MatchPeak> coarsePeaks;
+    SearchSpectrum coarseSpectrum;  // 축소 영상 스펙트럼 (FFT 사용 시 모든 각도에서 공유)
+    for (int index : coarseAngleIndices(bank))
     {
-        angleList.push_back(angle);
+        const RotatedTemplate &entry = bank.coarse[index];
+        cv::Mat result;
+        try
+        {
+            if (!computeMatchMap(coarseImage, entry, matchMethod, result, matchBackend.load(), &coarseSpectrum))
+                continue;
+        }
+        catch (const cv::Exception &e)
+        {
+            logDebug(QString("피라미드 매칭 각도 %1°: 템플릿 매칭 오류 - %2")
+                         .arg(pattern.angle + entry.relativeAngle).arg(e.what()));
+            continue;
+        }
+        collectMatchPeaks(result, entry.templ.size(), index, PYRAMID_CANDIDATES, coarsePeaks);
     }
 
-    for (double currentAngle : angleList)
+    if (coarsePeaks.empty())
     {
-        // 티칭 각도인지 확인
-        bool isTeachingAngle = (std::abs(currentAngle - pattern.angle) < 0.01);
-
-        // 템플릿 회전
-        cv::Mat templateForMatching;
-        cv::Mat maskForMatching;  // 회전된 마스크
+        score = 0.0;
+        return false;
+    }
 
-        if (isTeachingAngle)
+    // 점수순 정렬 후 가까운 위치의 중복 후보 제거 (각도 무관)
+    std::sort(coarsePeaks.begin(), coarsePeaks.end(),
+              [](const MatchPeak &a, const MatchPeak &b) { return a.score > b.score; });
+    const cv::Mat &coarseTempl = bank.coarse[bank.zeroIndex].templ;
+    int minDistance = std::max(1, std::min(coarseTempl.cols, coarseTempl.rows) / 2);
+    std::vector<MatchPeak> candidates;
+    for (const MatchPeak &peak : coarsePeaks)
+    {
+        bool duplicated = false;
+        for (const MatchPeak &kept : candidates)
         {
-            // 티칭 각도인 경우: 원본 템플릿 그대로 사용
-            templateForMatching = templGray.clone();
-            if (!mask.empty() && mask.size() == templGray.size())
+            if (std::abs(peak.center.x - kept.center.x) < minDistance &&
+                std::abs(peak.center.y - kept.center.y) < minDistance)
             {
-                maskForMatching = mask.clone();
+                duplicated = true;
+                break;
             }
         }
-        else
-        {
-            // 다른 각도인 경우: 패딩된 템플릿을 회전
+        if (!duplicated)
+            candidates.push_back(peak);
+        if (static_cast<int>(candidates.size()) >= PYRAMID_CANDIDATES)
+            break;
+    }
+
+    // === 2단계: 후보별 원본 해상도 작은 창 + 주변 각도 정밀 검색 ===
+    double bestScore = -1.0;
+    int bestIndex = bank.zeroIndex;
+    cv::Point bestLocation;
+    const int margin = scale * 2;  // 축소 좌표 오차 여유
+    const cv::Rect imageRect(0, 0, imageGray.cols, imageGray.rows);
 
-            cv::Mat rotMatrix = cv::getRotationMatrix2D(
-                cv::Point2f(paddedTempl.cols / 2.0, paddedTempl.rows / 2.0),
-                -(currentAngle - pattern.angle), 1.0); // 상대 회전각
+    for (const MatchPeak &candidate : candidates)
+    {
+        cv::Point fullCenter(candidate.center.x * scale, candidate.center.y * scale);
+        std::vector<int> fineIndices = pattern.useRotation ? fineAngleIndices(bank, candidate.angleIndex)
+                                                           : std::vector<int>{candidate.angleIndex};
+        for (int index : fineIndices)
+        {
+            const RotatedTemplate &entry = bank.full[index];
 
-            cv::Mat rotatedTempl;
-            cv::warpAffine(paddedTempl, rotatedTempl, rotMatrix, paddedTempl.size(),
-                           cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
+            // 후보 중심 주변 작은 창 (템플릿 + 여유)
+            cv::Rect window(fullCenter.x - entry.templ.cols / 2 - margin, fullCenter.y - entry.templ.rows / 2 - margin,
+                            entry.templ.cols + margin * 2, entry.templ.rows + margin * 2);
+            window &= imageRect;
 
-            // 회전된 템플릿을 그레이스케일로 변환
-            if (rotatedTempl.channels() == 3)
+            cv::Mat result;
+            try
             {
-                cv::cvtColor(rotatedTempl, templateForMatching, cv::COLOR_BGR2GRAY);
+                if (!computeMatchMap(imageGray(window), entry, matchMethod, result))
+                    continue;
             }
-            else
+            catch (const cv::Exception &e)
             {
-                templateForMatching = rotatedTempl.clone();
+                logDebug(QString("피라미드 정밀 매칭 각도 %1°: 템플릿 매칭 오류 - %2")
+                             .arg(pattern.angle + entry.relativeAngle).arg(e.what()));
+                continue;
             }
-            
-            // ★ 마스크도 동일하게 회전
-            if (!paddedMask.empty())
+
+            double maxVal;
+            cv::Point maxLoc;
+            cv::minMaxLoc(result, nullptr, &maxVal, nullptr, &maxLoc);
+            if (maxVal > bestScore)
             {
-                cv::warpAffine(paddedMask, maskForMatching, rotMatrix, paddedMask.size(),
-                              cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
-                
-                // ★ 마스크를 이진화 (보간으로 생긴 중간값 제거)
-                cv::threshold(maskForMatching, maskForMatching, 127, 255, cv::THRESH_BINARY);
+                bestScore = maxVal;
+                bestIndex = index;
+                bestLocation.x = static_cast<int>(window.x + maxLoc.x + entry.templ.cols / 2.0 + 0.5);
+                bestLocation.y = static_cast<int>(window.y + maxLoc.y + entry.templ.rows / 2.0 + 0.5);
             }
         }
 
-        // 타입을 CV_8U로 통일
-        templateForMatching.convertTo(templateForMatching, CV_8U);
+        // 조기 종료: 95% 이상 점수면 나머지 후보 생략
+        if (bestScore >= 0.95)
+            break;
+    }
 
-        // 템플릿 크기와 이미지 크기 검증
-        if (templateForMatching.empty() || imageGray.empty())
-        {
-            logDebug(QString("각도 %1°: 템플릿 또는 이미지가 비어있음").arg(currentAngle));
-            continue;
-        }
+    matchLoc = bestLocation;
+    score = std::max(0.0, bestScore);
+    angle = pattern.angle + bank.full[bestIndex].relativeAngle;
 
-        if (templateForMatching.cols > imageGray.cols || templateForMatching.rows > imageGray.rows)
-        {
-            logDebug(QString("각도 %1°: 템플릿이 이미지보다 큼 (템플릿:%2x%3, 이미지:%4x%5)")
-                         .arg(currentAngle)
-                         .arg(templateForMatching.cols)
-                         .arg(templateForMatching.rows)
-                         .arg(imageGray.cols)
-                         .arg(imageGray.rows));
-            continue;
-        }
+    // 서브픽셀 위치 + 이웃 각도 포물선 보간
+    if (bestScore > 0.0)
+    {
+        cv::Point2f refinedLoc;
+        double relativeAngle = 0.0;
+        refineMatchPeak(imageGray, bank, matchMethod, bestIndex, bestLocation, pattern.useRotation,
+                        refinedLoc, relativeAngle);
+        angle = pattern.angle + relativeAngle;
+        if (subPixelLoc)
+            *subPixelLoc = refinedLoc;
+    }
 
-        // 매칭 메트릭 선택: 0=Coefficient, 1=Correlation
-        int methodValue = (pattern.type == PatternType::FID) ? pattern.fidMatchMethod : pattern.patternMatchMethod;
-        int matchMethod = (methodValue == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+    return bestScore > 0.0;
+}
 
-        cv::Mat result;
-        try
-        {
-            // ★ 마스크가 있으면 마스크 사용
-            if (!maskForMatching.empty() && maskForMatching.size() == templateForMatching.size())
-            {
-                // 마스크 통계 확인
-                int nonZeroPixels = cv::countNonZero(maskForMatching);
-                int totalPixels = maskForMatching.rows * maskForMatching.cols;
-                double maskRatio = (double)nonZeroPixels / totalPixels * 100.0;
-                
-                // 마스크 사용 템플릿 매칭
-                cv::matchTemplate(imageGray, templateForMatching, result, matchMethod, maskForMatching);
-            }
-            else
-            {
-                // 마스크 없이 템플릿 매칭
-                cv::matchTemplate(imageGray, templateForMatching, result, matchMethod);
-            }
-        }
-        catch (const cv::Exception &e)
-        {
-            logDebug(QString("각도 %1°: 템플릿 매칭 오류 - %2").arg(currentAngle).arg(e.what()));
-            continue;
-        }
+bool InsProcessor::performShapeMatching(const cv::Mat &imageGray, const RotatedTemplateBank &bank,
+                                        const PatternInfo &pattern, cv::Point &matchLoc, double &score,
+                                        double &angle, cv::Point2f *subPixelLoc)
+{
+    score = 0.0;
+    angle = pattern.angle;
+    if (bank.shapeFull.empty() || bank.shapeFull[bank.zeroIndex].points.empty())
+    {
+        logDebug(QString("형상 매칭 실패: 패턴 '%1' 템플릿에서 에지를 찾지 못함").arg(pattern.name));
+        return false;
+    }
 
-        if (result.empty())
-        {
-            logDebug(QString("각도 %1°: 매칭 결과가 비어있음").arg(currentAngle));
-            continue;
-        }
+    const double threshold =
+        (pattern.type == PatternType::FID ? pattern.matchThreshold : pattern.patternMatchThreshold) / 100.0;
 
-        // 최대값과 위치 찾기
-        double minVal, maxVal;
-        cv::Point minLoc, maxLoc;
-        cv::minMaxLoc(result, &minVal, &maxVal, &minLoc, &maxLoc);
+    // === 1단계: (축소) 영상 전체 위치에서 1단계 각도 검색, 후보 점수 미만 위치는 조기 종료 ===
+    const bool usePyramid = pyramidMatchingEnabled.load() && bank.pyramidLevel > 0 && !bank.shapeCoarse.empty() &&
+                            pyramidWorthwhile(bank.sourceSize, imageGray.size());
+    const int scale = usePyramid ? (1 << bank.pyramidLevel) : 1;
+    const std::vector<ShapeModel> &coarseModels = usePyramid ? bank.shapeCoarse : bank.shapeFull;
+    const ShapeGradient fullGradient = computeShapeGradient(imageGray);
+    const ShapeGradient coarseGradient =
+        usePyramid ? computeShapeGradient(pyramidDown(imageGray, bank.pyramidLevel)) : fullGradient;
+    const double coarseMinScore = threshold * SHAPE_COARSE_SCORE_RATIO;
 
-        // 1단계 최고 점수 업데이트
-        if (maxVal > bestCoarseScore)
-        {
-            bestCoarseScore = maxVal;
-            bestCoarseAngle = currentAngle;
-            bestCoarseLocation.x = static_cast<int>(maxLoc.x + templateForMatching.cols / 2.0 + 0.5);
-            bestCoarseLocation.y = static_cast<int>(maxLoc.y + templateForMatching.rows / 2.0 + 0.5);
-        }
+    const ShapeModel &zeroModel = coarseModels[bank.zeroIndex];
+    const int suppress = std::max(1, std::min(zeroModel.maxX - zeroModel.minX, zeroModel.maxY - zeroModel.minY) / 4);
 
-        // 조기 종료: 95% 이상 점수면 검색 중단
-        if (maxVal >= 0.95)
+    std::vector<MatchPeak> coarsePeaks;
+    for (int index : coarseAngleIndices(bank))
+    {
+        const ShapeModel &model = coarseModels[index];
+        cv::Rect range = shapeCenterRange(model, coarseGradient.dx.size());
+        if (model.points.empty() || range.width <= 0 || range.height <= 0)
+            continue;
+
+        cv::Mat scores(range.size(), CV_32F);
+        for (int y = 0; y < range.height; y++)
         {
-            matchLoc.x = static_cast<int>(maxLoc.x + templateForMatching.cols / 2.0 + 0.5);
-            matchLoc.y = static_cast<int>(maxLoc.y + templateForMatching.rows / 2.0 + 0.5);
-            score = maxVal;
-            angle = currentAngle;
-            return true;
+            float *scoreRow = scores.ptr<float>(y);
+            for (int x = 0; x < range.width; x++)
+                scoreRow[x] = static_cast<float>(shapeScoreAt(coarseGradient, model, range.x + x, range.y + y,
+                                                              coarseMinScore));
         }
 
-        // 전체 최고 점수도 업데이트 (2단계에서 사용)
-        if (maxVal > bestScore)
+        // 각도별 상위 피크 (찾은 피크 주변은 억제)
+        for (int i = 0; i < PYRAMID_CANDIDATES; i++)
         {
-            bestScore = maxVal;
-            bestAngle = currentAngle;
-            bestLocation.x = static_cast<int>(maxLoc.x + templateForMatching.cols / 2.0 + 0.5);
-            bestLocation.y = static_cast<int>(maxLoc.y + templateForMatching.rows / 2.0 + 0.5);
-            bestTemplate = templateForMatching.clone();
+            double maxVal;
+            cv::Point maxLoc;
+            cv::minMaxLoc(scores, nullptr, &maxVal, nullptr, &maxLoc);
+            if (maxVal < coarseMinScore)
+                break;
+
+            MatchPeak peak;
+            peak.score = maxVal;
+            peak.center = range.tl() + maxLoc;
+            peak.angleIndex = index;
+            coarsePeaks.push_back(peak);
+
+            cv::Rect around(maxLoc.x - suppress, maxLoc.y - suppress, suppress * 2 + 1, suppress * 2 + 1);
+            scores(around & cv::Rect(0, 0, scores.cols, scores.rows)).setTo(-1.0f);
         }
     }
 
-    // === 2단계: 1단계 최적 각도 주변에서 1도 간격 정밀 검색 ===
-    double fineSearchMin = bestCoarseAngle - 3.0;
-    double fineSearchMax = bestCoarseAngle + 3.0;
-
-    // 원래 범위를 벗어나지 않도록 제한
-    fineSearchMin = std::max(fineSearchMin, adjustedMinAngle);
-    fineSearchMax = std::min(fineSearchMax, adjustedMaxAngle);
+    if (coarsePeaks.empty())
+        return false;
 
-    // 2단계 각도 리스트 생성 (1단계에서 이미 시도한 각도 제외)
-    std::vector<double> fineAngles;
-    for (double currentAngle = fineSearchMin; currentAngle <= fineSearchMax; currentAngle += 1.0)
+    // 점수순 정렬 후 가까운 위치의 중복 후보 제거 (각도 무관)
+    std::sort(coarsePeaks.begin(), coarsePeaks.end(),
+              [](const MatchPeak &a, const MatchPeak &b) { return a.score > b.score; });
+    std::vector<MatchPeak> candidates;
+    for (const MatchPeak &peak : coarsePeaks)
     {
-        // 1단계에서 이미 시도한 각도가 아닌 경우만 추가
-        bool alreadyTested = false;
-        for (double testedAngle : angleList)
+        bool duplicated = false;
+        for (const MatchPeak &kept : candidates)
         {
-            if (std::abs(currentAngle - testedAngle) < 0.1)
+            if (std::abs(peak.center.x - kept.center.x) < suppress * 2 &&
+                std::abs(peak.center.y - kept.center.y) < suppress * 2)
             {
-                alreadyTested = true;
+                duplicated = true;
                 break;
             }
         }
-        if (!alreadyTested)
-        {
-            fineAngles.push_back(currentAngle);
-        }
+        if (!duplicated)
+            candidates.push_back(peak);
+        if (static_cast<int>(candidates.size()) >= PYRAMID_CANDIDATES)
+            break;
     }
 
-    for (double currentAngle : fineAngles)
-    {
-        // 티칭 각도인지 확인 (거의 없겠지만)
-        bool isTeachingAngle = (std::abs(currentAngle - pattern.angle) < 0.01);
+    // === 2단계: 후보별 원본 해상도 작은 창 + 이웃 각도 언덕 오르기 ===
+    // 창 안의 조기 종료 기준은 그 각도의 창 최고점뿐이므로 각도별 반환값(창 최고점)은 정확한 점수다.
+    // (전역 최고점으로 끊으면 두 번째 후보부터 잘린 부분합끼리 비교해 언덕 오르기가 일찍 멈춤)
+    const int count = static_cast<int>(bank.shapeFull.size());
+    const int margin = scale * 2;
+    double bestScore = -1.0;
+    int bestIndex = bank.zeroIndex;
+    cv::Point bestCenter;
 
-        // 템플릿 회전
-        cv::Mat templateForMatching;
+    auto searchWindow = [&](int index, const cv::Point &center) -> double
+    {
+        const ShapeModel &model = bank.shapeFull[index];
+        cv::Rect window(center.x - margin, center.y - margin, margin * 2 + 1, margin * 2 + 1);
+        window &= shapeCenterRange(model, fullGradient.dx.size());
 
-        if (isTeachingAngle)
-        {
-            // 티칭 각도인 경우: 원본 템플릿 그대로 사용
-            templateForMatching = templGray.clone();
-        }
-        else
+        double angleBest = -1.0;
+        for (int y = window.y; y < window.y + window.height; y++)
         {
-            // 다른 각도인 경우: 패딩된 템플릿을 회전
-            cv::Mat rotMatrix = cv::getRotationMatrix2D(
-                cv::Point2f(paddedTempl.cols / 2.0, paddedTempl.rows / 2.0),
-                -(currentAngle - pattern.angle), 1.0); // 상대 회전각
-
-            cv::Mat rotatedTempl;
-            cv::warpAffine(paddedTempl, rotatedTempl, rotMatrix, paddedTempl.size(),
-                           cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0));
-
-            // 회전된 템플릿을 그레이스케일로 변환
-            if (rotatedTempl.channels() == 3)
-            {
-                cv::cvtColor(rotatedTempl, templateForMatching, cv::COLOR_BGR2GRAY);
-            }
-            else
+            for (int x = window.x; x < window.x + window.width; x++)
             {
-                templateForMatching = rotatedTempl.clone();
+                double value = shapeScoreAt(fullGradient, model, x, y, angleBest);
+                if (value <= angleBest)
+                    continue;  // 조기 종료된 부분합 포함 - 창 최고점을 넘지 못함
+                angleBest = value;
+                // 전역 최고점 교체 여부는 정확한 점수로만 판단
+                if (value > bestScore)
+                {
+                    bestScore = value;
+                    bestIndex = index;
+                    bestCenter = cv::Point(x, y);
+                }
             }
         }
+        return angleBest;
+    };
 
-        // 타입을 CV_8U로 통일
-        templateForMatching.convertTo(templateForMatching, CV_8U);
+    for (const MatchPeak &candidate : candidates)
+    {
+        cv::Point center(candidate.center.x * scale, candidate.center.y * scale);
+        std::vector<bool> tested(count, false);
+        int localIndex = candidate.angleIndex;
+        double localScore = -1.0;
 
-        // 템플릿 크기와 이미지 크기 검증
-        if (templateForMatching.empty() || imageGray.empty())
+        auto evaluate = [&](int index)
         {
-            continue;
-        }
+            tested[index] = true;
+            double value = searchWindow(index, center);
+            if (value > localScore)
+            {
+                localScore = value;
+                localIndex = index;
+            }
+        };
 
-        if (templateForMatching.cols > imageGray.cols || templateForMatching.rows > imageGray.rows)
+        evaluate(candidate.angleIndex);
+        if (pattern.useRotation)
         {
-            continue;
+            int current = -1;
+            while (current != localIndex)
+            {
+                current = localIndex;
+                for (int neighbor : {current - 1, current + 1})
+                {
+                    if (neighbor >= 0 && neighbor < count && !tested[neighbor])
+                        evaluate(neighbor);
+                }
+            }
         }
 
-        // 매칭 메트릭 선택: 0=Coefficient, 1=Correlation
-        int methodValue = (pattern.type == PatternType::FID) ? pattern.fidMatchMethod : pattern.patternMatchMethod;
-        int matchMethod = (methodValue == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+        // 조기 종료: 95% 이상 점수면 나머지 후보 생략
+        if (bestScore >= 0.95)
+            break;
+    }
 
-        cv::Mat result;
-        try
-        {
-            // FID 패턴 매칭은 마스크 없이 수행
-            cv::matchTemplate(imageGray, templateForMatching, result, matchMethod);
-        }
-        catch (const cv::Exception &e)
-        {
-            continue;
-        }
+    if (bestScore <= 0.0)
+        return false;
+
+    matchLoc = bestCenter;
+    score = bestScore;
+    angle = pattern.angle + bank.full[bestIndex].relativeAngle;
 
-        if (result.empty())
+    // === 3단계: 3x3 점수 2차 곡면으로 서브픽셀 위치, 이웃 각도 포물선으로 서브각도 보정 ===
+    const cv::Size imageSize = fullGradient.dx.size();
+    auto scoreAround = [&](const ShapeModel &model, cv::Mat &around)
+    {
+        cv::Rect valid = shapeCenterRange(model, imageSize);
+        around = cv::Mat(3, 3, CV_32F, cv::Scalar(-1.0f));
+        for (int dy = -1; dy <= 1; dy++)
         {
-            continue;
+            for (int dx = -1; dx <= 1; dx++)
+            {
+                cv::Point position(bestCenter.x + dx, bestCenter.y + dy);
+                if (valid.contains(position))
+                    around.at<float>(dy + 1, dx + 1) =
+                        static_cast<float>(shapeScoreAt(fullGradient, model, position.x, position.y, -1.0));
+            }
         }
+    };
 
-        // 최대값과 위치 찾기
-        double minVal, maxVal;
-        cv::Point minLoc, maxLoc;
-        cv::minMaxLoc(result, &minVal, &maxVal, &minLoc, &maxLoc);
+    cv::Mat around;
+    scoreAround(bank.shapeFull[bestIndex], around);
+    cv::Point2f offset = quadraticPeakOffset(around, cv::Point(1, 1));
+    if (subPixelLoc)
+        *subPixelLoc = cv::Point2f(bestCenter.x + offset.x, bestCenter.y + offset.y);
 
-        // 가장 높은 점수 업데이트
-        if (maxVal > bestScore)
+    if (pattern.useRotation && bestIndex > 0 && bestIndex < count - 1)
+    {
+        double neighborScores[2];
+        for (int k = 0; k < 2; k++)
         {
-            bestScore = maxVal;
-            bestAngle = currentAngle;
-            bestLocation.x = static_cast<int>(maxLoc.x + templateForMatching.cols / 2.0 + 0.5);
-            bestLocation.y = static_cast<int>(maxLoc.y + templateForMatching.rows / 2.0 + 0.5);
-            bestTemplate = templateForMatching.clone();
+            cv::Mat neighborAround;
+            scoreAround(bank.shapeFull[bestIndex - 1 + k * 2], neighborAround);
+            cv::minMaxLoc(neighborAround, nullptr, &neighborScores[k]);
         }
+        double step = bank.full[bestIndex + 1].relativeAngle - bank.full[bestIndex].relativeAngle;
+        angle += parabolaPeakOffset(neighborScores[0], bestScore, neighborScores[1]) * step;
     }
 
-    // 결과 반환
-    matchLoc = bestLocation;
-    score = bestScore;
-    angle = bestAngle;
-
-    return bestScore > 0.0;
+    return true;
 }
 
 bool InsProcessor::performFeatureMatching(const cv::Mat &image, const cv::Mat &templ,
@@ -3102,8 +4363,11 @@ bool InsProcessor::performFeatureMatching(const cv::Mat &image, const cv::Mat &t
 }
 
 // SSIM (Structural Similarity Index) 검사
-bool InsProcessor::checkSSIM(const cv::Mat &image, const PatternInfo &pattern, double &score, InspectionResult &result)
+bool InsProcessor::checkSSIM(const FrameContext &frame, const PatternInfo &pattern, double &score, InspectionResult &result)
 {
+    // SSIM은 흑백으로 비교하므로 필터가 없으면 프레임 공용 흑백 평면에서 바로 추출 (ROI별 재변환 없음)
+    // 필터는 컬러 입력을 전제로 하므로 필터가 있으면 기존처럼 BGR에서 추출
+    const cv::Mat &image = hasEnabledFilter(pattern) ? frame.bgr() : frame.gray();
     QRectF rectF = pattern.rect;
     cv::Point2f center(rectF.x() + rectF.width() / 2.0f, rectF.y() + rectF.height() / 2.0f);
 
@@ -3174,42 +4438,23 @@ bool InsProcessor::checkSSIM(const cv::Mat &image, const PatternInfo &pattern, d
         currentROI = image(validRoi).clone();
     }
 
-    // 티칭 때 적용한 필터를 검사 대상 이미지에도 순서대로 적용
+    // 티칭 때 적용한 필터를 검사 대상 이미지에도 순서대로 적용 (그레이 단계 이후 1채널 유지)
     if (!pattern.filters.isEmpty())
     {
-        cv::Mat processedROI = currentROI.clone();
-        ImageProcessor processor;
-        for (const FilterInfo &filter : pattern.filters)
-        {
-            if (filter.enabled)
-            {
-                cv::Mat tempFiltered;
-                processor.applyFilter(processedROI, tempFiltered, filter);
-                if (!tempFiltered.empty())
-                {
-                    processedROI = tempFiltered.clone();
-                }
-            }
-        }
+        cv::Mat processedROI;
+        acquireFilterChain(pattern)->apply(currentROI, processedROI, FilterChain::ChannelMode::Native);
         currentROI = processedROI;
     }
 
-    // 템플릿 이미지 가져오기 (검사용 templateImage 사용)
-    QImage templateQImage = pattern.templateImage;
-    if (templateQImage.isNull())
+    // 템플릿 이미지 가져오기 (검사용 templateImage 사용, 캐시된 BGR)
+    auto inspTmpl = acquireTemplate(pattern, TemplateUsage::Inspection);
+    if (!inspTmpl || inspTmpl->bgr.empty())
     {
         logDebug(QString("SSIM 검사 실패: 검사용 템플릿 이미지 없음 - 패턴 '%1'").arg(pattern.name));
         score = 0.0;
         return false;
     }
-
-    // QImage를 cv::Mat으로 변환
-    cv::Mat templateMat;
-    QImage convertedTemplate = templateQImage.convertToFormat(QImage::Format_RGB888);
-    cv::Mat tempMat(convertedTemplate.height(), convertedTemplate.width(), CV_8UC3,
-                    const_cast<uchar *>(convertedTemplate.bits()),
-                    static_cast<size_t>(convertedTemplate.bytesPerLine()));
-    cv::cvtColor(tempMat.clone(), templateMat, cv::COLOR_RGB2BGR);
+    const cv::Mat& templateMat = inspTmpl->bgr;
 
     // 매칭에서 찾은 각도로 템플릿 회전 (새 이미지는 그대로 두고 템플릿을 회전)
     cv::Mat rotatedTemplate = templateMat;
@@ -3217,7 +4462,10 @@ bool InsProcessor::checkSSIM(const cv::Mat &image, const PatternInfo &pattern, d
     {
         cv::Point2f templateCenter(templateMat.cols / 2.0f, templateMat.rows / 2.0f);
         cv::Mat rotMat = cv::getRotationMatrix2D(templateCenter, pattern.angle, 1.0);
-        cv::warpAffine(templateMat, rotatedTemplate, rotMat, templateMat.size(), cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+        // 캐시된 템플릿과 버퍼를 공유하지 않도록 별도 Mat에 회전
+        cv::Mat rotated;
+        cv::warpAffine(templateMat, rotated, rotMat, templateMat.size(), cv::INTER_LINEAR, cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+        rotatedTemplate = rotated;
         
         logDebug(QString("SSIM: 템플릿을 %1° 회전 - 패턴 '%2'")
                      .arg(pattern.angle, 0, 'f', 2)
@@ -3451,8 +4699,9 @@ bool InsProcessor::checkSSIM(const cv::Mat &image, const PatternInfo &pattern, d
 }
 
 // ANOMALY (PatchCore) 검사
-bool InsProcessor::checkAnomaly(const cv::Mat &image, const PatternInfo &pattern, double &score, InspectionResult &result)
+bool InsProcessor::checkAnomaly(const FrameContext &frame, const PatternInfo &pattern, double &score, InspectionResult &result)
 {
+    const cv::Mat &image = frame.bgr();
     // 패턴별 PatchCore 모델 로드
     QString fullModelPath = QCoreApplication::applicationDirPath() + QString("/weights/%1/%1.xml").arg(pattern.name);
     
@@ -3634,8 +4883,11 @@ bool InsProcessor::checkAnomaly(const cv::Mat &image, const PatternInfo &pattern
     return !hasDefect;
 }
 
-bool InsProcessor::checkDiff(const cv::Mat &image, const PatternInfo &pattern, double &score, InspectionResult &result)
+bool InsProcessor::checkDiff(const FrameContext &frame, const PatternInfo &pattern, double &score, InspectionResult &result)
 {
+    // 흑백으로 비교하므로 필터가 없으면 프레임 공용 흑백 평면에서 추출 (SSIM과 동일)
+    const bool filtered = hasEnabledFilter(pattern);
+    const cv::Mat &image = filtered ? frame.bgr() : frame.gray();
     QRectF rectF = pattern.rect;
     cv::Point2f center(rectF.x() + rectF.width() / 2.0f, rectF.y() + rectF.height() / 2.0f);
 
@@ -3696,28 +4948,20 @@ bool InsProcessor::checkDiff(const cv::Mat &image, const PatternInfo &pattern, d
     }
 
     // ===== 1. 전체 영역에 필터 순차 적용 =====
-    cv::Mat processedRegion = templateRegion.clone();
+    cv::Mat processedRegion;
 
-    if (!pattern.filters.isEmpty())
+    if (filtered)
     {
         logDebug(QString("전체 영역(%1x%2)에 %3개 필터 순차 적용")
                      .arg(templateRegion.cols)
                      .arg(templateRegion.rows)
                      .arg(pattern.filters.size()));
 
-        ImageProcessor processor;
-        for (const FilterInfo &filter : pattern.filters)
-        {
-            if (filter.enabled)
-            {
-                cv::Mat tempFiltered;
-                processor.applyFilter(processedRegion, tempFiltered, filter);
-                if (!tempFiltered.empty())
-                {
-                    processedRegion = tempFiltered.clone();
-                }
-            }
-        }
+        acquireFilterChain(pattern)->apply(templateRegion, processedRegion, FilterChain::ChannelMode::Native);
+    }
+    else
+    {
+        processedRegion = templateRegion.clone();
     }
 
     // ===== 2. 전체 영역에서 그레이스케일 변환 =====
@@ -3728,7 +4972,7 @@ bool InsProcessor::checkDiff(const cv::Mat &image, const PatternInfo &pattern, d
     }
     else
     {
-        processedRegion.copyTo(processedGray);
+        processedGray = processedRegion;
     }
 
     // 템플릿 이미지가 있는지 확인
@@ -3742,34 +4986,15 @@ bool InsProcessor::checkDiff(const cv::Mat &image, const PatternInfo &pattern, d
     try
     {
 
-        // 템플릿 이미지를 Mat으로 변환
-        QImage qTemplateImage = pattern.templateImage.convertToFormat(QImage::Format_RGB888);
-        cv::Mat templateMat;
-
-        if (qTemplateImage.format() == QImage::Format_RGB888)
-        {
-            templateMat = cv::Mat(qTemplateImage.height(), qTemplateImage.width(),
-                                  CV_8UC3, const_cast<uchar *>(qTemplateImage.bits()), qTemplateImage.bytesPerLine());
-            templateMat = templateMat.clone();
-            cv::cvtColor(templateMat, templateMat, cv::COLOR_RGB2BGR);
-        }
-        else
+        // 캐시된 템플릿 그레이스케일
+        auto inspTmpl = acquireTemplate(pattern, TemplateUsage::Inspection);
+        if (!inspTmpl || inspTmpl->gray.empty())
         {
             logDebug(QString("엣지 검사 실패: 이미지 형식 변환 실패 - 패턴 '%1'").arg(pattern.name));
             score = 0.0;
             return false;
         }
-
-        // 템플릿 이미지 그레이스케일 변환
-        cv::Mat templateGray;
-        if (templateMat.channels() == 3)
-        {
-            cv::cvtColor(templateMat, templateGray, cv::COLOR_BGR2GRAY);
-        }
-        else
-        {
-            templateMat.copyTo(templateGray);
-        }
+        const cv::Mat& templateGray = inspTmpl->gray;
 
         // 크기 확인 (템플릿은 INS 영역 크기, processedGray는 전체 사각형)
         if (templateGray.size().width > processedGray.size().width ||
@@ -4005,8 +5230,11 @@ QImage InsProcessor::matToQImage(const cv::Mat &mat)
     }
 }
 
-bool InsProcessor::checkStrip(const cv::Mat &image, const PatternInfo &pattern, double &score, InspectionResult &result, const QList<PatternInfo> &patterns)
+bool InsProcessor::checkStrip(const FrameContext &frame, const PatternInfo &pattern, double &score, InspectionResult &result, const QList<PatternInfo> &patterns)
 {
+    // performStripInspection은 흑백으로 측정하므로 필터가 없으면 프레임 공용 흑백 평면에서 추출
+    const bool filtered = hasEnabledFilter(pattern);
+    const cv::Mat &image = filtered ? frame.bgr() : frame.gray();
     try
     {
         // ROI 영역 추출 (회전 고려)
@@ -4020,34 +5248,21 @@ bool InsProcessor::checkStrip(const cv::Mat &image, const PatternInfo &pattern,
         }
 
         // 추출한 ROI 전체에 필터 적용
-        if (!pattern.filters.isEmpty())
+        if (filtered)
         {
-
-            ImageProcessor processor;
-            for (const FilterInfo &filter : pattern.filters)
-            {
-                if (filter.enabled)
-                {
-                    cv::Mat nextFiltered;
-                    processor.applyFilter(roiImage, nextFiltered, filter);
-                    if (!nextFiltered.empty())
-                    {
-                        roiImage = nextFiltered.clone();
-                    }
-                }
-            }
+            // 1채널(Native) 결과는 performStripInspection이 그대로 쓰고 결과 영상만 컬러로 복원
+            cv::Mat filteredRoi;
+            acquireFilterChain(pattern)->apply(roiImage, filteredRoi, FilterChain::ChannelMode::Native);
+            roiImage = filteredRoi;
         }
 
         // 템플릿 이미지 로드
         cv::Mat templateImage;
 
-        if (!pattern.templateImage.isNull())
+        if (auto inspTmpl = acquireTemplate(pattern, TemplateUsage::Inspection))
         {
-            // QImage를 cv::Mat으로 변환
-            QImage qImg = pattern.templateImage.convertToFormat(QImage::Format_RGB888);
-            templateImage = cv::Mat(qImg.height(), qImg.width(), CV_8UC3, (void *)qImg.constBits(), qImg.bytesPerLine());
-            templateImage = templateImage.clone(); // 데이터 복사
-            cv::cvtColor(templateImage, templateImage, cv::COLOR_RGB2BGR);
+            // 캐시된 BGR 템플릿 (읽기 전용)
+            templateImage = inspTmpl->bgr;
         }
         else
         {
@@ -5284,7 +6499,7 @@ bool InsProcessor::checkStrip(const cv::Mat &image, const PatternInfo &pattern,
 }
 
 // ===== CRIMP 검사는 현재 비활성화됨 =====
-bool InsProcessor::checkCrimp(const cv::Mat &image, const PatternInfo &pattern, double &score, InspectionResult &result, const QList<PatternInfo>& patterns)
+bool InsProcessor::checkCrimp(const FrameContext &frame, const PatternInfo &pattern, double &score, InspectionResult &result, const QList<PatternInfo>& patterns)
 {
     result.insMethodTypes[pattern.id] = InspectionMethod::CRIMP;
     score = 0.0;  // 기본 점수 (0-1 범위)
@@ -3,6 +3,129 @@
 
 #include "CommonDefs.h"
 #include <QObject>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+class FilterChain;
+
+// 프레임별 검사 계획 (레시피 로드/패턴 편집 시 한 번만 해석)
+// 패턴 분류, ROI/FID/INS 계층, ANOMALY 모델 경로, 실행 순서를 미리 계산해 둔다.
+// 위치/각도 같은 형상 정보는 매 검사마다 바뀔 수 있으므로 인덱스로 patterns에서 직접 읽는다.
+struct CompiledInspectionPlan {
+    int frameIndex = -1;
+    size_t signature = 0;                       // 패턴 구성 서명 (다르면 재컴파일)
+    QString recipeName;                         // 모델 경로 계산에 사용한 레시피명
+
+    QList<int> roiOrder;                        // 활성 ROI (patterns 인덱스)
+    QList<int> fidOrder;                        // 활성 FID 매칭 순서 (patterns 인덱스)
+    QHash<QUuid, int> fidSlotById;              // FID 패턴 ID -> fidOrder 순번
+    QList<int> insOrder;                        // 일반 INS 검사 순서 (A-PC/A-PD 제외)
+    QHash<QUuid, int> indexById;                // 패턴 ID -> patterns 인덱스
+    int insCount = 0;                           // 활성 INS 개수 (A-PC/A-PD 포함)
+
+    QMap<QUuid, QUuid> patternToRoiMap;         // 패턴 ID -> 속한 ROI ID
+    QMap<QUuid, QRect> roiGroupAreas;           // ROI ID -> ROI 영역
+    QList<QRect> activeRoiRects;                // 전체 ROI 영역 목록
+    int searchRoiIndex = -1;                    // INS 패턴 매칭 검색 ROI (첫 번째 ROI, 없으면 -1)
+
+    QMap<QString, QList<int>> anomalyGroupsAPC; // 모델 경로 -> A-PC 패턴 인덱스
+    QMap<QString, QList<int>> anomalyGroupsAPD; // 모델 경로 -> A-PD 패턴 인덱스
+    int anomalyCount = 0;
+    QList<int> anomalyFidSlots;                 // ANOMALY 패턴들의 부모 FID (fidOrder 순번)
+};
+
+// 디코딩된 템플릿 캐시 항목 (패턴 ID + 템플릿 리비전 단위)
+// QImage -> cv::Mat 변환 결과를 보관해 검사 시마다 색변환/복사를 반복하지 않는다.
+// 여러 검사에서 공유되므로 사용하는 쪽에서 Mat 내용을 직접 수정하면 안 된다.
+struct CachedTemplate {
+    qint64 imageKey = 0;                        // QImage::cacheKey() (이미지가 바뀌면 달라짐)
+    qint64 maskKey = 0;                         // 마스크 QImage::cacheKey()
+    cv::Mat bgr;                                // BGR 3채널
+    cv::Mat gray;                               // 그레이스케일
+    cv::Mat mask;                               // 매칭 마스크 (없으면 empty)
+};
+
+// FFT 상관용 템플릿 스펙트럼 (DFT 크기별 하나만 보관, 검색 영역 크기가 바뀌면 다시 계산)
+struct TemplateSpectrum {
+    QMutex mutex;
+    cv::Size dftSize;
+    bool zeroMean = false;                      // TM_CCOEFF_NORMED용 (평균을 뺀 템플릿)
+    cv::Mat spectrum;                           // DFT 크기로 0 패딩한 템플릿의 복소 스펙트럼
+    double normSq = 0.0;                        // (평균을 뺀) 템플릿 제곱합
+};
+
+// 미리 회전해 둔 템플릿 (티칭 각도 기준 상대 각도 하나)
+struct RotatedTemplate {
+    double relativeAngle = 0.0;                 // 티칭 각도 기준 상대 각도 (도)
+    cv::Mat templ;                              // 회전된 그레이 템플릿 (0도는 원본, 그 외는 대각선 크기 패딩)
+    cv::Mat mask;                               // 회전된 마스크 (없으면 empty)
+    int maskNonZero = 0;                        // 마스크 유효 픽셀 수
+    bool maskFull = true;                       // 마스크가 없거나 전체 유효 (마스크 없이 매칭)
+    std::shared_ptr<TemplateSpectrum> spectrum = std::make_shared<TemplateSpectrum>();  // FFT 상관용 캐시
+};
+
+// 형상(에지 그래디언트) 매칭 모델 점: 템플릿 중심 기준 정수 오프셋 + 단위 그래디언트 방향
+struct ShapeModelPoint {
+    int x = 0;
+    int y = 0;
+    float dx = 0.0f;
+    float dy = 0.0f;
+};
+
+// 각도 하나의 형상 모델 (점 순서는 조기 종료가 잘 되도록 공간적으로 섞여 있음)
+struct ShapeModel {
+    std::vector<ShapeModelPoint> points;
+    int minX = 0, maxX = 0, minY = 0, maxY = 0;  // 점 오프셋 범위
+};
+
+// 회전 템플릿 뱅크 (패턴 + 각도 범위/간격 단위)
+// 회전 검색 시 매 프레임 패딩/warpAffine/마스크 이진화를 반복하지 않도록 레시피 로드 시 만들어 둔다.
+struct RotatedTemplateBank {
+    qint64 imageKey = 0;                        // 원본 템플릿 QImage::cacheKey()
+    qint64 maskKey = 0;                         // 마스크 QImage::cacheKey() (마스크 미사용 시 0)
+    double minAngle = 0.0;                      // 상대 각도 범위/간격 (뱅크 재사용 판단용)
+    double maxAngle = 0.0;
+    double angleStep = 1.0;
+    cv::Size sourceSize;
+    int pyramidLevel = 0;                       // 축소 뱅크 레벨 (0이면 coarse 없음)
+    int zeroIndex = 0;                          // 티칭 각도(상대 0도) 인덱스
+    std::vector<RotatedTemplate> full;          // 원본 해상도 (상대 각도 오름차순)
+    std::vector<RotatedTemplate> coarse;        // 피라미드 레벨 축소본 (full과 같은 순서)
+    RotatedTemplate zeroPadded;                 // 회전본과 같게 패딩한 티칭 각도 (각도 보간용, 회전 미사용 시 비어있음)
+    std::vector<ShapeModel> shapeFull;          // 형상 매칭 모델 (full과 같은 순서)
+    std::vector<ShapeModel> shapeCoarse;        // 형상 매칭 축소 레벨 모델 (coarse와 같은 순서)
+};
+
+// FID 추적 상태 (프레임 인덱스 + 패턴 단위, 직전에 합격한 위치/각도)
+struct FidTrack {
+    cv::Point2f location;                       // 원본 이미지 기준 중심 (서브픽셀)
+    double relativeAngle = 0.0;                 // 티칭 각도 기준 상대 각도
+};
+
+// 검사 프레임 하나의 공용 평면 (트리거마다 한 번 만들어 모든 FID/INS 검사에 전달)
+// 흑백 평면은 처음 요청될 때 프레임 전체를 한 번만 변환하고 이후 ROI는 복사 없이 잘라 쓴다.
+// 생성 후에는 읽기 전용이므로 병렬 FID/INS 검사가 동시에 접근해도 안전하다.
+class FrameContext {
+public:
+    // gray가 주어지면(변환 단계가 Bayer에서 바로 만든 평면 등) 그대로 사용
+    // traceId: 지연 추적 ID (FID/INS/ANOMALY 구간 기록, 0이면 기록 안 함)
+    explicit FrameContext(const cv::Mat& image, const cv::Mat& gray = cv::Mat(), quint64 traceId = 0);
+
+    const cv::Mat& bgr() const { return image; }
+    const cv::Mat& gray() const;
+    cv::Mat grayRegion(const cv::Rect& rect) const { return gray()(rect); }
+    quint64 traceId() const { return frameTraceId; }
+
+private:
+    cv::Mat image;
+    quint64 frameTraceId;
+    mutable cv::Mat grayPlane;
+    mutable std::once_flag grayOnce;
+};
 
 class InsProcessor : public QObject {
     Q_OBJECT
@@ -12,18 +135,20 @@ public:
     ~InsProcessor();
   
     InspectionResult performInspection(const cv::Mat& image, const QList<PatternInfo>& patterns, const QString& cameraName = "");
+    InspectionResult performInspection(const FrameContext& frame, const QList<PatternInfo>& patterns, const QString& cameraName = "");
     static QImage matToQImage(const cv::Mat& mat);   
  
     // FID 패턴 매칭 기능
-    bool matchFiducial(const cv::Mat& image, const PatternInfo& pattern, double& score, 
-        cv::Point& matchLoc, double& matchAngle, const QList<PatternInfo>& allPatterns);
+    bool matchFiducial(const FrameContext& frame, const PatternInfo& pattern, double& score, 
+        cv::Point& matchLoc, double& matchAngle, const QList<PatternInfo>& allPatterns,
+        cv::Point2f* subPixelLoc = nullptr);
     
     // INS 검사 기능
-    bool checkDiff(const cv::Mat& image, const PatternInfo& pattern, double& score, InspectionResult& result);
-    bool checkStrip(const cv::Mat& image, const PatternInfo& pattern, double& score, InspectionResult& result, const QList<PatternInfo>& patterns);
-    bool checkCrimp(const cv::Mat& image, const PatternInfo& pattern, double& score, InspectionResult& result, const QList<PatternInfo>& patterns);
-    bool checkSSIM(const cv::Mat& image, const PatternInfo& pattern, double& score, InspectionResult& result);
-    bool checkAnomaly(const cv::Mat& image, const PatternInfo& pattern, double& score, InspectionResult& result);
+    bool checkDiff(const FrameContext& frame, const PatternInfo& pattern, double& score, InspectionResult& result);
+    bool checkStrip(const FrameContext& frame, const PatternInfo& pattern, double& score, InspectionResult& result, const QList<PatternInfo>& patterns);
+    bool checkCrimp(const FrameContext& frame, const PatternInfo& pattern, double& score, InspectionResult& result, const QList<PatternInfo>& patterns);
+    bool checkSSIM(const FrameContext& frame, const PatternInfo& pattern, double& score, InspectionResult& result);
+    bool checkAnomaly(const FrameContext& frame, const PatternInfo& pattern, double& score, InspectionResult& result);
 
     // ROI 추출 함수 (패턴 위치에서 영역 가져오기)
     cv::Mat extractROI(const cv::Mat& image, const QRectF& rect, double angle = 0.0, bool isTemplate = false);
@@ -36,6 +161,36 @@ public:
     
     // Anomaly 모델 워밍업 (레시피 로드 시 호출)
     void warmupAnomalyModels(const QList<PatternInfo>& patterns, const QString& recipeName);
+    
+    // 검사 계획 컴파일 (레시피 로드/패턴 편집 시 호출, 프레임 단위)
+    void compileInspectionPlan(const QList<PatternInfo>& patterns, const QString& recipeName);
+    void invalidateInspectionPlans();
+
+    // 템플릿 용도 (검사용 templateImage / 매칭용 matchTemplate)
+    enum class TemplateUsage { Inspection, Matching };
+    std::shared_ptr<const CachedTemplate> acquireTemplate(const PatternInfo& pattern, TemplateUsage usage);
+    void clearTemplateCache();
+
+    // 패턴 필터 체인 (패턴 ID 단위 캐시, 필터 구성이 바뀌면 다시 컴파일)
+    std::shared_ptr<const FilterChain> acquireFilterChain(const PatternInfo& pattern);
+
+    // FID/INS 패턴 병렬 검사 (기본 활성화, 비활성화 시 기존처럼 순차 실행)
+    void setParallelInspectionEnabled(bool enabled) { parallelInspectionEnabled.store(enabled); }
+    bool isParallelInspectionEnabled() const { return parallelInspectionEnabled.load(); }
+
+    // 피라미드 템플릿 매칭 (기본 활성화, 레벨은 템플릿 크기로 자동 선택)
+    void setPyramidMatchingEnabled(bool enabled) { pyramidMatchingEnabled.store(enabled); }
+    bool isPyramidMatchingEnabled() const { return pyramidMatchingEnabled.load(); }
+
+    // 상관 계산 방식 (Auto: 템플릿/검색 영역 크기로 공간 영역과 FFT 중 자동 선택, 마스크 매칭은 항상 공간 영역)
+    enum class MatchBackend { Auto, Spatial, FFT };
+    void setMatchBackend(MatchBackend backend) { matchBackend.store(backend); }
+    MatchBackend getMatchBackend() const { return matchBackend.load(); }
+
+    // FID 추적 모드 (기본 활성화): 직전 위치 주변 작은 창을 먼저 검색하고 점수 미달 시 전체 ROI 검색
+    void setFidTrackingEnabled(bool enabled);
+    bool isFidTrackingEnabled() const { return fidTrackingEnabled.load(); }
+    void resetFidTracking();
 
 signals:
     void logMessage(const QString& message);
@@ -52,11 +207,69 @@ private:
                                 cv::Point& matchLoc, double& score, double& angle,
                                 const PatternInfo& pattern,
                                 double minAngle = 0, double maxAngle = 0, double angleStep = 1,
-                                const cv::Mat& mask = cv::Mat());
+                                const cv::Mat& mask = cv::Mat(),
+                                cv::Point2f* subPixelLoc = nullptr);
+    
+    // 피라미드(Coarse-to-Fine) 매칭: 축소 영상에서 후보 검색 후 원본 해상도에서 정밀 검색
+    bool performPyramidMatching(const cv::Mat& imageGray, const RotatedTemplateBank& bank,
+                                const PatternInfo& pattern, int matchMethod,
+                                cv::Point& matchLoc, double& score, double& angle,
+                                cv::Point2f* subPixelLoc);
+    
+    // 형상(에지 그래디언트) 매칭: 희소 에지 점 방향 일치도 + 피라미드 검색 + 조기 종료
+    bool performShapeMatching(const cv::Mat& imageGray, const RotatedTemplateBank& bank,
+                              const PatternInfo& pattern, cv::Point& matchLoc, double& score, double& angle,
+                              cv::Point2f* subPixelLoc);
     
     bool performFeatureMatching(const cv::Mat& image, const cv::Mat& templ, 
                                cv::Point& matchLoc, double& score, double& angle);
     
+    // 검사 계획 생성/조회
+    static size_t computePlanSignature(const QList<PatternInfo>& patterns);
+    std::shared_ptr<const CompiledInspectionPlan> buildInspectionPlan(const QList<PatternInfo>& patterns,
+                                                                      const QString& recipeName, size_t signature);
+    std::shared_ptr<const CompiledInspectionPlan> acquireInspectionPlan(const QList<PatternInfo>& patterns);
+    
+    QMap<int, std::shared_ptr<const CompiledInspectionPlan>> compiledPlans;  // 프레임 인덱스 -> 검사 계획
+    QMutex planMutex;
+
+    // 회전 템플릿 뱅크 조회 (캐시된 매칭 템플릿이 아니면 이번 호출용으로만 생성)
+    std::shared_ptr<const RotatedTemplateBank> acquireRotationBank(const PatternInfo& pattern,
+                                                                   const cv::Mat& templ, const cv::Mat& templGray,
+                                                                   const cv::Mat& mask,
+                                                                   double minAngle, double maxAngle, double angleStep);
+    void warmupRotationBank(const PatternInfo& pattern);
+
+    // 회전 검색 범위와 매칭 마스크 (매칭 호출부와 뱅크 미리 생성이 같은 값을 쓰도록 여기서만 결정)
+    struct RotationSearch {
+        double minAngle = 0.0;
+        double maxAngle = 0.0;
+        double angleStep = 1.0;
+        cv::Mat mask;                               // FID는 마스크 없이 매칭
+    };
+    static RotationSearch rotationSearchFor(const PatternInfo& pattern, const CachedTemplate& templ);
+
+    // 직전 위치/각도 주변 창에서 FID 검색 (searchRoi 안으로 제한, 임계값 이상이면 true)
+    bool trackFiducial(const cv::Mat& image, const PatternInfo& pattern, const CachedTemplate& templ,
+                       const cv::Rect& searchRoi, const FidTrack& track,
+                       double& score, cv::Point& matchLoc, double& matchAngle, cv::Point2f& subPixelLoc);
+
+    static std::shared_ptr<const CachedTemplate> decodeTemplate(const QImage& image, const QImage& mask, TemplateUsage usage);
+
+    QHash<QUuid, std::shared_ptr<const CachedTemplate>> inspectionTemplates;  // 패턴 ID -> 검사용 템플릿
+    QHash<QUuid, std::shared_ptr<const CachedTemplate>> matchingTemplates;    // 패턴 ID -> 매칭용 템플릿
+    QHash<QUuid, std::shared_ptr<const RotatedTemplateBank>> rotationBanks;   // 패턴 ID -> 회전 템플릿 뱅크
+    QHash<QUuid, std::shared_ptr<const FilterChain>> filterChains;            // 패턴 ID -> 컴파일된 필터 체인
+    QMutex templateMutex;
+
+    QThreadPool insThreadPool;                      // FID/INS 패턴 병렬 검사용 스레드 풀
+    std::atomic<bool> parallelInspectionEnabled{true};
+    std::atomic<bool> pyramidMatchingEnabled{true};
+    std::atomic<MatchBackend> matchBackend{MatchBackend::Auto};
+
+    QHash<QPair<int, QUuid>, FidTrack> fidTracks;   // (프레임 인덱스, FID 패턴 ID) -> 추적 상태
+    QMutex trackMutex;
+    std::atomic<bool> fidTrackingEnabled{true};
 };
 
 #endif
\ No newline at end of file
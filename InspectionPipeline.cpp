@@ -0,0 +1,375 @@
+#include "InspectionPipeline.h"
+#include "InspectionTrace.h"
+#include <QDebug>
+#include <algorithm>
+
+#ifdef USE_SPINNAKER
+#include "Spinnaker.h"
+#endif
+
+namespace {
+    // 띠 경계 보간 여유 행 (VNG 5x5 이웃 포함, 짝수 유지)
+    const int DEMOSAIC_BAND_OVERLAP = 4;
+    // 띠 최소 높이 (너무 잘게 나누면 여유 행 변환 비용이 커짐)
+    const int DEMOSAIC_MIN_BAND_ROWS = 64;
+}
+
+cv::Mat FrameBufferPool::acquire(int rows, int cols, int type)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // 풀의 참조 하나만 남은 버퍼 = 다른 단계가 모두 놓은 버퍼
+    // (참조를 늘릴 수 있는 건 이미 참조를 가진 쪽뿐이므로 1이면 안전하게 재사용 가능)
+    for (const cv::Mat &buffer : m_buffers)
+    {
+        if (buffer.u && buffer.u->refcount == 1 &&
+            buffer.rows == rows && buffer.cols == cols && buffer.type() == type)
+        {
+            m_reused++;
+            return buffer;
+        }
+    }
+
+    // 해상도가 바뀌어 더 이상 맞지 않는 미사용 버퍼 정리
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [&](const cv::Mat &buffer) {
+                                       return buffer.u && buffer.u->refcount == 1 &&
+                                              (buffer.rows != rows || buffer.cols != cols || buffer.type() != type);
+                                   }),
+                    m_buffers.end());
+
+    cv::Mat buffer(rows, cols, type);
+    m_allocated++;
+    if (static_cast<int>(m_buffers.size()) < m_maxBuffers)
+        m_buffers.push_back(buffer);
+    return buffer;
+}
+
+cv::Mat FrameSlots::load(int index) const
+{
+    if (index < 0 || index >= SLOT_COUNT)
+        return cv::Mat();
+    std::shared_ptr<const cv::Mat> frame = std::atomic_load_explicit(&slots[index], std::memory_order_acquire);
+    return frame ? *frame : cv::Mat();
+}
+
+void FrameSlots::store(int index, const cv::Mat &frame)
+{
+    if (index < 0 || index >= SLOT_COUNT)
+        return;
+    std::shared_ptr<const cv::Mat> published = frame.empty() ? nullptr : std::make_shared<const cv::Mat>(frame);
+    std::atomic_store_explicit(&slots[index], std::move(published), std::memory_order_release);
+}
+
+void FrameSlots::clear()
+{
+    for (int i = 0; i < SLOT_COUNT; i++)
+        store(i, cv::Mat());
+}
+
+std::array<cv::Mat, FrameSlots::SLOT_COUNT> FrameSlots::snapshot() const
+{
+    std::array<cv::Mat, SLOT_COUNT> frames;
+    for (int i = 0; i < SLOT_COUNT; i++)
+        frames[i] = load(i);
+    return frames;
+}
+
+struct SdkDemosaicer::Impl
+{
+#ifdef USE_SPINNAKER
+    Spinnaker::ImageProcessor processor;
+
+    Impl()
+    {
+        processor.SetColorProcessing(Spinnaker::SPINNAKER_COLOR_PROCESSING_ALGORITHM_DIRECTIONAL_FILTER);
+    }
+#endif
+};
+
+SdkDemosaicer::SdkDemosaicer() = default;
+
+SdkDemosaicer::~SdkDemosaicer() = default;
+
+bool SdkDemosaicer::demosaic(const cv::Mat &raw, BayerPattern pattern, cv::Mat &dst)
+{
+#ifdef USE_SPINNAKER
+    Spinnaker::PixelFormatEnums format;
+    switch (pattern)
+    {
+    case BayerPattern::RG: format = Spinnaker::PixelFormat_BayerRG8; break;
+    case BayerPattern::GR: format = Spinnaker::PixelFormat_BayerGR8; break;
+    case BayerPattern::GB: format = Spinnaker::PixelFormat_BayerGB8; break;
+    case BayerPattern::BG: format = Spinnaker::PixelFormat_BayerBG8; break;
+    default: return false;
+    }
+    if (raw.empty() || raw.type() != CV_8UC1)
+        return false;
+
+    // SDK 이미지는 행 사이 여백 없는 연속 버퍼를 가정
+    const cv::Mat source = raw.isContinuous() ? raw : raw.clone();
+    if (dst.rows != raw.rows || dst.cols != raw.cols || dst.type() != CV_8UC3 || !dst.isContinuous())
+        dst.create(raw.rows, raw.cols, CV_8UC3);
+
+    try
+    {
+        if (!m_impl)
+            m_impl = std::make_unique<Impl>();
+
+        // 원본/대상 버퍼를 그대로 감싸서 변환 결과를 dst에 바로 써 넣음
+        Spinnaker::ImagePtr sourceImage = Spinnaker::Image::Create(source.cols, source.rows, 0, 0, format, source.data);
+        Spinnaker::ImagePtr target = Spinnaker::Image::Create(dst.cols, dst.rows, 0, 0, Spinnaker::PixelFormat_BGR8, dst.data);
+        m_impl->processor.Convert(sourceImage, target, Spinnaker::PixelFormat_BGR8);
+        return true;
+    }
+    catch (const Spinnaker::Exception &e)
+    {
+        qWarning() << "[Pipeline] SDK 디모자이크 실패:" << e.what();
+        return false;
+    }
+#else
+    Q_UNUSED(raw);
+    Q_UNUSED(pattern);
+    Q_UNUSED(dst);
+    return false;
+#endif
+}
+
+int FrameConverter::conversionCode(BayerPattern pattern, DemosaicQuality quality, bool toGray)
+{
+    // GenICam 이름은 (0,0)부터, OpenCV 이름은 (1,1)부터 읽으므로 BayerRG8 → COLOR_BayerBG2*
+    switch (pattern)
+    {
+    case BayerPattern::RG:
+        if (toGray) return cv::COLOR_BayerBG2GRAY;
+        return quality == DemosaicQuality::Fast        ? cv::COLOR_BayerBG2BGR
+               : quality == DemosaicQuality::EdgeAware ? cv::COLOR_BayerBG2BGR_EA
+                                                       : cv::COLOR_BayerBG2BGR_VNG;
+    case BayerPattern::GR:
+        if (toGray) return cv::COLOR_BayerGB2GRAY;
+        return quality == DemosaicQuality::Fast        ? cv::COLOR_BayerGB2BGR
+               : quality == DemosaicQuality::EdgeAware ? cv::COLOR_BayerGB2BGR_EA
+                                                       : cv::COLOR_BayerGB2BGR_VNG;
+    case BayerPattern::GB:
+        if (toGray) return cv::COLOR_BayerGR2GRAY;
+        return quality == DemosaicQuality::Fast        ? cv::COLOR_BayerGR2BGR
+               : quality == DemosaicQuality::EdgeAware ? cv::COLOR_BayerGR2BGR_EA
+                                                       : cv::COLOR_BayerGR2BGR_VNG;
+    case BayerPattern::BG:
+        if (toGray) return cv::COLOR_BayerRG2GRAY;
+        return quality == DemosaicQuality::Fast        ? cv::COLOR_BayerRG2BGR
+               : quality == DemosaicQuality::EdgeAware ? cv::COLOR_BayerRG2BGR_EA
+                                                       : cv::COLOR_BayerRG2BGR_VNG;
+    default:
+        return -1;
+    }
+}
+
+void FrameConverter::demosaic(const cv::Mat &raw, BayerPattern pattern, DemosaicQuality quality, bool toGray, cv::Mat &dst)
+{
+    const int code = conversionCode(pattern, quality, toGray);
+    if (code < 0 || raw.empty() || raw.type() != CV_8UC1)
+    {
+        dst.release();
+        return;
+    }
+
+    const int dstType = toGray ? CV_8UC1 : CV_8UC3;
+    if (dst.rows != raw.rows || dst.cols != raw.cols || dst.type() != dstType)
+        dst.create(raw.rows, raw.cols, dstType);
+
+    const int bandCount = std::max(1, std::min(cv::getNumThreads(), raw.rows / DEMOSAIC_MIN_BAND_ROWS));
+    if (bandCount == 1)
+    {
+        cv::cvtColor(raw, dst, code);
+        return;
+    }
+
+    // 띠 높이를 짝수로 맞춰 모든 띠가 같은 Bayer 위상에서 시작
+    const int bandRows = (((raw.rows + bandCount - 1) / bandCount) + 1) & ~1;
+    cv::parallel_for_(cv::Range(0, bandCount), [&](const cv::Range &range) {
+        for (int band = range.start; band < range.end; band++)
+        {
+            const int y0 = band * bandRows;
+            const int y1 = std::min(raw.rows, y0 + bandRows);
+            if (y0 >= y1)
+                continue;
+
+            const int top = std::max(0, y0 - DEMOSAIC_BAND_OVERLAP);
+            const int bottom = std::min(raw.rows, y1 + DEMOSAIC_BAND_OVERLAP);
+            cv::Mat converted;
+            cv::cvtColor(raw.rowRange(top, bottom), converted, code);
+            converted.rowRange(y0 - top, y1 - top).copyTo(dst.rowRange(y0, y1));
+        }
+    });
+}
+
+void FrameConverter::demosaicBgr(const cv::Mat &raw, BayerPattern pattern, DemosaicQuality quality, SdkDemosaicer *sdk, cv::Mat &dst)
+{
+    if (quality == DemosaicQuality::CameraSdk)
+    {
+        if (sdk && sdk->demosaic(raw, pattern, dst))
+            return;
+        quality = DemosaicQuality::EdgeAware;  // SDK 없이 빌드했거나 변환 실패
+    }
+    demosaic(raw, pattern, quality, false, dst);
+}
+
+bool FrameConverter::convert(TriggerFrame &trigger, FrameBufferPool *outputPool, SdkDemosaicer *sdk) const
+{
+    if (trigger.raw.empty() || trigger.bayer == BayerPattern::None)
+    {
+        if (trigger.frame.empty())
+            return false;
+        if (m_grayOutput.load() && trigger.frame.channels() == 3)
+            cv::cvtColor(trigger.frame, trigger.gray, cv::COLOR_BGR2GRAY);
+        return true;
+    }
+
+    cv::Mat bgr = outputPool ? outputPool->acquire(trigger.raw.rows, trigger.raw.cols, CV_8UC3) : cv::Mat();
+    demosaicBgr(trigger.raw, trigger.bayer, m_quality.load(), sdk, bgr);
+    if (bgr.empty())
+        return false;
+
+    // ★ 흑백 평면은 BGR 결과에서 만든다 (Bayer→GRAY는 양선형 고정이라 컬러 경로와 화질이 달라짐)
+    if (m_grayOutput.load())
+        cv::cvtColor(bgr, trigger.gray, cv::COLOR_BGR2GRAY);
+
+    trigger.frame = bgr;
+    trigger.raw.release();  // 원본 버퍼는 즉시 풀로 반환
+    trigger.bayer = BayerPattern::None;
+    return true;
+}
+
+InspectionWorkerThread::InspectionWorkerThread(int cameraIndex, int queueCapacity, Handler handler, QObject *parent)
+    : QThread(parent),
+      m_cameraIndex(cameraIndex),
+      m_handler(std::move(handler)),
+      m_queue(std::max(1, queueCapacity)),
+      m_freeSlots(std::max(1, queueCapacity)),
+      m_queuedFrames(0)
+{
+}
+
+InspectionWorkerThread::~InspectionWorkerThread()
+{
+    stopWorker();
+    wait();
+}
+
+void InspectionWorkerThread::setOverflowPolicy(QueueOverflowPolicy policy, int blockTimeoutMs)
+{
+    m_policy.store(policy);
+    m_blockTimeoutMs.store(std::max(0, blockTimeoutMs));
+}
+
+bool InspectionWorkerThread::submit(TriggerFrame &&frame)
+{
+    if (m_stopped.load())
+        return false;
+
+    // 빈 자리 확보 (Block 정책이면 검사 단계가 자리를 비울 때까지 대기 - 역압)
+    bool reserved = (m_policy.load() == QueueOverflowPolicy::Block)
+                        ? m_freeSlots.tryAcquire(1, m_blockTimeoutMs.load())
+                        : m_freeSlots.tryAcquire(1);
+    if (!reserved)
+    {
+        quint64 dropped = ++m_droppedQueueFull;
+        qWarning().noquote() << QString("[Pipeline] Cam%1 Frame[%2] 검사 큐 가득 참 - 프레임 버림 (누적 %3)")
+                                    .arg(m_cameraIndex).arg(frame.frameIndex).arg(dropped);
+        emit frameDropped(m_cameraIndex, frame.frameIndex, dropped);
+        return false;
+    }
+
+    // 자리를 확보했으므로 실패하지 않음 (생산자는 이 스레드 하나)
+    m_queue.tryPush(std::move(frame));
+    m_submitted++;
+
+    int depth = m_queue.size();
+    int previousMax = m_maxQueueDepth.load();
+    while (depth > previousMax && !m_maxQueueDepth.compare_exchange_weak(previousMax, depth))
+    {
+    }
+
+    m_queuedFrames.release();
+    return true;
+}
+
+void InspectionWorkerThread::stopWorker()
+{
+    if (m_stopped.exchange(true))
+        return;
+    m_queuedFrames.release();  // 대기 중인 검사 스레드 깨우기
+}
+
+void InspectionWorkerThread::setConverter(const FrameConverter *converter, FrameBufferPool *outputPool)
+{
+    m_converter = converter;
+    m_outputPool = outputPool;
+}
+
+InspectionPipelineStats InspectionWorkerThread::stats() const
+{
+    InspectionPipelineStats snapshot;
+    snapshot.submitted = m_submitted.load();
+    snapshot.inspected = m_inspected.load();
+    snapshot.droppedQueueFull = m_droppedQueueFull.load();
+    snapshot.droppedOnStop = m_droppedOnStop.load();
+    snapshot.queueDepth = m_queue.size();
+    snapshot.maxQueueDepth = m_maxQueueDepth.load();
+    return snapshot;
+}
+
+void InspectionWorkerThread::run()
+{
+    while (true)
+    {
+        m_queuedFrames.acquire();
+        if (m_stopped.load())
+            break;
+
+        TriggerFrame item;
+        if (!m_queue.tryPop(item))
+            continue;
+        m_freeSlots.release();
+
+        if (item.traceId)
+        {
+            const qint64 queuedUs = std::chrono::duration_cast<std::chrono::microseconds>(item.acquiredAt.time_since_epoch()).count();
+            InspectionTracer::instance().addSpan(item.traceId, "pipeline", QStringLiteral("큐 대기"), queuedUs, InspectionTracer::nowUs());
+        }
+
+        try
+        {
+            // 변환 단계: 획득 스레드는 원본 복사만 하고 디모자이크는 여기서 (코어 병렬)
+            if (m_converter && !item.raw.empty())
+            {
+                InspectionTraceScope convertTrace(item.traceId, "pipeline", QStringLiteral("변환"));
+                if (!m_converter->convert(item, m_outputPool, &m_sdkDemosaicer))
+                {
+                    qWarning() << "[Pipeline] Cam" << m_cameraIndex << "Bayer 변환 실패 - 프레임 버림";
+                    InspectionTracer::instance().endFrame(item.traceId);
+                    continue;
+                }
+            }
+            m_handler(item);
+        }
+        catch (const std::exception &e)
+        {
+            qWarning() << "[Pipeline] Cam" << m_cameraIndex << "검사 단계 예외:" << e.what();
+        }
+        catch (...)
+        {
+            qWarning() << "[Pipeline] Cam" << m_cameraIndex << "검사 단계 알 수 없는 예외";
+        }
+        m_inspected++;
+    }
+
+    // 중지 시 남은 프레임은 검사하지 않고 버림
+    TriggerFrame remaining;
+    while (m_queue.tryPop(remaining))
+    {
+        m_droppedOnStop++;
+        m_freeSlots.release();
+    }
+}
@@ -0,0 +1,251 @@
+#ifndef INSPECTIONPIPELINE_H
+#define INSPECTIONPIPELINE_H
+
+#include <QThread>
+#include <QSemaphore>
+#include <QMutex>
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// ===== 카메라별 검사 파이프라인 =====
+// 획득(CameraGrabberThread, Bayer 원본 복사) → 변환(FrameConverter, 병렬 디모자이크)
+//   → 검사(InspectionWorkerThread) → 결과 발행(메인 스레드 큐)
+// 카메라마다 고정 크기 큐를 두어 N번째 부품 검사 중에도 N+1번째 부품 획득이 가능하다.
+
+// ===== 프레임 버퍼 풀 =====
+// 변환 단계가 직접 써 넣는 참조 카운트 프레임 버퍼. 풀이 참조 하나를 들고 있다가
+// 검사/표시/저장이 모두 놓아 풀의 참조만 남으면 다음 프레임에 재사용한다.
+// 받은 프레임은 여러 단계가 공유하므로 읽기 전용으로 다뤄야 한다 (수정하려면 clone).
+class FrameBufferPool
+{
+public:
+    explicit FrameBufferPool(int maxBuffers = 8) : m_maxBuffers(maxBuffers) {}
+
+    // 사용 중이 아닌 같은 크기 버퍼 재사용, 없으면 새로 할당 (풀이 가득 차면 풀 밖 버퍼)
+    cv::Mat acquire(int rows, int cols, int type);
+
+    quint64 reusedCount() const { return m_reused.load(); }
+    quint64 allocatedCount() const { return m_allocated.load(); }
+
+private:
+    QMutex m_mutex;
+    std::vector<cv::Mat> m_buffers;
+    int m_maxBuffers;
+    std::atomic<quint64> m_reused{0};
+    std::atomic<quint64> m_allocated{0};
+};
+
+// ===== 프레임 슬롯 =====
+// 프레임 인덱스(0~3)별 최신 프레임. 슬롯마다 불변 프레임을 shared_ptr로 발행한다.
+// 쓰기는 새 포인터로 원자 교체, 읽기는 원자적으로 포인터를 얻어 그 시점 프레임을 일관되게 본다.
+// 교체/읽기 구간은 포인터 복사뿐이라 짧고(표준 라이브러리 구현에 따라 내부 락을 쓸 수 있음),
+// 교체된 프레임은 마지막으로 읽은 쪽이 놓을 때 해제된다. 받은 프레임은 읽기 전용 (수정하려면 clone).
+// 확인 후 사용할 때는 load()를 한 번만 불러 지역 변수로 받아야 같은 프레임을 본다.
+class FrameSlots
+{
+public:
+    static constexpr int SLOT_COUNT = 4;
+
+    cv::Mat load(int index) const;
+    void store(int index, const cv::Mat& frame);
+    void clear();
+    std::array<cv::Mat, SLOT_COUNT> snapshot() const;
+
+    // 기존 std::array<cv::Mat, 4> 사용처 호환
+    size_t size() const { return SLOT_COUNT; }
+    bool empty() const { return false; }
+
+private:
+    std::array<std::shared_ptr<const cv::Mat>, SLOT_COUNT> slots;
+};
+
+// Bayer 배열 (GenICam PixelFormat 이름 기준: BayerRG8 → RG)
+enum class BayerPattern {
+    None,           // 이미 변환된 프레임 (BGR/Mono)
+    RG,
+    GR,
+    GB,
+    BG
+};
+
+// 디모자이크 알고리즘 (속도 ↔ 화질) - 모두 검사 단계(변환 단계)에서 실행
+// Fast/EdgeAware/HighQuality는 OpenCV 띠 병렬 변환(선택), CameraSdk는 기존과 같은 Spinnaker 방향성 필터 (기본)
+enum class DemosaicQuality {
+    Fast = 0,       // 양선형 보간 (가장 빠름)
+    EdgeAware = 1,  // 에지 방향 보간
+    HighQuality = 2, // VNG (가장 느림)
+    CameraSdk = 3   // Spinnaker DIRECTIONAL_FILTER (기본, 기존 화질 유지)
+};
+
+// 트리거로 획득한 프레임 하나 (획득 시점에 프레임 인덱스를 확정)
+struct TriggerFrame {
+    cv::Mat frame;                              // BGR 프레임 (프레임 버퍼 풀 버퍼, 읽기 전용 공유)
+    cv::Mat raw;                                // 변환 전 Bayer 원본 (변환 단계가 frame을 채운 뒤 해제)
+    BayerPattern bayer = BayerPattern::None;
+    cv::Mat gray;                               // BGR 결과에서 만든 흑백 평면 (흑백 출력 켠 경우)
+    int cameraIndex = -1;
+    int frameIndex = -1;                        // 서버/시리얼이 지정한 프레임 인덱스 (0~3)
+    std::chrono::steady_clock::time_point acquiredAt;
+    quint64 traceId = 0;                        // 지연 추적 ID (추적 꺼짐: 0)
+};
+
+// ===== 카메라 SDK 디모자이크 =====
+// Bayer 원본을 Spinnaker ImageProcessor(DIRECTIONAL_FILTER)로 BGR 변환한다.
+// 프로세서는 처음 쓸 때 한 번 만들어 재사용하므로 검사 스레드(카메라)마다 하나씩 두고 스레드 간에 공유하지 않는다.
+class SdkDemosaicer
+{
+public:
+    SdkDemosaicer();
+    ~SdkDemosaicer();
+
+    // raw(CV_8UC1 Bayer) → dst(CV_8UC3 BGR), SDK 없이 빌드했거나 변환 실패 시 false
+    bool demosaic(const cv::Mat& raw, BayerPattern pattern, cv::Mat& dst);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
+
+// ===== 프레임 변환 단계 =====
+// Bayer 원본을 가로 띠로 나눠 코어별로 디모자이크한다. 띠 높이는 짝수(2x2 배열 위상 유지)이고
+// 경계 보간에 필요한 위아래 여유 행을 함께 변환한 뒤 가운데만 결과에 복사한다.
+class FrameConverter
+{
+public:
+    void setQuality(DemosaicQuality quality) { m_quality.store(quality); }
+    DemosaicQuality quality() const { return m_quality.load(); }
+
+    // 흑백 검사용 평면을 변환 단계에서 미리 생성 (BGR과 같은 디모자이크 결과에서 만들어 화질 일치)
+    void setGrayOutput(bool enabled) { m_grayOutput.store(enabled); }
+    bool grayOutput() const { return m_grayOutput.load(); }
+
+    // trigger.raw → trigger.frame (BGR, outputPool 버퍼), 흑백 출력이면 trigger.gray도 채움
+    // sdk는 호출 스레드 전용 SDK 디모자이커 (CameraSdk 화질에서 사용)
+    bool convert(TriggerFrame& trigger, FrameBufferPool* outputPool, SdkDemosaicer* sdk = nullptr) const;
+
+    // 띠 단위 병렬 디모자이크 (dst 크기/타입이 맞으면 그대로 씀)
+    static void demosaic(const cv::Mat& raw, BayerPattern pattern, DemosaicQuality quality, bool toGray, cv::Mat& dst);
+
+    // 화질 설정에 따라 SDK 또는 OpenCV로 BGR 디모자이크 (SDK를 쓸 수 없으면 에지 보간으로 대체)
+    static void demosaicBgr(const cv::Mat& raw, BayerPattern pattern, DemosaicQuality quality, SdkDemosaicer* sdk, cv::Mat& dst);
+
+private:
+    static int conversionCode(BayerPattern pattern, DemosaicQuality quality, bool toGray);
+
+    std::atomic<DemosaicQuality> m_quality{DemosaicQuality::CameraSdk};
+    std::atomic<bool> m_grayOutput{false};
+};
+
+// 단일 생산자/단일 소비자 고정 크기 링 버퍼 (락 없음)
+// 생산자는 획득 스레드 하나, 소비자는 검사 스레드 하나만 사용해야 한다.
+template <typename T>
+class SpscRingBuffer
+{
+public:
+    explicit SpscRingBuffer(int capacity) : slots(static_cast<size_t>(capacity) + 1) {}
+
+    bool tryPush(T&& item)
+    {
+        size_t tail = writeIndex.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) % slots.size();
+        if (next == readIndex.load(std::memory_order_acquire))
+            return false;  // 가득 참
+        slots[tail] = std::move(item);
+        writeIndex.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& item)
+    {
+        size_t head = readIndex.load(std::memory_order_relaxed);
+        if (head == writeIndex.load(std::memory_order_acquire))
+            return false;  // 비어 있음
+        item = std::move(slots[head]);
+        slots[head] = T();  // 프레임 버퍼 참조 즉시 해제
+        readIndex.store((head + 1) % slots.size(), std::memory_order_release);
+        return true;
+    }
+
+    int size() const
+    {
+        size_t head = readIndex.load(std::memory_order_acquire);
+        size_t tail = writeIndex.load(std::memory_order_acquire);
+        return static_cast<int>((tail + slots.size() - head) % slots.size());
+    }
+
+    int capacity() const { return static_cast<int>(slots.size()) - 1; }
+
+private:
+    std::vector<T> slots;
+    std::atomic<size_t> readIndex{0};
+    std::atomic<size_t> writeIndex{0};
+};
+
+// 큐가 가득 찼을 때 정책
+enum class QueueOverflowPolicy {
+    Block,          // 자리가 날 때까지 획득 스레드 대기 (최대 blockTimeoutMs, 초과 시 버림) - 기본
+    DropNewest      // 즉시 새 프레임 버림
+};
+
+// 파이프라인 카운터 (스레드 안전 스냅샷)
+struct InspectionPipelineStats {
+    quint64 submitted = 0;                      // 큐에 들어간 프레임 수
+    quint64 inspected = 0;                      // 검사 완료 프레임 수
+    quint64 droppedQueueFull = 0;               // 큐가 가득 차서 버린 프레임 수
+    quint64 droppedOnStop = 0;                  // 중지 시 검사하지 못하고 버린 프레임 수
+    int queueDepth = 0;                         // 현재 대기 중인 프레임 수
+    int maxQueueDepth = 0;                      // 최대 대기 프레임 수
+};
+
+// 카메라 하나의 검사 단계 스레드 (큐에서 프레임을 꺼내 handler 실행)
+class InspectionWorkerThread : public QThread {
+    Q_OBJECT
+
+public:
+    using Handler = std::function<void(const TriggerFrame&)>;
+
+    InspectionWorkerThread(int cameraIndex, int queueCapacity, Handler handler, QObject* parent = nullptr);
+    ~InspectionWorkerThread();
+
+    // 획득 스레드에서 호출 (큐에 넣지 못하면 false - 버린 프레임으로 집계)
+    bool submit(TriggerFrame&& frame);
+    void stopWorker();
+
+    void setOverflowPolicy(QueueOverflowPolicy policy, int blockTimeoutMs = 500);
+    // 검사 전에 Bayer 원본을 변환 (start() 전에 설정)
+    void setConverter(const FrameConverter* converter, FrameBufferPool* outputPool);
+    InspectionPipelineStats stats() const;
+    int cameraIndex() const { return m_cameraIndex; }
+
+signals:
+    void frameDropped(int cameraIndex, int frameIndex, quint64 totalDropped);
+
+protected:
+    void run() override;
+
+private:
+    int m_cameraIndex;
+    Handler m_handler;
+    const FrameConverter* m_converter = nullptr;
+    FrameBufferPool* m_outputPool = nullptr;
+    SdkDemosaicer m_sdkDemosaicer;              // 이 검사 스레드 전용 SDK 디모자이커
+    SpscRingBuffer<TriggerFrame> m_queue;
+    QSemaphore m_freeSlots;
+    QSemaphore m_queuedFrames;
+    std::atomic<bool> m_stopped{false};
+    std::atomic<QueueOverflowPolicy> m_policy{QueueOverflowPolicy::Block};
+    std::atomic<int> m_blockTimeoutMs{500};
+
+    std::atomic<quint64> m_submitted{0};
+    std::atomic<quint64> m_inspected{0};
+    std::atomic<quint64> m_droppedQueueFull{0};
+    std::atomic<quint64> m_droppedOnStop{0};
+    std::atomic<int> m_maxQueueDepth{0};
+};
+
+#endif // INSPECTIONPIPELINE_H
@@ -0,0 +1,467 @@
+#include "InspectionStats.h"
+#include "ConfigManager.h"
+#include <QDebug>
+#include <QHostAddress>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QtAlgorithms>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace {
+    // PPM 계산 구간
+    const qint64 PPM_WINDOW_MS = 60000;
+    // 요청 줄을 보내지 않는 연결 정리
+    const int STATS_CLIENT_TIMEOUT_MS = 2000;
+    const int STATS_MAX_REQUEST_BYTES = 4096;
+
+    QJsonObject latencyToJson(const LatencySummary &latency)
+    {
+        QJsonObject obj;
+        obj["count"] = static_cast<qint64>(latency.count);
+        obj["p50_us"] = latency.p50;
+        obj["p90_us"] = latency.p90;
+        obj["p99_us"] = latency.p99;
+        obj["max_us"] = latency.max;
+        obj["mean_us"] = std::round(latency.mean);
+        return obj;
+    }
+
+    double ngRate(quint64 ng, quint64 total)
+    {
+        return total ? (100.0 * ng) / total : 0.0;
+    }
+
+    QString latencyToText(const LatencySummary &latency)
+    {
+        return QString("p50=%1ms p90=%2ms p99=%3ms max=%4ms")
+            .arg(latency.p50 / 1000.0, 0, 'f', 2)
+            .arg(latency.p90 / 1000.0, 0, 'f', 2)
+            .arg(latency.p99 / 1000.0, 0, 'f', 2)
+            .arg(latency.max / 1000.0, 0, 'f', 2);
+    }
+}
+
+// ===== LatencyHistogram =====
+
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+void LatencyHistogram::reset()
+{
+    buckets.fill(0);
+    total = 0;
+    sum = 0;
+    maxValue = 0;
+}
+
+int LatencyHistogram::bucketIndex(quint64 us)
+{
+    if (us < 2 * SUB_BUCKETS)
+        return static_cast<int>(us);
+
+    // 최상위 비트 위치 m에서 상위 6비트(32~63)를 하위 구간으로 사용
+    const quint32 value = static_cast<quint32>(std::min<quint64>(us, 0xFFFFFFFFull));
+    const int msb = 31 - qCountLeadingZeroBits(value);
+    const int shift = msb - 5;
+    return std::min(BUCKET_COUNT - 1, shift * SUB_BUCKETS + static_cast<int>(value >> shift));
+}
+
+qint64 LatencyHistogram::bucketUpperBound(int index)
+{
+    if (index < 2 * SUB_BUCKETS)
+        return index;
+    const int shift = index / SUB_BUCKETS - 1;
+    const qint64 subBucket = index - shift * SUB_BUCKETS;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(qint64 us)
+{
+    us = std::max<qint64>(0, us);
+    buckets[bucketIndex(static_cast<quint64>(us))]++;
+    total++;
+    sum += static_cast<quint64>(us);
+    maxValue = std::max(maxValue, us);
+}
+
+qint64 LatencyHistogram::percentile(double p) const
+{
+    if (total == 0)
+        return 0;
+
+    const quint64 target = std::max<quint64>(1, static_cast<quint64>(std::ceil(total * std::clamp(p, 0.0, 100.0) / 100.0)));
+    quint64 seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += buckets[i];
+        if (seen >= target)
+            return std::min(bucketUpperBound(i), maxValue);
+    }
+    return maxValue;
+}
+
+// ===== InspectionStats =====
+
+InspectionStats &InspectionStats::instance()
+{
+    static InspectionStats stats;
+    return stats;
+}
+
+InspectionStats::InspectionStats()
+    : m_startMs(nowMs())
+{
+}
+
+qint64 InspectionStats::nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+InspectionStats::CameraEntry &InspectionStats::cameraEntry(int cameraIndex)
+{
+    return m_cameras[cameraIndex];
+}
+
+void InspectionStats::recordPattern(const PatternInfo *pattern, const QUuid &id, const QString &method,
+                                    int frameIndex, bool passed, const InspectionResult &result)
+{
+    PatternEntry &entry = m_patterns[id];
+    if (entry.name.isEmpty())
+    {
+        entry.name = pattern ? pattern->name : id.toString(QUuid::WithoutBraces).left(8);
+        entry.frameIndex = frameIndex;
+    }
+    entry.method = method;
+
+    PatternEntry &methodEntry = m_methods[method];
+    methodEntry.name = method;
+    methodEntry.method = method;
+
+    entry.inspected++;
+    methodEntry.inspected++;
+    if (!passed)
+    {
+        entry.ng++;
+        methodEntry.ng++;
+    }
+
+    // 시간이 없는 패턴(모델 없음 등 검사 전에 실패)은 개수만 집계
+    auto time = result.patternTimesUs.constFind(id);
+    if (time != result.patternTimesUs.constEnd())
+    {
+        entry.latency.record(time.value());
+        methodEntry.latency.record(time.value());
+    }
+}
+
+void InspectionStats::recordFrame(int cameraIndex, int frameIndex, qint64 cycleUs,
+                                  const InspectionResult &result, const QList<PatternInfo> &patterns)
+{
+    QHash<QUuid, const PatternInfo *> patternById;
+    patternById.reserve(patterns.size());
+    for (const PatternInfo &pattern : patterns)
+        patternById.insert(pattern.id, &pattern);
+
+    const qint64 now = nowMs();
+
+    QMutexLocker locker(&m_mutex);
+    CameraEntry &camera = cameraEntry(cameraIndex);
+    camera.frames++;
+    if (!result.isPassed)
+        camera.ng++;
+    camera.cycle.record(cycleUs);
+    camera.completionsMs.push_back(now);
+    while (!camera.completionsMs.empty() && now - camera.completionsMs.front() > PPM_WINDOW_MS)
+        camera.completionsMs.pop_front();
+
+    for (auto it = result.fidResults.constBegin(); it != result.fidResults.constEnd(); ++it)
+        recordPattern(patternById.value(it.key(), nullptr), it.key(), QStringLiteral("FID"), frameIndex, it.value(), result);
+
+    for (auto it = result.insResults.constBegin(); it != result.insResults.constEnd(); ++it)
+    {
+        const PatternInfo *pattern = patternById.value(it.key(), nullptr);
+        int method = result.insMethodTypes.value(it.key(), pattern ? pattern->inspectionMethod : -1);
+        recordPattern(pattern, it.key(), InspectionMethod::getName(method), frameIndex, it.value(), result);
+    }
+}
+
+void InspectionStats::recordDrop(int cameraIndex, const QString &reason, quint64 count)
+{
+    QMutexLocker locker(&m_mutex);
+    cameraEntry(cameraIndex).drops[reason] += count;
+}
+
+void InspectionStats::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_cameras.clear();
+    m_patterns.clear();
+    m_methods.clear();
+    m_startMs = nowMs();
+}
+
+void InspectionStats::setCounterProvider(std::function<QJsonObject()> provider)
+{
+    QMutexLocker locker(&m_mutex);
+    m_counterProvider = std::move(provider);
+}
+
+LatencySummary InspectionStats::summarize(const LatencyHistogram &histogram)
+{
+    LatencySummary summary;
+    summary.count = histogram.count();
+    summary.p50 = histogram.percentile(50.0);
+    summary.p90 = histogram.percentile(90.0);
+    summary.p99 = histogram.percentile(99.0);
+    summary.max = histogram.max();
+    summary.mean = histogram.mean();
+    return summary;
+}
+
+PatternStatsSnapshot InspectionStats::summarize(const PatternEntry &entry)
+{
+    PatternStatsSnapshot snapshot;
+    snapshot.name = entry.name;
+    snapshot.method = entry.method;
+    snapshot.frameIndex = entry.frameIndex;
+    snapshot.inspected = entry.inspected;
+    snapshot.ng = entry.ng;
+    snapshot.latency = summarize(entry.latency);
+    return snapshot;
+}
+
+InspectionStatsSnapshot InspectionStats::snapshot() const
+{
+    InspectionStatsSnapshot snapshot;
+    const qint64 now = nowMs();
+
+    QMutexLocker locker(&m_mutex);
+    snapshot.uptimeSec = (now - m_startMs) / 1000.0;
+
+    for (auto it = m_cameras.constBegin(); it != m_cameras.constEnd(); ++it)
+    {
+        const CameraEntry &entry = it.value();
+        CameraStatsSnapshot camera;
+        camera.cameraIndex = it.key();
+        camera.frames = entry.frames;
+        camera.ng = entry.ng;
+        camera.drops = entry.drops;
+        camera.cycle = summarize(entry.cycle);
+
+        // 최근 1분 완료 개수 (시작 후 1분이 안 됐으면 경과 시간으로 환산)
+        const qint64 windowMs = std::min(PPM_WINDOW_MS, std::max<qint64>(1, now - m_startMs));
+        const qint64 recent = std::count_if(entry.completionsMs.begin(), entry.completionsMs.end(),
+                                            [&](qint64 t) { return now - t <= PPM_WINDOW_MS; });
+        camera.partsPerMinute = recent * 60000.0 / windowMs;
+        snapshot.cameras.append(camera);
+    }
+
+    for (const PatternEntry &entry : m_methods)
+        snapshot.methods.append(summarize(entry));
+
+    for (const PatternEntry &entry : m_patterns)
+        snapshot.patterns.append(summarize(entry));
+    std::sort(snapshot.patterns.begin(), snapshot.patterns.end(),
+              [](const PatternStatsSnapshot &a, const PatternStatsSnapshot &b) {
+                  return a.frameIndex != b.frameIndex ? a.frameIndex < b.frameIndex : a.name < b.name;
+              });
+    return snapshot;
+}
+
+QJsonObject InspectionStats::toJson() const
+{
+    const InspectionStatsSnapshot stats = snapshot();
+    std::function<QJsonObject()> provider;
+    {
+        QMutexLocker locker(&m_mutex);
+        provider = m_counterProvider;
+    }
+
+    QJsonObject root;
+    root["uptime_s"] = stats.uptimeSec;
+
+    QJsonArray cameras;
+    for (const CameraStatsSnapshot &camera : stats.cameras)
+    {
+        QJsonObject obj;
+        obj["camera"] = camera.cameraIndex;
+        obj["frames"] = static_cast<qint64>(camera.frames);
+        obj["ng"] = static_cast<qint64>(camera.ng);
+        obj["ng_rate"] = ngRate(camera.ng, camera.frames);
+        obj["ppm"] = camera.partsPerMinute;
+        QJsonObject drops;
+        for (auto it = camera.drops.constBegin(); it != camera.drops.constEnd(); ++it)
+            drops[it.key()] = static_cast<qint64>(it.value());
+        obj["drops"] = drops;
+        obj["cycle"] = latencyToJson(camera.cycle);
+        cameras.append(obj);
+    }
+    root["cameras"] = cameras;
+
+    auto patternToJson = [](const PatternStatsSnapshot &pattern) {
+        QJsonObject obj;
+        obj["name"] = pattern.name;
+        obj["method"] = pattern.method;
+        if (pattern.frameIndex >= 0)
+            obj["frame"] = pattern.frameIndex;
+        obj["inspected"] = static_cast<qint64>(pattern.inspected);
+        obj["ng"] = static_cast<qint64>(pattern.ng);
+        obj["ng_rate"] = ngRate(pattern.ng, pattern.inspected);
+        obj["latency"] = latencyToJson(pattern.latency);
+        return obj;
+    };
+
+    QJsonArray methods;
+    for (const PatternStatsSnapshot &method : stats.methods)
+        methods.append(patternToJson(method));
+    root["methods"] = methods;
+
+    QJsonArray patterns;
+    for (const PatternStatsSnapshot &pattern : stats.patterns)
+        patterns.append(patternToJson(pattern));
+    root["patterns"] = patterns;
+
+    if (provider)
+        root["counters"] = provider();
+    return root;
+}
+
+QString InspectionStats::toText() const
+{
+    const InspectionStatsSnapshot stats = snapshot();
+    QStringList lines;
+    lines << QString("# Inspector 검사 통계 (uptime %1s)").arg(stats.uptimeSec, 0, 'f', 1);
+
+    for (const CameraStatsSnapshot &camera : stats.cameras)
+    {
+        QStringList drops;
+        for (auto it = camera.drops.constBegin(); it != camera.drops.constEnd(); ++it)
+            drops << QString("%1=%2").arg(it.key()).arg(it.value());
+        lines << QString("camera %1: frames=%2 ng=%3 (%4%) ppm=%5 cycle %6 drops[%7]")
+                     .arg(camera.cameraIndex)
+                     .arg(camera.frames)
+                     .arg(camera.ng)
+                     .arg(ngRate(camera.ng, camera.frames), 0, 'f', 2)
+                     .arg(camera.partsPerMinute, 0, 'f', 1)
+                     .arg(latencyToText(camera.cycle))
+                     .arg(drops.join(' '));
+    }
+
+    for (const PatternStatsSnapshot &method : stats.methods)
+    {
+        lines << QString("method %1: n=%2 ng=%3 (%4%) %5")
+                     .arg(method.method)
+                     .arg(method.inspected)
+                     .arg(method.ng)
+                     .arg(ngRate(method.ng, method.inspected), 0, 'f', 2)
+                     .arg(latencyToText(method.latency));
+    }
+
+    for (const PatternStatsSnapshot &pattern : stats.patterns)
+    {
+        lines << QString("pattern F%1/%2 [%3]: n=%4 ng=%5 (%6%) %7")
+                     .arg(pattern.frameIndex)
+                     .arg(pattern.name)
+                     .arg(pattern.method)
+                     .arg(pattern.inspected)
+                     .arg(pattern.ng)
+                     .arg(ngRate(pattern.ng, pattern.inspected), 0, 'f', 2)
+                     .arg(latencyToText(pattern.latency));
+    }
+    return lines.join('\n') + '\n';
+}
+
+// ===== InspectionStatsServer =====
+
+InspectionStatsServer::InspectionStatsServer(QObject *parent)
+    : QObject(parent)
+{
+    connect(&m_server, &QTcpServer::newConnection, this, &InspectionStatsServer::onNewConnection);
+    connect(ConfigManager::instance(), &ConfigManager::configChanged, this, &InspectionStatsServer::applySettings);
+    applySettings();
+}
+
+void InspectionStatsServer::applySettings()
+{
+    const int port = ConfigManager::instance()->getStatsPort();
+    if (port == m_configuredPort && (port == 0 || m_server.isListening()))
+        return;
+
+    m_configuredPort = port;
+    m_server.close();
+    if (port <= 0)
+        return;
+
+    // 외부 노출 없이 같은 PC의 모니터링 도구만 접근
+    if (m_server.listen(QHostAddress::LocalHost, static_cast<quint16>(port)))
+        qDebug() << "[Stats] 통계 엔드포인트 대기: 127.0.0.1:" << port;
+    else
+        qWarning() << "[Stats] 통계 엔드포인트 시작 실패:" << m_server.errorString();
+}
+
+void InspectionStatsServer::onNewConnection()
+{
+    while (QTcpSocket *socket = m_server.nextPendingConnection())
+    {
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            if (socket->canReadLine())
+            {
+                // 첫 줄에만 응답 (HTTP 헤더가 다른 세그먼트로 와도 다시 응답하지 않음)
+                disconnect(socket, &QTcpSocket::readyRead, this, nullptr);
+                handleRequest(socket, socket->readLine());
+            }
+            else if (socket->bytesAvailable() > STATS_MAX_REQUEST_BYTES)
+                socket->abort();
+        });
+        QTimer::singleShot(STATS_CLIENT_TIMEOUT_MS, socket, [socket]() { socket->abort(); });
+    }
+}
+
+void InspectionStatsServer::handleRequest(QTcpSocket *socket, const QByteArray &line)
+{
+    const QByteArray request = line.trimmed();
+    const bool isHttp = request.startsWith("GET ");
+    const QByteArray command = isHttp ? request.split(' ').value(1) : request.toLower();
+
+    QByteArray body;
+    QByteArray status = "200 OK";
+    QByteArray contentType = "text/plain; charset=utf-8";
+    if (command == "json" || command == "/stats.json" || command == "/json")
+    {
+        body = QJsonDocument(InspectionStats::instance().toJson()).toJson(QJsonDocument::Indented);
+        contentType = "application/json; charset=utf-8";
+    }
+    else if (command == "reset" && !isHttp)
+    {
+        InspectionStats::instance().reset();
+        body = "reset\n";
+    }
+    else if (command == "/reset")
+    {
+        status = "403 Forbidden";
+        body = "reset은 한 줄 명령으로만 허용됩니다\n";
+    }
+    else
+    {
+        body = InspectionStats::instance().toText().toUtf8();
+    }
+
+    if (isHttp)
+    {
+        QByteArray header = "HTTP/1.0 " + status + "\r\nContent-Type: " + contentType +
+                            "\r\nContent-Length: " + QByteArray::number(body.size()) +
+                            "\r\nConnection: close\r\n\r\n";
+        socket->write(header);
+    }
+    socket->write(body);
+    socket->disconnectFromHost();
+}
@@ -0,0 +1,168 @@
+#ifndef INSPECTIONSTATS_H
+#define INSPECTIONSTATS_H
+
+#include <QObject>
+#include <QMutex>
+#include <QHash>
+#include <QMap>
+#include <QList>
+#include <QUuid>
+#include <QJsonObject>
+#include <QTcpServer>
+#include <array>
+#include <deque>
+#include <functional>
+#include "CommonDefs.h"
+
+class QTcpSocket;
+
+// ===== 실시간 검사 통계 =====
+// 카메라별 사이클 시간(획득 → 결과), 패턴별/검사 방법별 검사 시간 히스토그램,
+// 분당 처리량(PPM), NG율, 버린 프레임 수를 모은다. 검사 스레드가 프레임마다 한 번 기록하고
+// 상태 패널(InspectionStatsDialog)과 로컬 TCP 엔드포인트(InspectionStatsServer)가 읽는다.
+
+// HDR 방식 지연 히스토그램 (마이크로초)
+// 64us 미만은 1us 단위, 그 위로는 2의 거듭제곱 구간마다 32개 하위 구간 (상대 오차 ~3%)
+// 동기화는 사용하는 쪽(InspectionStats)이 담당한다.
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 us);
+    void reset();
+
+    quint64 count() const { return total; }
+    qint64 max() const { return maxValue; }
+    double mean() const { return total ? static_cast<double>(sum) / total : 0.0; }
+    // 백분위 값 (해당 구간의 상한, 0 ~ 100)
+    qint64 percentile(double p) const;
+
+private:
+    static const int SUB_BUCKETS = 32;
+    static const int BUCKET_COUNT = 896;        // 2^32us(약 71분)까지
+    static int bucketIndex(quint64 us);
+    static qint64 bucketUpperBound(int index);
+
+    std::array<quint32, BUCKET_COUNT> buckets;
+    quint64 total = 0;
+    quint64 sum = 0;
+    qint64 maxValue = 0;
+};
+
+// 지연 요약 (상태 패널/엔드포인트 출력용)
+struct LatencySummary {
+    quint64 count = 0;
+    qint64 p50 = 0;
+    qint64 p90 = 0;
+    qint64 p99 = 0;
+    qint64 max = 0;
+    double mean = 0.0;
+};
+
+struct CameraStatsSnapshot {
+    int cameraIndex = -1;
+    quint64 frames = 0;
+    quint64 ng = 0;
+    double partsPerMinute = 0.0;               // 최근 1분 처리량 (1분 미만이면 환산)
+    QMap<QString, quint64> drops;               // 버린 이유 → 개수
+    LatencySummary cycle;                       // 획득 → 결과 (마이크로초)
+};
+
+struct PatternStatsSnapshot {
+    QString name;
+    QString method;                             // FID, DIFF, STRIP, ...
+    int frameIndex = -1;
+    quint64 inspected = 0;
+    quint64 ng = 0;
+    LatencySummary latency;                     // 패턴 검사 시간 (마이크로초)
+};
+
+struct InspectionStatsSnapshot {
+    double uptimeSec = 0.0;
+    QList<CameraStatsSnapshot> cameras;
+    QList<PatternStatsSnapshot> methods;        // 검사 방법별 (name == method)
+    QList<PatternStatsSnapshot> patterns;       // 패턴별 (프레임, 이름 순)
+};
+
+class InspectionStats
+{
+public:
+    static InspectionStats& instance();
+
+    // 검사 스레드에서 프레임 검사 완료 시 호출 (cycleUs: 획득 → 결과)
+    void recordFrame(int cameraIndex, int frameIndex, qint64 cycleUs,
+                     const InspectionResult& result, const QList<PatternInfo>& patterns);
+    void recordDrop(int cameraIndex, const QString& reason, quint64 count = 1);
+    void reset();
+
+    InspectionStatsSnapshot snapshot() const;
+    QJsonObject toJson() const;
+    QString toText() const;
+
+    // TeachingWidget 카운터 등 통계 모듈 밖의 값을 JSON "counters"에 추가 (메인 스레드에서 호출됨)
+    void setCounterProvider(std::function<QJsonObject()> provider);
+
+private:
+    InspectionStats();
+
+    struct CameraEntry {
+        quint64 frames = 0;
+        quint64 ng = 0;
+        QMap<QString, quint64> drops;
+        LatencyHistogram cycle;
+        std::deque<qint64> completionsMs;       // 최근 1분 완료 시각 (PPM 계산)
+    };
+
+    struct PatternEntry {
+        QString name;
+        QString method;
+        int frameIndex = -1;
+        quint64 inspected = 0;
+        quint64 ng = 0;
+        LatencyHistogram latency;
+    };
+
+    static qint64 nowMs();
+    static LatencySummary summarize(const LatencyHistogram& histogram);
+    static PatternStatsSnapshot summarize(const PatternEntry& entry);
+    CameraEntry& cameraEntry(int cameraIndex);
+    void recordPattern(const PatternInfo* pattern, const QUuid& id, const QString& method,
+                       int frameIndex, bool passed, const InspectionResult& result);
+
+    mutable QMutex m_mutex;
+    qint64 m_startMs;
+    QMap<int, CameraEntry> m_cameras;
+    QHash<QUuid, PatternEntry> m_patterns;
+    QMap<QString, PatternEntry> m_methods;
+    std::function<QJsonObject()> m_counterProvider;
+};
+
+// ===== 로컬 통계 엔드포인트 =====
+// 127.0.0.1:<StatsPort>에서 대기. 한 줄 명령(json / text / reset) 또는 HTTP GET
+// (/stats.json, /stats.txt)의 첫 줄에만 응답하고 연결을 닫는다. 포트 0이면 꺼짐.
+// 상태를 바꾸는 reset은 한 줄 명령으로만 받는다 (브라우저의 다른 웹 페이지가 GET으로 초기화하지 못하도록).
+//   예) curl http://127.0.0.1:5055/stats.json
+class InspectionStatsServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit InspectionStatsServer(QObject* parent = nullptr);
+
+    int port() const { return m_server.isListening() ? m_server.serverPort() : 0; }
+
+public slots:
+    void applySettings();                       // ConfigManager 포트 설정 반영
+
+private slots:
+    void onNewConnection();
+
+private:
+    void handleRequest(QTcpSocket* socket, const QByteArray& line);
+
+    QTcpServer m_server;
+    int m_configuredPort = 0;
+};
+
+#endif // INSPECTIONSTATS_H
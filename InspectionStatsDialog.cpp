@@ -0,0 +1,241 @@
+#include "InspectionStatsDialog.h"
+#include "ConfigManager.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QHeaderView>
+
+namespace {
+    const int STATS_REFRESH_INTERVAL_MS = 1000;
+
+    QString formatMs(qint64 us)
+    {
+        return QString::number(us / 1000.0, 'f', 2);
+    }
+
+    QString formatRate(quint64 ng, quint64 total)
+    {
+        return total ? QString::number(100.0 * ng / total, 'f', 2) + "%" : "-";
+    }
+}
+
+InspectionStatsDialog::InspectionStatsDialog(QWidget *parent)
+    : QDialog(parent)
+{
+    setWindowTitle("검사 통계");
+    setWindowFlags(Qt::Dialog | Qt::FramelessWindowHint);
+    setMinimumSize(900, 700);
+    setStyleSheet("QDialog { background-color: #1e1e1e; border: 2px solid #3d3d3d; }");
+
+    setupUI();
+
+    refreshTimer.setInterval(STATS_REFRESH_INTERVAL_MS);
+    connect(&refreshTimer, &QTimer::timeout, this, &InspectionStatsDialog::refresh);
+}
+
+QTableWidget *InspectionStatsDialog::createTable(const QStringList &headers)
+{
+    QTableWidget *table = new QTableWidget(this);
+    table->setColumnCount(headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->verticalHeader()->setVisible(false);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setStyleSheet(
+        "QTableWidget { background-color: #2d2d2d; border: 1px solid #3d3d3d; color: #ffffff; }"
+        "QTableWidget::item { padding: 3px; }"
+        "QTableWidget::item:selected { background-color: #0d47a1; }"
+        "QHeaderView::section { background-color: #1e1e1e; color: #ffffff; padding: 5px; "
+        "border: 1px solid #3d3d3d; font-weight: bold; }"
+    );
+    return table;
+}
+
+void InspectionStatsDialog::setupUI()
+{
+    QVBoxLayout *mainLayout = new QVBoxLayout(this);
+    mainLayout->setSpacing(10);
+    mainLayout->setContentsMargins(15, 15, 15, 15);
+
+    const QString sectionStyle = "QLabel { color: #ffffff; font-size: 13px; font-weight: bold; }";
+
+    summaryLabel = new QLabel(this);
+    summaryLabel->setStyleSheet("QLabel { color: #aaaaaa; font-size: 12px; }");
+    mainLayout->addWidget(summaryLabel);
+
+    // 카메라별 (사이클 = 획득 → 결과)
+    QLabel *cameraLabel = new QLabel("카메라별 처리량 / 사이클 시간 (ms)", this);
+    cameraLabel->setStyleSheet(sectionStyle);
+    mainLayout->addWidget(cameraLabel);
+    cameraTable = createTable({"카메라", "검사 수", "NG율", "PPM", "버림", "p50", "p90", "p99", "max"});
+    cameraTable->setMaximumHeight(110);
+    mainLayout->addWidget(cameraTable);
+
+    QLabel *methodLabel = new QLabel("검사 방법별 검사 시간 (ms)", this);
+    methodLabel->setStyleSheet(sectionStyle);
+    mainLayout->addWidget(methodLabel);
+    methodTable = createTable({"검사 방법", "검사 수", "NG율", "p50", "p90", "p99", "max"});
+    methodTable->setMaximumHeight(180);
+    mainLayout->addWidget(methodTable);
+
+    QLabel *patternLabel = new QLabel("패턴별 검사 시간 (ms)", this);
+    patternLabel->setStyleSheet(sectionStyle);
+    mainLayout->addWidget(patternLabel);
+    patternTable = createTable({"프레임", "패턴", "검사 방법", "검사 수", "NG율", "p50", "p90", "p99", "max"});
+    mainLayout->addWidget(patternTable, 1);
+
+    // 하단: 엔드포인트 포트, 초기화, 닫기
+    QHBoxLayout *bottomLayout = new QHBoxLayout();
+
+    QLabel *portLabel = new QLabel("통계 포트 (0: 꺼짐):", this);
+    portLabel->setStyleSheet("QLabel { color: #ffffff; font-size: 12px; }");
+    bottomLayout->addWidget(portLabel);
+
+    portSpinBox = new QSpinBox(this);
+    portSpinBox->setRange(0, 65535);
+    portSpinBox->setValue(ConfigManager::instance()->getStatsPort());
+    portSpinBox->setStyleSheet(
+        "QSpinBox { color: #ffffff; background-color: #2d2d2d; border: 1px solid #555555; padding: 4px; }");
+    connect(portSpinBox, &QSpinBox::editingFinished, this, [this]() {
+        ConfigManager::instance()->setStatsPort(portSpinBox->value());
+    });
+    bottomLayout->addWidget(portSpinBox);
+
+    bottomLayout->addStretch();
+
+    resetButton = new QPushButton("통계 초기화", this);
+    resetButton->setMinimumWidth(100);
+    resetButton->setStyleSheet(
+        "QPushButton { background-color: #424242; color: white; border: none; "
+        "padding: 8px 16px; border-radius: 4px; font-size: 13px; }"
+        "QPushButton:hover { background-color: #525252; }"
+        "QPushButton:pressed { background-color: #323232; }"
+    );
+    bottomLayout->addWidget(resetButton);
+
+    closeButton = new QPushButton("닫기", this);
+    closeButton->setMinimumWidth(80);
+    closeButton->setStyleSheet(
+        "QPushButton { background-color: #c62828; color: white; border: none; "
+        "padding: 8px 16px; border-radius: 4px; font-size: 13px; }"
+        "QPushButton:hover { background-color: #d32f2f; }"
+        "QPushButton:pressed { background-color: #b71c1c; }"
+    );
+    bottomLayout->addWidget(closeButton);
+
+    mainLayout->addLayout(bottomLayout);
+
+    connect(resetButton, &QPushButton::clicked, this, &InspectionStatsDialog::onResetClicked);
+    connect(closeButton, &QPushButton::clicked, this, &QDialog::close);
+}
+
+void InspectionStatsDialog::setCell(QTableWidget *table, int row, int column, const QString &text, bool alignRight)
+{
+    QTableWidgetItem *item = table->item(row, column);
+    if (!item)
+    {
+        item = new QTableWidgetItem();
+        item->setTextAlignment(alignRight ? (Qt::AlignRight | Qt::AlignVCenter) : (Qt::AlignLeft | Qt::AlignVCenter));
+        table->setItem(row, column, item);
+    }
+    item->setText(text);
+}
+
+void InspectionStatsDialog::setLatencyCells(QTableWidget *table, int row, int firstColumn, const LatencySummary &latency)
+{
+    setCell(table, row, firstColumn, formatMs(latency.p50));
+    setCell(table, row, firstColumn + 1, formatMs(latency.p90));
+    setCell(table, row, firstColumn + 2, formatMs(latency.p99));
+    setCell(table, row, firstColumn + 3, formatMs(latency.max));
+}
+
+void InspectionStatsDialog::refresh()
+{
+    const InspectionStatsSnapshot stats = InspectionStats::instance().snapshot();
+
+    const int port = ConfigManager::instance()->getStatsPort();
+    summaryLabel->setText(QString("집계 시간 %1초  |  엔드포인트 %2")
+                              .arg(stats.uptimeSec, 0, 'f', 0)
+                              .arg(port > 0 ? QString("127.0.0.1:%1 (json / text / reset)").arg(port) : QString("꺼짐")));
+
+    cameraTable->setRowCount(stats.cameras.size());
+    for (int row = 0; row < stats.cameras.size(); row++)
+    {
+        const CameraStatsSnapshot &camera = stats.cameras[row];
+        quint64 dropped = 0;
+        for (quint64 count : camera.drops)
+            dropped += count;
+        setCell(cameraTable, row, 0, QString("Cam%1").arg(camera.cameraIndex), false);
+        setCell(cameraTable, row, 1, QString::number(camera.frames));
+        setCell(cameraTable, row, 2, formatRate(camera.ng, camera.frames));
+        setCell(cameraTable, row, 3, QString::number(camera.partsPerMinute, 'f', 1));
+        setCell(cameraTable, row, 4, QString::number(dropped));
+        setLatencyCells(cameraTable, row, 5, camera.cycle);
+    }
+
+    methodTable->setRowCount(stats.methods.size());
+    for (int row = 0; row < stats.methods.size(); row++)
+    {
+        const PatternStatsSnapshot &method = stats.methods[row];
+        setCell(methodTable, row, 0, method.method, false);
+        setCell(methodTable, row, 1, QString::number(method.inspected));
+        setCell(methodTable, row, 2, formatRate(method.ng, method.inspected));
+        setLatencyCells(methodTable, row, 3, method.latency);
+    }
+
+    patternTable->setRowCount(stats.patterns.size());
+    for (int row = 0; row < stats.patterns.size(); row++)
+    {
+        const PatternStatsSnapshot &pattern = stats.patterns[row];
+        setCell(patternTable, row, 0, QString::number(pattern.frameIndex));
+        setCell(patternTable, row, 1, pattern.name, false);
+        setCell(patternTable, row, 2, pattern.method, false);
+        setCell(patternTable, row, 3, QString::number(pattern.inspected));
+        setCell(patternTable, row, 4, formatRate(pattern.ng, pattern.inspected));
+        setLatencyCells(patternTable, row, 5, pattern.latency);
+    }
+}
+
+void InspectionStatsDialog::onResetClicked()
+{
+    InspectionStats::instance().reset();
+    refresh();
+}
+
+void InspectionStatsDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+    refresh();
+    refreshTimer.start();
+}
+
+void InspectionStatsDialog::hideEvent(QHideEvent *event)
+{
+    refreshTimer.stop();
+    QDialog::hideEvent(event);
+}
+
+void InspectionStatsDialog::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        isDragging = true;
+        dragPosition = event->globalPosition().toPoint() - frameGeometry().topLeft();
+        event->accept();
+    }
+}
+
+void InspectionStatsDialog::mouseMoveEvent(QMouseEvent *event)
+{
+    if (isDragging && (event->buttons() & Qt::LeftButton)) {
+        move(event->globalPosition().toPoint() - dragPosition);
+        event->accept();
+    }
+}
+
+void InspectionStatsDialog::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        isDragging = false;
+        event->accept();
+    }
+}
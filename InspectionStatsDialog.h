@@ -0,0 +1,52 @@
+#ifndef INSPECTIONSTATSDIALOG_H
+#define INSPECTIONSTATSDIALOG_H
+
+#include <QDialog>
+#include <QTableWidget>
+#include <QPushButton>
+#include <QLabel>
+#include <QSpinBox>
+#include <QTimer>
+#include <QMouseEvent>
+#include "InspectionStats.h"
+
+// 검사 통계 상태 패널 (카메라별 사이클/PPM/NG율, 검사 방법별/패턴별 지연 백분위)
+// 보이는 동안 1초마다 InspectionStats 스냅샷으로 갱신한다.
+class InspectionStatsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit InspectionStatsDialog(QWidget *parent = nullptr);
+
+protected:
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+
+private slots:
+    void refresh();
+    void onResetClicked();
+
+private:
+    void setupUI();
+    QTableWidget *createTable(const QStringList &headers);
+    static void setCell(QTableWidget *table, int row, int column, const QString &text, bool alignRight = true);
+    static void setLatencyCells(QTableWidget *table, int row, int firstColumn, const LatencySummary &latency);
+
+    QLabel *summaryLabel;
+    QTableWidget *cameraTable;
+    QTableWidget *methodTable;
+    QTableWidget *patternTable;
+    QSpinBox *portSpinBox;
+    QPushButton *resetButton;
+    QPushButton *closeButton;
+    QTimer refreshTimer;
+
+    QPoint dragPosition;
+    bool isDragging = false;
+};
+
+#endif // INSPECTIONSTATSDIALOG_H
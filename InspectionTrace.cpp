@@ -0,0 +1,248 @@
+#include "InspectionTrace.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+namespace {
+    // 카메라 시계 보정값이 이보다 크게 어긋나면 (카메라 재시작 등) 다시 맞춤
+    const qint64 CAMERA_CLOCK_RESYNC_US = 1000000;
+    // 프레임당 예상 이벤트 수 (FID/INS 패턴 수에 따라 늘어남)
+    const int EVENTS_PER_FRAME_HINT = 32;
+}
+
+InspectionTracer &InspectionTracer::instance()
+{
+    static InspectionTracer tracer;
+    return tracer;
+}
+
+InspectionTracer::InspectionTracer()
+    : m_frames(CAPACITY)
+{
+    std::fill(std::begin(m_cameraClockOffsetUs), std::end(m_cameraClockOffsetUs), 0);
+    std::fill(std::begin(m_cameraClockSynced), std::end(m_cameraClockSynced), false);
+}
+
+qint64 InspectionTracer::nowUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int InspectionTracer::currentThreadId()
+{
+    // Chrome trace의 tid는 작은 정수가 보기 좋으므로 스레드마다 순번 부여
+    static std::atomic<int> nextThreadId{1};
+    thread_local int threadId = nextThreadId++;
+    return threadId;
+}
+
+void InspectionTracer::setEnabled(bool enabled)
+{
+    if (m_enabled.exchange(enabled) == enabled)
+        return;
+    if (enabled)
+        clear();
+    qDebug() << "[Trace] 지연 추적" << (enabled ? "시작" : "중지");
+}
+
+void InspectionTracer::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    for (InspectionFrameTrace &frame : m_frames)
+        frame = InspectionFrameTrace();
+    std::fill(std::begin(m_cameraClockSynced), std::end(m_cameraClockSynced), false);
+}
+
+InspectionFrameTrace *InspectionTracer::slotFor(quint64 traceId)
+{
+    // 링 버퍼가 한 바퀴 돌아 덮어쓴 프레임이면 nullptr (늦게 도착한 기록은 버림)
+    InspectionFrameTrace &frame = m_frames[traceId % CAPACITY];
+    return (frame.traceId == traceId) ? &frame : nullptr;
+}
+
+quint64 InspectionTracer::beginFrame(int cameraIndex, int frameIndex, qint64 arrivalUs, quint64 cameraTimestampNs)
+{
+    if (!isEnabled())
+        return 0;
+
+    const quint64 traceId = m_nextTraceId++;
+    const int threadId = currentThreadId();
+
+    QMutexLocker locker(&m_mutex);
+    InspectionFrameTrace &frame = m_frames[traceId % CAPACITY];
+    frame = InspectionFrameTrace();
+    frame.traceId = traceId;
+    frame.cameraIndex = cameraIndex;
+    frame.frameIndex = frameIndex;
+    frame.cameraTimestampNs = cameraTimestampNs;
+    frame.events.reserve(EVENTS_PER_FRAME_HINT);
+
+    // 카메라 시계 → 호스트 시계: (도착 - 카메라 시각)의 최솟값을 보정값으로 사용
+    // (전송이 가장 빨랐던 프레임 기준이므로 구간 길이는 최소 전송 시간을 뺀 추가 지연)
+    if (cameraTimestampNs > 0 && cameraIndex >= 0 && cameraIndex < MAX_CAMERAS)
+    {
+        const qint64 cameraUs = static_cast<qint64>(cameraTimestampNs / 1000);
+        const qint64 offset = arrivalUs - cameraUs;
+        if (!m_cameraClockSynced[cameraIndex] || offset < m_cameraClockOffsetUs[cameraIndex] ||
+            offset - m_cameraClockOffsetUs[cameraIndex] > CAMERA_CLOCK_RESYNC_US)
+        {
+            m_cameraClockOffsetUs[cameraIndex] = offset;
+            m_cameraClockSynced[cameraIndex] = true;
+        }
+
+        InspectionTraceEvent exposure;
+        exposure.category = "acquire";
+        exposure.name = QStringLiteral("노출 종료 → 버퍼 도착");
+        exposure.startUs = cameraUs + m_cameraClockOffsetUs[cameraIndex];
+        exposure.durationUs = arrivalUs - exposure.startUs;
+        exposure.threadId = threadId;
+        frame.events.append(exposure);
+    }
+
+    InspectionTraceEvent arrival;
+    arrival.category = "acquire";
+    arrival.name = QStringLiteral("버퍼 도착");
+    arrival.startUs = arrivalUs;
+    arrival.threadId = threadId;
+    frame.events.append(arrival);
+    return traceId;
+}
+
+void InspectionTracer::setFrameIndex(quint64 traceId, int frameIndex)
+{
+    if (traceId == 0)
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (InspectionFrameTrace *frame = slotFor(traceId))
+        frame->frameIndex = frameIndex;
+}
+
+void InspectionTracer::addSpan(quint64 traceId, const char *category, const QString &name, qint64 startUs, qint64 endUs)
+{
+    if (traceId == 0 || !isEnabled())
+        return;
+
+    InspectionTraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.startUs = startUs;
+    event.durationUs = std::max<qint64>(0, endUs - startUs);
+    event.threadId = currentThreadId();
+
+    QMutexLocker locker(&m_mutex);
+    if (InspectionFrameTrace *frame = slotFor(traceId))
+        frame->events.append(event);
+}
+
+void InspectionTracer::addInstant(quint64 traceId, const char *category, const QString &name, qint64 timeUs)
+{
+    if (traceId == 0 || !isEnabled())
+        return;
+
+    InspectionTraceEvent event;
+    event.category = category;
+    event.name = name;
+    event.startUs = (timeUs >= 0) ? timeUs : nowUs();
+    event.threadId = currentThreadId();
+
+    QMutexLocker locker(&m_mutex);
+    if (InspectionFrameTrace *frame = slotFor(traceId))
+        frame->events.append(event);
+}
+
+void InspectionTracer::endFrame(quint64 traceId)
+{
+    if (traceId == 0)
+        return;
+    QMutexLocker locker(&m_mutex);
+    if (InspectionFrameTrace *frame = slotFor(traceId))
+        frame->finished = true;
+}
+
+int InspectionTracer::exportChromeTrace(const QString &filePath) const
+{
+    // 잠금은 복사 동안만 (파일 쓰기 중에도 검사 스레드가 계속 기록)
+    std::vector<InspectionFrameTrace> frames;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const InspectionFrameTrace &frame : m_frames)
+        {
+            if (frame.traceId != 0)
+                frames.push_back(frame);
+        }
+    }
+    std::sort(frames.begin(), frames.end(), [](const InspectionFrameTrace &a, const InspectionFrameTrace &b) {
+        return a.traceId < b.traceId;
+    });
+
+    QJsonArray traceEvents;
+    bool cameraNamed[MAX_CAMERAS] = {false, false, false, false};
+    for (const InspectionFrameTrace &frame : frames)
+    {
+        const int pid = std::max(0, frame.cameraIndex);
+        if (pid < MAX_CAMERAS && !cameraNamed[pid])
+        {
+            QJsonObject meta;
+            meta["name"] = "process_name";
+            meta["ph"] = "M";
+            meta["pid"] = pid;
+            meta["args"] = QJsonObject{{"name", QString("Cam%1").arg(pid)}};
+            traceEvents.append(meta);
+            cameraNamed[pid] = true;
+        }
+
+        QJsonObject args;
+        args["trace"] = static_cast<qint64>(frame.traceId);
+        args["frame"] = frame.frameIndex;
+        args["finished"] = frame.finished;
+        if (frame.cameraTimestampNs > 0)
+            args["cameraTimestampNs"] = QString::number(frame.cameraTimestampNs);  // 2^53 초과 가능
+
+        for (const InspectionTraceEvent &event : frame.events)
+        {
+            QJsonObject entry;
+            entry["name"] = event.name;  // 프레임 번호는 args (같은 단계끼리 통계 집계되도록)
+            entry["cat"] = QString::fromLatin1(event.category);
+            entry["ts"] = static_cast<double>(event.startUs);
+            entry["pid"] = pid;
+            entry["tid"] = event.threadId;
+            entry["args"] = args;
+            if (event.durationUs >= 0)
+            {
+                entry["ph"] = "X";
+                entry["dur"] = static_cast<double>(event.durationUs);
+            }
+            else
+            {
+                entry["ph"] = "i";
+                entry["s"] = "t";
+            }
+            traceEvents.append(entry);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QDir().mkpath(QFileInfo(filePath).absolutePath());
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "[Trace] 추적 파일 저장 실패:" << filePath;
+        return -1;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+
+    qDebug().noquote() << QString("[Trace] %1 프레임 추적 저장: %2").arg(frames.size()).arg(filePath);
+    return static_cast<int>(frames.size());
+}
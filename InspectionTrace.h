@@ -0,0 +1,98 @@
+#ifndef INSPECTIONTRACE_H
+#define INSPECTIONTRACE_H
+
+#include <QMutex>
+#include <QString>
+#include <QVector>
+#include <atomic>
+#include <vector>
+
+// ===== 트리거 → 결과 지연 추적 =====
+// 프레임마다 추적 ID를 발급하고 단계별 구간(노출 종료, 버퍼 도착, 변환, FID/INS 검사,
+// ANOMALY 추론, 시리얼 응답, UI 발행)을 링 버퍼에 기록한다. Chrome trace JSON으로 내보내
+// chrome://tracing 또는 Perfetto에서 카메라(pid)/스레드(tid)별 타임라인으로 볼 수 있다.
+// 꺼져 있으면 beginFrame이 0을 돌려주고, 추적 ID 0에 대한 기록은 모두 무시된다.
+
+struct InspectionTraceEvent {
+    const char* category = "";              // 정적 문자열만 사용 (복사하지 않음)
+    QString name;
+    qint64 startUs = 0;                     // steady_clock 기준 마이크로초
+    qint64 durationUs = -1;                 // -1: 순간 이벤트
+    int threadId = 0;
+};
+
+struct InspectionFrameTrace {
+    quint64 traceId = 0;                    // 0: 빈 슬롯
+    int cameraIndex = -1;
+    int frameIndex = -1;
+    quint64 cameraTimestampNs = 0;          // Spinnaker 이미지 타임스탬프 (카메라 시계)
+    bool finished = false;
+    QVector<InspectionTraceEvent> events;
+};
+
+class InspectionTracer
+{
+public:
+    static InspectionTracer& instance();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    static qint64 nowUs();
+
+    // 획득 스레드에서 프레임 도착 시 호출. cameraTimestampNs가 있으면 노출 종료 ~ 도착 구간도 기록
+    quint64 beginFrame(int cameraIndex, int frameIndex, qint64 arrivalUs, quint64 cameraTimestampNs = 0);
+    void setFrameIndex(quint64 traceId, int frameIndex);
+    void addSpan(quint64 traceId, const char* category, const QString& name, qint64 startUs, qint64 endUs);
+    void addInstant(quint64 traceId, const char* category, const QString& name, qint64 timeUs = -1);
+    void endFrame(quint64 traceId);
+
+    // 링 버퍼에 남은 프레임을 Chrome trace JSON 파일로 저장 (저장한 프레임 수, 실패 시 -1)
+    int exportChromeTrace(const QString& filePath) const;
+    void clear();
+
+private:
+    InspectionTracer();
+    InspectionFrameTrace* slotFor(quint64 traceId);
+    static int currentThreadId();
+
+    static const int CAPACITY = 256;        // 보관 프레임 수 (오래된 프레임부터 덮어씀)
+    static const int MAX_CAMERAS = 4;
+
+    mutable QMutex m_mutex;
+    std::vector<InspectionFrameTrace> m_frames;
+    std::atomic<bool> m_enabled{false};
+    std::atomic<quint64> m_nextTraceId{1};
+    qint64 m_cameraClockOffsetUs[MAX_CAMERAS];
+    bool m_cameraClockSynced[MAX_CAMERAS];
+};
+
+// 범위를 벗어날 때 구간을 기록 (추적 ID 0이면 시각도 읽지 않음)
+class InspectionTraceScope
+{
+public:
+    InspectionTraceScope(quint64 traceId, const char* category, const QString& name)
+        : m_traceId(InspectionTracer::instance().isEnabled() ? traceId : 0),
+          m_category(category),
+          m_name(m_traceId ? name : QString()),
+          m_startUs(m_traceId ? InspectionTracer::nowUs() : 0)
+    {
+    }
+
+    ~InspectionTraceScope()
+    {
+        if (m_traceId)
+            InspectionTracer::instance().addSpan(m_traceId, m_category, m_name, m_startUs, InspectionTracer::nowUs());
+    }
+
+    InspectionTraceScope(const InspectionTraceScope&) = delete;
+    InspectionTraceScope& operator=(const InspectionTraceScope&) = delete;
+
+private:
+    quint64 m_traceId;
+    const char* m_category;
+    QString m_name;
+    qint64 m_startUs;
+};
+
+#endif // INSPECTIONTRACE_H
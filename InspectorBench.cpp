@@ -0,0 +1,451 @@
+// ===== inspector_bench: 헤드리스 레시피 재생/벤치마크 =====
+// 카메라와 GUI 없이 레시피 XML을 이미지 폴더에 돌려 검사 성능을 측정한다.
+//   inspector_bench --recipe recipes/A/A.xml --images ./samples --threads 2 --repeat 10 --output bench.json
+// 검사 스레드마다 InsProcessor를 하나씩 두고 (앱의 카메라별 검사 워커와 같은 구성)
+// 처리량, 검사 지연 백분위, 프레임/검사 방법/패턴별 결과를 JSON으로 출력한다.
+// ANOMALY 모델은 앱과 같이 실행 파일 폴더의 recipes/<레시피명>/weights에서 찾으므로 deploy 폴더에서 실행한다.
+// 종료 코드: 0 정상, 1 인자/레시피/이미지 오류, 2 검사 중 예외 발생
+
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+#include "CommonDefs.h"
+#include "InsProcessor.h"
+#include "InspectionStats.h"
+#include "RecipeManager.h"
+
+namespace {
+    const int DEFAULT_WARMUP_PER_THREAD = 3;
+    bool verboseLogging = false;
+
+    struct BenchImage {
+        QString fileName;
+        cv::Mat image;
+    };
+
+    struct BenchJob {
+        int imageIndex = -1;
+        int frameIndex = -1;
+    };
+
+    // 이미지 × 프레임 조합별 결과 (반복 실행 누적)
+    struct BenchJobResult {
+        quint64 runs = 0;
+        quint64 ngRuns = 0;
+        quint64 errors = 0;
+        qint64 totalUs = 0;
+        QStringList ngPatterns;                 // 마지막 실행에서 NG인 패턴 이름
+    };
+
+    qint64 nowUs()
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 검사 코드의 qDebug 출력은 --verbose일 때만 (측정 중 콘솔 출력 비용 제외)
+    void benchMessageHandler(QtMsgType type, const QMessageLogContext &, const QString &msg)
+    {
+        if (type == QtDebugMsg && !verboseLogging)
+            return;
+        fprintf(stderr, "%s\n", msg.toLocal8Bit().constData());
+    }
+
+    QJsonObject latencyToJson(const LatencySummary &latency)
+    {
+        QJsonObject obj;
+        obj["count"] = static_cast<qint64>(latency.count);
+        obj["p50_us"] = latency.p50;
+        obj["p90_us"] = latency.p90;
+        obj["p99_us"] = latency.p99;
+        obj["max_us"] = latency.max;
+        obj["mean_us"] = std::round(latency.mean);
+        return obj;
+    }
+
+    QJsonObject patternStatsToJson(const PatternStatsSnapshot &stats)
+    {
+        QJsonObject obj;
+        obj["name"] = stats.name;
+        obj["method"] = stats.method;
+        if (stats.frameIndex >= 0)
+            obj["frame"] = stats.frameIndex;
+        obj["inspected"] = static_cast<qint64>(stats.inspected);
+        obj["ng"] = static_cast<qint64>(stats.ng);
+        obj["latency"] = latencyToJson(stats.latency);
+        return obj;
+    }
+
+    // --recipe: XML 경로 또는 recipes 폴더의 레시피 이름
+    QString resolveRecipeFile(RecipeManager &recipeManager, const QString &recipe)
+    {
+        if (QFileInfo(recipe).isFile())
+            return QFileInfo(recipe).absoluteFilePath();
+        return QDir(recipeManager.getRecipesDirectory()).absoluteFilePath(recipe + "/" + recipe + ".xml");
+    }
+
+    QList<BenchImage> loadImages(const QString &dirPath)
+    {
+        QList<BenchImage> images;
+        const QStringList nameFilters = {"*.png", "*.jpg", "*.jpeg", "*.bmp", "*.tif", "*.tiff"};
+        const QFileInfoList files = QDir(dirPath).entryInfoList(nameFilters, QDir::Files, QDir::Name | QDir::IgnoreCase);
+        for (const QFileInfo &fileInfo : files)
+        {
+            // 앱의 검사 입력과 같은 BGR 3채널
+            cv::Mat image = cv::imread(fileInfo.absoluteFilePath().toStdString(), cv::IMREAD_COLOR);
+            if (image.empty())
+            {
+                qWarning().noquote() << "[Bench] 이미지를 읽을 수 없음:" << fileInfo.fileName();
+                continue;
+            }
+            images.append({fileInfo.fileName(), image});
+        }
+        return images;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // InsProcessor 결과 그리기(QPainter/QFont)에 GUI 애플리케이션이 필요 → 화면 없이 offscreen
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app(argc, argv);
+    QCoreApplication::setApplicationName("inspector_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("레시피를 이미지 폴더에 재생하여 검사 처리량/지연을 측정합니다.");
+    parser.addHelpOption();
+    QCommandLineOption recipeOption("recipe", "레시피 XML 경로 또는 recipes 폴더의 레시피 이름", "recipe");
+    QCommandLineOption imagesOption("images", "검사할 이미지 폴더 (png/jpg/bmp/tif)", "dir");
+    QCommandLineOption frameOption("frame", "검사할 프레임 인덱스 (all: 이미지마다 모든 프레임)", "index", "all");
+    QCommandLineOption threadsOption("threads", "동시에 검사하는 스레드 수 (스레드마다 InsProcessor 하나)", "count", "1");
+    QCommandLineOption repeatOption("repeat", "이미지 × 프레임 조합을 반복 측정할 횟수", "count", "1");
+    QCommandLineOption warmupOption("warmup", "스레드별 측정 전 워밍업 검사 수",
+                                    "count", QString::number(DEFAULT_WARMUP_PER_THREAD));
+    QCommandLineOption outputOption("output", "JSON 결과 파일 (생략 시 표준 출력)", "file");
+    QCommandLineOption recipeNameOption("recipe-name", "ANOMALY 모델 폴더용 레시피 이름 (기본: 레시피 파일 이름)", "name");
+    QCommandLineOption verboseOption("verbose", "검사 디버그 로그 출력");
+    parser.addOptions({recipeOption, imagesOption, frameOption, threadsOption, repeatOption,
+                       warmupOption, outputOption, recipeNameOption, verboseOption});
+    parser.process(app);
+
+    verboseLogging = parser.isSet(verboseOption);
+    qInstallMessageHandler(benchMessageHandler);
+
+    if (!parser.isSet(recipeOption) || !parser.isSet(imagesOption))
+    {
+        fprintf(stderr, "--recipe와 --images는 필수입니다.\n\n%s", parser.helpText().toLocal8Bit().constData());
+        return 1;
+    }
+
+    bool ok = false;
+    const int threadCount = parser.value(threadsOption).toInt(&ok);
+    if (!ok || threadCount < 1)
+    {
+        fprintf(stderr, "잘못된 --threads 값\n");
+        return 1;
+    }
+    const int repeatCount = parser.value(repeatOption).toInt(&ok);
+    if (!ok || repeatCount < 1)
+    {
+        fprintf(stderr, "잘못된 --repeat 값\n");
+        return 1;
+    }
+    const int warmupCount = parser.value(warmupOption).toInt(&ok);
+    if (!ok || warmupCount < 0)
+    {
+        fprintf(stderr, "잘못된 --warmup 값\n");
+        return 1;
+    }
+
+    // ===== 레시피 로드 =====
+    RecipeManager recipeManager;
+    const QString recipeFile = resolveRecipeFile(recipeManager, parser.value(recipeOption));
+    QVector<PatternInfo> recipePatterns;
+    if (!recipeManager.loadPatternsFromFile(recipeFile, recipePatterns))
+    {
+        fprintf(stderr, "레시피 로드 실패: %s\n", recipeManager.getLastError().toLocal8Bit().constData());
+        return 1;
+    }
+    const QString recipeName = parser.isSet(recipeNameOption) ? parser.value(recipeNameOption)
+                                                              : QFileInfo(recipeFile).completeBaseName();
+
+    // runInspect와 같은 기준: 프레임별 활성 패턴
+    QMap<int, QList<PatternInfo>> framePatterns;
+    QList<PatternInfo> enabledPatterns;
+    for (const PatternInfo &pattern : recipePatterns)
+    {
+        if (!pattern.enabled)
+            continue;
+        framePatterns[pattern.frameIndex].append(pattern);
+        enabledPatterns.append(pattern);
+    }
+
+    QList<int> frameIndices;
+    const QString frameValue = parser.value(frameOption);
+    if (frameValue == "all")
+    {
+        frameIndices = framePatterns.keys();
+    }
+    else
+    {
+        const int frameIndex = frameValue.toInt(&ok);
+        if (!ok || !framePatterns.contains(frameIndex))
+        {
+            fprintf(stderr, "레시피에 활성 패턴이 있는 프레임이 아님: %s\n", frameValue.toLocal8Bit().constData());
+            return 1;
+        }
+        frameIndices.append(frameIndex);
+    }
+    if (frameIndices.isEmpty())
+    {
+        fprintf(stderr, "레시피에 활성 패턴이 없습니다: %s\n", recipeFile.toLocal8Bit().constData());
+        return 1;
+    }
+
+    // ===== 이미지 로드 (디스크 읽기/디코딩은 측정에서 제외) =====
+    const QList<BenchImage> images = loadImages(parser.value(imagesOption));
+    if (images.isEmpty())
+    {
+        fprintf(stderr, "검사할 이미지가 없습니다: %s\n", parser.value(imagesOption).toLocal8Bit().constData());
+        return 1;
+    }
+
+    std::vector<BenchJob> jobs;
+    for (int imageIndex = 0; imageIndex < images.size(); imageIndex++)
+    {
+        for (int frameIndex : frameIndices)
+            jobs.push_back({imageIndex, frameIndex});
+    }
+
+    fprintf(stderr, "[Bench] 레시피 %s: 패턴 %d개, 프레임 %d개 | 이미지 %d장 | 스레드 %d, 반복 %d, 워밍업 %d\n",
+            recipeName.toLocal8Bit().constData(), static_cast<int>(enabledPatterns.size()),
+            static_cast<int>(frameIndices.size()), static_cast<int>(images.size()),
+            threadCount, repeatCount, warmupCount);
+
+    // ===== 검사기 준비 (앱의 레시피 선택 시점과 같은 계획 컴파일/모델 워밍업) =====
+    std::vector<std::unique_ptr<InsProcessor>> processors;
+    for (int i = 0; i < threadCount; i++)
+    {
+        processors.push_back(std::make_unique<InsProcessor>());
+        for (int frameIndex : frameIndices)
+            processors.back()->compileInspectionPlan(framePatterns[frameIndex], recipeName);
+    }
+    processors.front()->warmupAnomalyModels(enabledPatterns, recipeName);
+
+    // 검사 스레드에서는 읽기 전용 접근만 (QMap::operator[]는 공유 데이터 분리/삽입 가능)
+    auto patternsFor = [&framePatterns](int frameIndex) -> const QList<PatternInfo> & {
+        return *framePatterns.constFind(frameIndex);
+    };
+
+    auto runWorkers = [&](const std::function<void(int)> &work) {
+        QList<QThread *> threads;
+        for (int i = 0; i < threadCount; i++)
+            threads.append(QThread::create(work, i));
+        for (QThread *thread : threads)
+            thread->start();
+        for (QThread *thread : threads)
+        {
+            thread->wait();
+            delete thread;
+        }
+    };
+
+    runWorkers([&](int worker) {
+        for (int i = 0; i < warmupCount; i++)
+        {
+            const BenchJob &job = jobs[(worker + i * threadCount) % jobs.size()];
+            try {
+                processors[worker]->performInspection(FrameContext(images[job.imageIndex].image),
+                                                      patternsFor(job.frameIndex));
+            } catch (...) {
+                // 측정 단계에서 오류로 집계
+            }
+        }
+    });
+
+    // ===== 측정 =====
+    // 프레임/패턴/검사 방법별 집계는 앱과 같은 InspectionStats 사용 (카메라 자리에 프레임 인덱스)
+    InspectionStats::instance().reset();
+    std::vector<BenchJobResult> jobResults(jobs.size());
+    LatencyHistogram overallLatency;
+    QMutex resultMutex;
+    std::atomic<quint64> nextRun{0};
+    const quint64 totalRuns = static_cast<quint64>(jobs.size()) * repeatCount;
+
+    const qint64 benchStartUs = nowUs();
+    runWorkers([&](int worker) {
+        InsProcessor *processor = processors[worker].get();
+        for (quint64 run = nextRun++; run < totalRuns; run = nextRun++)
+        {
+            const size_t jobIndex = run % jobs.size();
+            const BenchJob &job = jobs[jobIndex];
+            const QList<PatternInfo> &patterns = patternsFor(job.frameIndex);
+
+            InspectionResult result;
+            bool failed = false;
+            const qint64 startUs = nowUs();
+            try {
+                result = processor->performInspection(FrameContext(images[job.imageIndex].image), patterns);
+            } catch (const std::exception &e) {
+                failed = true;
+                qWarning().noquote() << "[Bench] 검사 오류:" << images[job.imageIndex].fileName << e.what();
+            } catch (...) {
+                failed = true;
+                qWarning().noquote() << "[Bench] 검사 오류:" << images[job.imageIndex].fileName;
+            }
+            const qint64 elapsedUs = nowUs() - startUs;
+
+            if (!failed)
+                InspectionStats::instance().recordFrame(job.frameIndex, job.frameIndex, elapsedUs, result, patterns);
+
+            QStringList ngPatterns;
+            if (!failed && !result.isPassed)
+            {
+                for (const PatternInfo &pattern : patterns)
+                {
+                    if (!result.fidResults.value(pattern.id, true) || !result.insResults.value(pattern.id, true))
+                        ngPatterns.append(pattern.name);
+                }
+            }
+
+            QMutexLocker locker(&resultMutex);
+            BenchJobResult &jobResult = jobResults[jobIndex];
+            if (failed)
+            {
+                jobResult.errors++;
+                continue;
+            }
+            overallLatency.record(elapsedUs);
+            jobResult.runs++;
+            jobResult.totalUs += elapsedUs;
+            if (!result.isPassed)
+                jobResult.ngRuns++;
+            jobResult.ngPatterns = ngPatterns;
+        }
+    });
+    const double wallSec = (nowUs() - benchStartUs) / 1000000.0;
+
+    // ===== 결과 JSON =====
+    const InspectionStatsSnapshot stats = InspectionStats::instance().snapshot();
+
+    quint64 inspections = 0;
+    quint64 errors = 0;
+    quint64 ngCount = 0;
+    QJsonArray results;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const BenchJobResult &jobResult = jobResults[i];
+        inspections += jobResult.runs;
+        errors += jobResult.errors;
+        ngCount += jobResult.ngRuns;
+
+        QJsonObject entry;
+        entry["image"] = images[jobs[i].imageIndex].fileName;
+        entry["frame"] = jobs[i].frameIndex;
+        entry["runs"] = static_cast<qint64>(jobResult.runs);
+        entry["ng_runs"] = static_cast<qint64>(jobResult.ngRuns);
+        entry["passed"] = jobResult.runs > 0 && jobResult.ngRuns == 0 && jobResult.errors == 0;
+        entry["mean_us"] = jobResult.runs ? static_cast<qint64>(jobResult.totalUs / jobResult.runs) : 0;
+        if (jobResult.errors > 0)
+            entry["errors"] = static_cast<qint64>(jobResult.errors);
+        if (!jobResult.ngPatterns.isEmpty())
+            entry["ng_patterns"] = QJsonArray::fromStringList(jobResult.ngPatterns);
+        results.append(entry);
+    }
+
+    LatencySummary latency;
+    latency.count = overallLatency.count();
+    latency.p50 = overallLatency.percentile(50.0);
+    latency.p90 = overallLatency.percentile(90.0);
+    latency.p99 = overallLatency.percentile(99.0);
+    latency.max = overallLatency.max();
+    latency.mean = overallLatency.mean();
+
+    QJsonObject config;
+    config["recipe"] = recipeFile;
+    config["recipe_name"] = recipeName;
+    config["images_dir"] = QDir(parser.value(imagesOption)).absolutePath();
+    config["images"] = static_cast<int>(images.size());
+    QJsonArray frameArray;
+    for (int frameIndex : frameIndices)
+        frameArray.append(frameIndex);
+    config["frames"] = frameArray;
+    config["patterns"] = static_cast<int>(enabledPatterns.size());
+    config["threads"] = threadCount;
+    config["repeat"] = repeatCount;
+    config["warmup"] = warmupCount;
+
+    QJsonObject summary;
+    summary["inspections"] = static_cast<qint64>(inspections);
+    summary["ng"] = static_cast<qint64>(ngCount);
+    summary["errors"] = static_cast<qint64>(errors);
+    summary["wall_sec"] = wallSec;
+    summary["throughput_per_sec"] = wallSec > 0.0 ? inspections / wallSec : 0.0;
+    summary["latency"] = latencyToJson(latency);
+
+    QJsonArray frameStats;
+    for (const CameraStatsSnapshot &frame : stats.cameras)
+    {
+        QJsonObject obj;
+        obj["frame"] = frame.cameraIndex;
+        obj["inspected"] = static_cast<qint64>(frame.frames);
+        obj["ng"] = static_cast<qint64>(frame.ng);
+        obj["latency"] = latencyToJson(frame.cycle);
+        frameStats.append(obj);
+    }
+    QJsonArray methodStats;
+    for (const PatternStatsSnapshot &method : stats.methods)
+        methodStats.append(patternStatsToJson(method));
+    QJsonArray patternStats;
+    for (const PatternStatsSnapshot &pattern : stats.patterns)
+        patternStats.append(patternStatsToJson(pattern));
+
+    QJsonObject root;
+    root["config"] = config;
+    root["summary"] = summary;
+    root["frames"] = frameStats;
+    root["methods"] = methodStats;
+    root["patterns"] = patternStats;
+    root["results"] = results;
+    const QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    fprintf(stderr, "[Bench] 검사 %llu회 (NG %llu, 오류 %llu) / %.2f초 = %.1f회/초 | p50=%.2fms p90=%.2fms p99=%.2fms max=%.2fms\n",
+            static_cast<unsigned long long>(inspections), static_cast<unsigned long long>(ngCount),
+            static_cast<unsigned long long>(errors), wallSec, wallSec > 0.0 ? inspections / wallSec : 0.0,
+            latency.p50 / 1000.0, latency.p90 / 1000.0, latency.p99 / 1000.0, latency.max / 1000.0);
+
+    if (parser.isSet(outputOption))
+    {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            fprintf(stderr, "결과 파일을 쓸 수 없습니다: %s\n", parser.value(outputOption).toLocal8Bit().constData());
+            return 1;
+        }
+        file.write(json);
+        file.close();
+    }
+    else
+    {
+        fwrite(json.constData(), 1, json.size(), stdout);
+    }
+
+    return errors > 0 ? 2 : 0;
+}
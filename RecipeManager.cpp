@@ -300,7 +300,7 @@ bool RecipeManager::saveRecipe(const QString& fileName,
         bool hasTeachingImages = false;
         if (teachingWidget) {
             hasTeachingImages = (camIdx < static_cast<int>(teachingWidget->cameraFrames.size()) &&
-                                !teachingWidget->cameraFrames[camIdx].empty());
+                                !teachingWidget->cameraFrames.load(camIdx).empty());
         }
         
         if (patternCount == 0 && !isSimulationCamera && !isCurrentCamera && !hasTeachingImages) {
@@ -314,9 +314,10 @@ bool RecipeManager::saveRecipe(const QString& fileName,
         
         // 먼저 width, height 속성 추가 (이미지 크기 정보)
         cv::Mat sizeCheckImage;
-        if (teachingWidget && camIdx >= 0 && camIdx < static_cast<int>(teachingWidget->cameraFrames.size()) && 
-            !teachingWidget->cameraFrames[camIdx].empty()) {
-            sizeCheckImage = teachingWidget->cameraFrames[camIdx];
+        cv::Mat published = (teachingWidget && camIdx >= 0 && camIdx < static_cast<int>(teachingWidget->cameraFrames.size()))
+                                ? teachingWidget->cameraFrames.load(camIdx) : cv::Mat();
+        if (!published.empty()) {
+            sizeCheckImage = published;
         } else if (teachingWidget) {
             sizeCheckImage = teachingWidget->getCurrentFrame();
         }
@@ -334,14 +335,14 @@ bool RecipeManager::saveRecipe(const QString& fileName,
             // frameIndex = camIdx (1:1 매핑)
             int frameIndex = camIdx;
             
-            bool hasImage = frameIndex < static_cast<int>(teachingWidget->cameraFrames.size()) &&
-                           !teachingWidget->cameraFrames[frameIndex].empty();
+            cv::Mat frameImage = frameIndex < static_cast<int>(teachingWidget->cameraFrames.size())
+                                     ? teachingWidget->cameraFrames.load(frameIndex) : cv::Mat();
+            bool hasImage = !frameImage.empty();
             
             // 해당 프레임의 이미지 저장
             if (hasImage) {
                 std::vector<int> params = {cv::IMWRITE_JPEG_QUALITY, 95};
                 std::vector<uchar> buffer;
-                cv::Mat frameImage = teachingWidget->cameraFrames[frameIndex];
                 
                 if (cv::imencode(".jpg", frameImage, buffer, params)) {
                     QByteArray imageData(reinterpret_cast<const char*>(buffer.data()), buffer.size());
@@ -359,9 +360,10 @@ bool RecipeManager::saveRecipe(const QString& fileName,
                 cv::Mat currentImage;
                 
                 // 해당 카메라의 cameraFrames에서 이미지 가져오기
-                if (camIdx >= 0 && camIdx < static_cast<int>(teachingWidget->cameraFrames.size()) && 
-                    !teachingWidget->cameraFrames[camIdx].empty()) {
-                    currentImage = teachingWidget->cameraFrames[camIdx];
+                cv::Mat slotImage = (camIdx >= 0 && camIdx < static_cast<int>(teachingWidget->cameraFrames.size()))
+                                        ? teachingWidget->cameraFrames.load(camIdx) : cv::Mat();
+                if (!slotImage.empty()) {
+                    currentImage = slotImage;
                 } else {
                     // cameraFrames에 없으면 현재 프레임 사용 (fallback)
                     currentImage = teachingWidget->getCurrentFrame();
@@ -570,7 +572,7 @@ bool RecipeManager::loadRecipe(const QString& fileName,
         QStringList imagePaths;
         // 더미 경로를 생성해서 콜백 호출 (실제 파일은 없지만 cameraFrames에 이미지가 있음)
         for (int i = 0; i < static_cast<int>(teachingWidget->cameraFrames.size()); i++) {
-            if (!teachingWidget->cameraFrames[i].empty()) {
+            if (!teachingWidget->cameraFrames.load(i).empty()) {
                 imagePaths.append(QString("base64_image_%1").arg(i));
             }
         }
@@ -1057,7 +1059,7 @@ bool RecipeManager::readCameraSection(QXmlStreamReader& xml,
                             // 안전한 복사
                             cv::Mat clonedImage = teachingImage.clone();
                             if (!clonedImage.empty() && clonedImage.data) {
-                                teachingWidget->cameraFrames[cameraIdx] = std::move(clonedImage);
+                                teachingWidget->cameraFrames.store(cameraIdx, std::move(clonedImage));
                                 qDebug() << QString("카메라 (imageIndex %1, 배열인덱스 %2) base64 티칭 이미지를 cameraFrames에 직접 설정: %3x%4")
                                             .arg(imageIndex).arg(cameraIdx).arg(teachingImage.cols).arg(teachingImage.rows);
                             } else {
@@ -1102,7 +1104,7 @@ bool RecipeManager::readCameraSection(QXmlStreamReader& xml,
                                 // 안전한 복사
                                 cv::Mat clonedImage = teachingImage.clone();
                                 if (!clonedImage.empty() && clonedImage.data) {
-                                    teachingWidget->cameraFrames[imageIndex] = std::move(clonedImage);
+                                    teachingWidget->cameraFrames.store(imageIndex, std::move(clonedImage));
                                     qDebug() << QString("[RecipeManager] Teaching image saved at imageIndex %1: %2x%3")
                                                 .arg(imageIndex).arg(teachingImage.cols).arg(teachingImage.rows);
                                 } else {
@@ -2216,9 +2218,19 @@ bool RecipeManager::loadRecipeByName(const QString& recipeName, QVector<PatternI
     // 새로운 구조만 지원: recipes/레시피명/레시피명.xml
     QString fileName = QDir(getRecipesDirectory()).absoluteFilePath(recipeName + "/" + recipeName + ".xml");
     
+    if (!QFile::exists(fileName)) {
+        setError(QString("레시피 파일이 존재하지 않습니다: %1").arg(recipeName));
+        return false;
+    }
+    
+    return loadPatternsFromFile(fileName, patterns, false);
+}
+
+bool RecipeManager::loadPatternsFromFile(const QString& fileName, QVector<PatternInfo>& patterns,
+                                         bool includeChildPatterns) {
     QFile file(fileName);
     if (!file.exists()) {
-        setError(QString("레시피 파일이 존재하지 않습니다: %1").arg(recipeName));
+        setError(QString("레시피 파일이 존재하지 않습니다: %1").arg(fileName));
         return false;
     }
     
@@ -2228,6 +2240,7 @@ bool RecipeManager::loadRecipeByName(const QString& recipeName, QVector<PatternI
     }
     
     patterns.clear();
+    tempChildPatterns.clear();
     
     QXmlStreamReader xml(&file);
     
@@ -2285,6 +2298,14 @@ bool RecipeManager::loadRecipeByName(const QString& recipeName, QVector<PatternI
         return false;
     }
     
+    // 자식 패턴(FID 아래 INS 등)은 CameraView처럼 평탄한 목록에 추가 (parentId로 관계 유지)
+    if (includeChildPatterns) {
+        for (const PatternInfo& childPattern : tempChildPatterns) {
+            patterns.append(childPattern);
+        }
+    }
+    tempChildPatterns.clear();
+    
     file.close();
     return true;
 }
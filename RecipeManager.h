@@ -56,6 +56,10 @@ public:
     // 개별 레시피 파일 관리 (시뮬레이션용)
     bool saveRecipeByName(const QString& recipeName, const QVector<PatternInfo>& patterns);
     bool loadRecipeByName(const QString& recipeName, QVector<PatternInfo>& patterns);
+    // 레시피 XML 파일 경로로 패턴 목록만 읽기 (UI 없이 사용, inspector_bench 등)
+    // includeChildPatterns: 중첩된 자식 패턴도 평탄한 목록에 포함
+    bool loadPatternsFromFile(const QString& fileName, QVector<PatternInfo>& patterns,
+                              bool includeChildPatterns = true);
     QStringList getAvailableRecipes();
     bool deleteRecipe(const QString& recipeName);
     bool renameRecipe(const QString& oldName, const QString& newName);
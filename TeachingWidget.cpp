@@ -13,6 +13,8 @@
 #include "CustomMessageBox.h"
 #include "CustomFileDialog.h"
 #include "TestDialog.h"
+#include "InspectionStats.h"
+#include "InspectionStatsDialog.h"
 #include <QTimer>
 #include <QProgressDialog>
 #include <QProcess>
@@ -41,18 +43,14 @@
 
 cv::Mat TeachingWidget::getCurrentFrame() const
 {
-    // **camOff 모드 처리 - cameraFrames[cameraIndex] 사용**
-    if (camOff && cameraIndex >= 0 && cameraIndex < 4 &&
-        !cameraFrames[cameraIndex].empty())
+    // **camOff 모드와 메인 카메라 모두 cameraFrames[cameraIndex] 사용**
+    if (cameraIndex >= 0 && cameraIndex < 4)
     {
-        return cameraFrames[cameraIndex].clone();
-    }
-
-    // **메인 카메라의 프레임 반환**
-    if (cameraIndex >= 0 && cameraIndex < 4 &&
-        !cameraFrames[cameraIndex].empty())
-    {
-        return cameraFrames[cameraIndex].clone();
+        cv::Mat published = cameraFrames.load(cameraIndex);
+        if (!published.empty())
+        {
+            return published.clone();
+        }
     }
     return cv::Mat(); // 빈 프레임 반환
 }
@@ -64,10 +62,13 @@ cv::Mat TeachingWidget::getCurrentFilteredFrame() const
     // CAM OFF 모드에서는 currentDisplayFrameIndex 사용, CAM ON 모드에서는 cameraIndex 사용
     int frameIndex = camOff ? currentDisplayFrameIndex : cameraIndex;
 
-    if (frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-        !cameraFrames[frameIndex].empty())
+    if (frameIndex >= 0 && frameIndex < static_cast<int>(4))
     {
-        sourceFrame = cameraFrames[frameIndex].clone();
+        cv::Mat published = cameraFrames.load(frameIndex);
+        if (!published.empty())
+        {
+            sourceFrame = published.clone();
+        }
     }
 
     if (!sourceFrame.empty())
@@ -261,6 +262,9 @@ void CameraGrabberThread::run()
                         if (spinCamera && spinCamera->IsValid() && spinCamera->IsInitialized())
                         {
 
+                            FrameBufferPool *livePool = (m_cameraIndex < static_cast<int>(parent->framePools.size()))
+                                                            ? &parent->framePools[m_cameraIndex] : nullptr;
+
                             // **트리거 모드 확인**
                             try
                             {
@@ -276,22 +280,43 @@ void CameraGrabberThread::run()
                                     QString acqModeStr = QString::fromStdString(ptrAcquisitionMode->GetCurrentEntry()->GetSymbolic().c_str());
 
                                     // **트리거 모드: 새 트리거 신호 대기**
-                                    if (triggerModeStr == "On" && acqModeStr == "SingleFrame")
+                                    if (triggerModeStr == "On")
                                     {
                                         isTriggerMode = true; // ★ 트리거 모드 표시
 
+                                        // ★ SingleFrame이면 Continuous로 한 번 전환 (트리거마다 재시작하는 공백 제거)
+                                        if (acqModeStr != "Continuous")
+                                        {
+                                            // UserSet 재로드 등으로 SingleFrame이 되돌아오면 다시 전환
+                                            continuousTriggerActive = !continuousTriggerFailed &&
+                                                                      TeachingWidget::enableContinuousTriggerAcquisition(spinCamera);
+                                            continuousTriggerFailed = !continuousTriggerActive;
+                                        }
+                                        else if (!continuousTriggerActive)
+                                        {
+                                            // UserSet이 이미 Continuous - 버퍼 정책만 맞춤 (정지 상태에서만 변경 가능)
+                                            if (spinCamera->IsStreaming())
+                                            {
+                                                spinCamera->EndAcquisition();
+                                            }
+                                            TeachingWidget::setStreamBufferHandling(spinCamera, "OldestFirst");
+                                            continuousTriggerActive = true;
+                                        }
+                                        // 전환 실패 시 기존 SingleFrame 방식 (매 장 acquisition 재시작)
+                                        bool singleFrameTrigger = !continuousTriggerActive;
+
                                         bool wasStreaming = spinCamera->IsStreaming();
                                         if (!wasStreaming)
                                         {
                                             spinCamera->BeginAcquisition();
                                         }
 
-                                        // 트리거 신호 대기: CameraSettingsDialog와 동일한 방식
+                                        // 트리거 신호 대기: 블로킹 대기 (트리거가 없으면 스레드가 잠들어 CPU 사용 없음)
                                         Spinnaker::ImagePtr spinImage = nullptr;
                                         try
                                         {
-                                            // ★ 1ms 타임아웃 (CameraSettingsDialog와 동일)
-                                            spinImage = spinCamera->GetNextImage(1);
+                                            // ★ 타임아웃은 중지/모드 변경 확인 주기
+                                            spinImage = spinCamera->GetNextImage(TRIGGER_WAIT_TIMEOUT_MS);
                                         }
                                         catch (...)
                                         {
@@ -302,19 +327,30 @@ void CameraGrabberThread::run()
                                         if (spinImage && !spinImage->IsIncomplete())
                                         {
                                             // ✓ 새로운 트리거 신호로 프레임 획득
+                                            const qint64 arrivalUs = InspectionTracer::nowUs();
                                             try
                                             {
-                                                Spinnaker::ImageProcessor processor;
-                                                processor.SetColorProcessing(Spinnaker::SPINNAKER_COLOR_PROCESSING_ALGORITHM_DIRECTIONAL_FILTER);
-                                                Spinnaker::ImagePtr convertedImage = processor.Convert(spinImage, Spinnaker::PixelFormat_BGR8);
+                                                // ★ Bayer 원본은 복사만 하고 디모자이크는 변환 단계(검사 스레드)에서 처리 (SDK/OpenCV 모두)
+                                                // (획득 스레드가 변환 때문에 다음 트리거를 늦게 받지 않도록)
+                                                BayerPattern bayer = TeachingWidget::spinnakerBayerPattern(spinImage);
+                                                bool hasPools = m_cameraIndex < static_cast<int>(parent->framePools.size());
+                                                if (bayer != BayerPattern::None && hasPools)
+                                                {
+                                                    cv::Mat rawView(static_cast<int>(spinImage->GetHeight()), static_cast<int>(spinImage->GetWidth()),
+                                                                    CV_8UC1, spinImage->GetData(), spinImage->GetStride());
+                                                    frame = parent->rawFramePools[m_cameraIndex].acquire(rawView.rows, rawView.cols, CV_8UC1);
+                                                    rawView.copyTo(frame);
+                                                }
+                                                else
+                                                {
+                                                    // ★ 프레임 버퍼 풀에 직접 BGR 변환 (검사/표시/저장이 같은 버퍼 공유)
+                                                    bayer = BayerPattern::None;
+                                                    frame = parent->convertSpinnakerToBgr(spinImage, hasPools ? &parent->framePools[m_cameraIndex] : nullptr);
+                                                }
 
-                                                if (convertedImage && !convertedImage->IsIncomplete())
+                                                if (!frame.empty())
                                                 {
-                                                    unsigned char *buffer = static_cast<unsigned char *>(convertedImage->GetData());
-                                                    size_t width = convertedImage->GetWidth();
-                                                    size_t height = convertedImage->GetHeight();
-                                                    frame = cv::Mat(height, width, CV_8UC3, buffer).clone();
-                                                    grabbed = !frame.empty(); // ✓ 새 트리거 프레임만 검사
+                                                    grabbed = true; // ✓ 새 트리거 프레임만 검사
 
                                                     // **트리거 신호 수신 - 검사 자동 시작**
                                                     if (!frame.empty())
@@ -329,7 +365,13 @@ void CameraGrabberThread::run()
                                                         qDebug().noquote() << QString("Cam%1 Capture - Frame[%2]")
                                                                     .arg(m_cameraIndex)
                                                                     .arg(currentFrameIdx);
-                                                        emit triggerSignalReceived(frame, m_cameraIndex);
+
+                                                        // ★ 지연 추적: 카메라 타임스탬프(노출 종료)와 버퍼 도착/복사 구간 기록
+                                                        InspectionTracer &tracer = InspectionTracer::instance();
+                                                        quint64 traceId = tracer.beginFrame(m_cameraIndex, currentFrameIdx, arrivalUs,
+                                                                                            tracer.isEnabled() ? spinImage->GetTimeStamp() : 0);
+                                                        tracer.addSpan(traceId, "acquire", QStringLiteral("버퍼 복사"), arrivalUs, InspectionTracer::nowUs());
+                                                        emit triggerSignalReceived(frame, m_cameraIndex, bayer, traceId);
                                                     }
                                                 }
                                             }
@@ -340,19 +382,23 @@ void CameraGrabberThread::run()
 
                                             spinImage->Release();
 
-                                            // ★ CameraSettingsDialog와 동일: SingleFrame 모드에서 다음 트리거 대기를 위해 acquisition 재시작
-                                            try
+                                            // ★ SingleFrame 폴백에서만: 다음 트리거 대기를 위해 acquisition 재시작
+                                            // (Continuous는 스트리밍 유지 - 재시작 공백 없음)
+                                            if (singleFrameTrigger)
                                             {
-                                                if (spinCamera->IsStreaming())
+                                                try
                                                 {
-                                                    spinCamera->EndAcquisition();
-                                                    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                                                    if (spinCamera->IsStreaming())
+                                                    {
+                                                        spinCamera->EndAcquisition();
+                                                        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                                                    }
+                                                    spinCamera->BeginAcquisition();
+                                                }
+                                                catch (...)
+                                                {
+                                                    // 무시
                                                 }
-                                                spinCamera->BeginAcquisition();
-                                            }
-                                            catch (...)
-                                            {
-                                                // 무시
                                             }
                                         }
                                         else
@@ -383,14 +429,26 @@ void CameraGrabberThread::run()
                                     {
                                         // **LIVE 모드: 계속 프레임 요청**
                                         isTriggerMode = false;
-                                        frame = parent->grabFrameFromSpinnakerCamera(spinCamera);
+                                        if (continuousTriggerActive)
+                                        {
+                                            // 트리거 해제 - 라이브는 최신 프레임만 (정지 상태에서 버퍼 정책 복원)
+                                            if (spinCamera->IsStreaming())
+                                            {
+                                                spinCamera->EndAcquisition();
+                                            }
+                                            TeachingWidget::setStreamBufferHandling(spinCamera, "NewestOnly");
+                                            spinCamera->BeginAcquisition();
+                                            continuousTriggerActive = false;
+                                        }
+                                        continuousTriggerFailed = false;
+                                        frame = parent->grabFrameFromSpinnakerCamera(spinCamera, livePool);
                                         grabbed = !frame.empty();
                                     }
                                 }
                                 else
                                 {
                                     // 모드 확인 실패 → LIVE 모드로 간주
-                                    frame = parent->grabFrameFromSpinnakerCamera(spinCamera);
+                                    frame = parent->grabFrameFromSpinnakerCamera(spinCamera, livePool);
                                     grabbed = !frame.empty();
                                 }
                             }
@@ -421,7 +479,7 @@ void CameraGrabberThread::run()
             // 미리보기 업데이트만 수행
             if (m_cameraIndex >= 0 && m_cameraIndex < 2)
             {
-                cv::Mat frameCopy = frame.clone();
+                cv::Mat frameCopy = frame;  // 풀 버퍼 공유 (읽기 전용)
                 int baseFrameIndex = m_cameraIndex * 2;
                 
                 QMetaObject::invokeMethod(parent, [parent, baseFrameIndex, frameCopy]() {
@@ -627,7 +685,7 @@ TeachingWidget::TeachingWidget(int cameraIndex, const QString &cameraStatus, QWi
             // 4분할 뷰 강제 업데이트
             if (cameraView && cameraView->getQuadViewMode())
             {
-                cameraView->setQuadFrames(cameraFrames);
+                cameraView->setQuadFrames(cameraFrames.snapshot());
                 cameraView->viewport()->update();
                 cameraView->repaint();
             }
@@ -869,9 +927,10 @@ void TeachingWidget::deleRecipe()
     msgBoxInfo.exec();
 
     // 메인 화면 갱신 - 패턴 없이 현재 프레임 다시 표시
-    if (!cameraFrames[currentFrameIndex].empty())
+    cv::Mat currentPublished = cameraFrames.load(currentFrameIndex);
+    if (!currentPublished.empty())
     {
-        QImage qImage = InsProcessor::matToQImage(cameraFrames[currentFrameIndex]);
+        QImage qImage = InsProcessor::matToQImage(currentPublished);
         QPixmap pixmap = QPixmap::fromImage(qImage);
         cameraView->setBackgroundPixmap(pixmap);
     }
@@ -879,9 +938,10 @@ void TeachingWidget::deleRecipe()
     // 4분할 미리보기 갱신 - 패턴 오버레이 제거
     for (int i = 0; i < 4; i++)
     {
-        if (!cameraFrames[i].empty() && previewOverlayLabels[i])
+        cv::Mat published = cameraFrames.load(i);
+        if (!published.empty() && previewOverlayLabels[i])
         {
-            QImage qImage = InsProcessor::matToQImage(cameraFrames[i]);
+            QImage qImage = InsProcessor::matToQImage(published);
             QPixmap pixmap = QPixmap::fromImage(qImage);
             previewOverlayLabels[i]->setPixmap(pixmap.scaled(
                 previewOverlayLabels[i]->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
@@ -1006,8 +1066,9 @@ void TeachingWidget::initBasicSettings()
     camOff = true;
     cameraIndex = 0;
 
-    // cameraFrames 고정 배열 초기화 (std::array<cv::Mat, 4>로 선언됨)
-    frameUpdatedFlags.fill(false);
+    // 프레임 업데이트 플래그 초기화 (cameraFrames 슬롯은 비어 있는 상태로 생성됨)
+    for (auto &flag : frameUpdatedFlags)
+        flag = false;
     lastUsedFrameIndex = -1;  // 마지막 사용 프레임 인덱스 초기화
     
     // ★ 카메라별 다음 프레임 인덱스 초기화
@@ -1016,6 +1077,36 @@ void TeachingWidget::initBasicSettings()
     totalTriggersReceived = 0;
     totalInspectionsExecuted = 0;
 
+    // ★ 검사 통계: 로컬 엔드포인트와 기존 카운터 연결 (JSON "counters")
+    inspectionStatsServer = new InspectionStatsServer(this);
+    InspectionStats::instance().setCounterProvider([this]() {
+        QJsonObject counters;
+        counters["triggersReceived"] = totalTriggersReceived.load();
+        counters["hardwareTriggersReceived"] = totalHardwareTriggersReceived.load();
+        counters["inspectionsExecuted"] = totalInspectionsExecuted.load();
+        QJsonArray frameCounts;
+        for (const auto &count : serialFrameCount)
+            frameCounts.append(count.load());
+        counters["serialFrameCount"] = frameCounts;
+        QJsonArray pipelines;
+        for (InspectionWorkerThread *worker : inspectionWorkers)
+        {
+            if (!worker)
+                continue;
+            InspectionPipelineStats stats = worker->stats();
+            QJsonObject pipeline;
+            pipeline["camera"] = worker->cameraIndex();
+            pipeline["submitted"] = static_cast<qint64>(stats.submitted);
+            pipeline["inspected"] = static_cast<qint64>(stats.inspected);
+            pipeline["droppedQueueFull"] = static_cast<qint64>(stats.droppedQueueFull);
+            pipeline["queueDepth"] = stats.queueDepth;
+            pipeline["maxQueueDepth"] = stats.maxQueueDepth;
+            pipelines.append(pipeline);
+        }
+        counters["pipelines"] = pipelines;
+        return counters;
+    });
+
     // 8개 카메라 미리보기를 고려하여 크기 확장
     setMinimumSize(1280, 800);
     patternColors << QColor("#FF5252") << QColor("#448AFF") << QColor("#4CAF50")
@@ -1092,6 +1183,8 @@ QVBoxLayout *TeachingWidget::createMainLayout()
     testMenu->setEnabled(true);
     testDialogAction = testMenu->addAction("테스트");
     testDialogAction->setEnabled(true);
+    inspectionStatsAction = testMenu->addAction("검사 통계");
+    inspectionStatsAction->setEnabled(true);
 
     // 설정 메뉴
     settingsMenu = menuBar->addMenu(TR("SETTINGS_MENU"));
@@ -1136,6 +1229,7 @@ QVBoxLayout *TeachingWidget::createMainLayout()
     connect(aboutAction, &QAction::triggered, this, &TeachingWidget::showAboutDialog);
     connect(modelManagementAction, &QAction::triggered, this, &TeachingWidget::showModelManagement);
     connect(testDialogAction, &QAction::triggered, this, &TeachingWidget::showTestDialog);
+    connect(inspectionStatsAction, &QAction::triggered, this, &TeachingWidget::showInspectionStats);
 
     // 메뉴바 추가
     layout->setMenuBar(menuBar);
@@ -1456,7 +1550,7 @@ void TeachingWidget::connectButtonEvents(QPushButton *modeToggleButton, QPushBut
                 if (camOff) {
                     // 시뮬레이션 모드: 현재 표시된 프레임 확인
                     if (!cameraView || currentDisplayFrameIndex < 0 || currentDisplayFrameIndex >= static_cast<int>(4) || 
-                        cameraFrames[currentDisplayFrameIndex].empty()) {
+                        cameraFrames.load(currentDisplayFrameIndex).empty()) {
                         btn->blockSignals(true);
                         btn->setChecked(false);
                         btn->blockSignals(false);
@@ -1466,7 +1560,7 @@ void TeachingWidget::connectButtonEvents(QPushButton *modeToggleButton, QPushBut
                 } else {
                     // 실제 카메라 모드: 카메라 프레임 확인
                     if (cameraIndex < 0 || cameraIndex >= static_cast<int>(4) || 
-                        cameraFrames[cameraIndex].empty()) {
+                        cameraFrames.load(cameraIndex).empty()) {
                         btn->blockSignals(true);
                         btn->setChecked(false);
                         btn->blockSignals(false);
@@ -1535,26 +1629,23 @@ void TeachingWidget::connectButtonEvents(QPushButton *modeToggleButton, QPushBut
                     if (camOff) {                
                         // 시뮬레이션 모드: 현재 표시된 프레임 사용
                         {
-                            QMutexLocker locker(&cameraFramesMutex);
-                            if (currentDisplayFrameIndex < 0 || currentDisplayFrameIndex >= static_cast<int>(4) || 
-                                cameraFrames[currentDisplayFrameIndex].empty()) {
+                            cv::Mat displayed = cameraFrames.load(currentDisplayFrameIndex);
+                            if (displayed.empty()) {
                                 btn->blockSignals(true);
                                 btn->setChecked(false);
                                 btn->blockSignals(false);
                                 return;
                             }
-                            inspectionFrame = cameraFrames[currentDisplayFrameIndex].clone();
+                            inspectionFrame = displayed.clone();
                         }
                         // frameIndex를 그대로 사용 (0,1,2,3)
                         inspectionCameraIndex = currentDisplayFrameIndex;
                     } else {
                         // **실제 카메라 모드: 현재 표시된 프레임 사용**
                         // 1. 먼저 cameraFrames에 저장된 프레임이 있는지 확인 (트리거 신호로 저장된 프레임)
-                        
-                        QMutexLocker locker(&cameraFramesMutex);
-                        if (currentDisplayFrameIndex >= 0 && currentDisplayFrameIndex < static_cast<int>(4) && 
-                            !cameraFrames[currentDisplayFrameIndex].empty()) {
-                            inspectionFrame = cameraFrames[currentDisplayFrameIndex].clone();
+                        cv::Mat displayed = cameraFrames.load(currentDisplayFrameIndex);
+                        if (!displayed.empty()) {
+                            inspectionFrame = displayed.clone();
                             // frameIndex를 그대로 사용 (0,1,2,3)
                             inspectionCameraIndex = currentDisplayFrameIndex;
                         } 
@@ -1818,9 +1909,10 @@ void TeachingWidget::updateFilterParam(const QUuid &patternId, int filterIndex,
             const FilterInfo &filter = parentPattern->filters[filterIndex];
             
             int frameIndex = camOff ? currentDisplayFrameIndex : cameraIndex;
-            if (frameIndex >= 0 && frameIndex < 4 && !cameraFrames[frameIndex].empty())
+            cv::Mat published = (frameIndex >= 0 && frameIndex < 4) ? cameraFrames.load(frameIndex) : cv::Mat();
+            if (!published.empty())
             {
-                cv::Mat sourceFrame = cameraFrames[frameIndex].clone();
+                cv::Mat sourceFrame = published.clone();
                 
                 // 회전이 있는 경우: 회전된 사각형 영역에만 필터 적용
                 if (std::abs(parentPattern->angle) > 0.1)
@@ -2474,7 +2566,7 @@ void TeachingWidget::connectEvents()
                 // 현재 표시된 프레임으로 템플릿 이미지 갱신
                 qDebug() << "[FID템플릿업데이트] patternId:" << patternId << "currentDisplayFrameIndex:" << currentDisplayFrameIndex;
                 if (currentDisplayFrameIndex >= 0 && currentDisplayFrameIndex < static_cast<int>(4) &&
-                    !cameraFrames[currentDisplayFrameIndex].empty())
+                    !cameraFrames.load(currentDisplayFrameIndex).empty())
                 {
                     PatternInfo *pattern = cameraView->getPatternById(patternId);
                     if (pattern && pattern->type == PatternType::FID)
@@ -2506,7 +2598,7 @@ void TeachingWidget::connectEvents()
                     // 패턴의 frameIndex에 해당하는 이미지 사용
                     int frameIdx = pattern->frameIndex;
                     if (frameIdx >= 0 && frameIdx < static_cast<int>(4) &&
-                        !cameraFrames[frameIdx].empty())
+                        !cameraFrames.load(frameIdx).empty())
                     {
                         // 필터 적용된 이미지로 템플릿 갱신
                         updateInsTemplateImage(pattern, pattern->rect);
@@ -3443,7 +3535,7 @@ void TeachingWidget::connectItemChangedEvent()
                     // 부모가 FID 타입이면 템플릿 이미지 업데이트
                     if (parentPattern && parentPattern->type == PatternType::FID && 
                         cameraIndex >= 0 && cameraIndex < static_cast<int>(4) && 
-                        !cameraFrames[cameraIndex].empty()) {
+                        !cameraFrames.load(cameraIndex).empty()) {
                         updateFidTemplateImage(parentPattern, parentPattern->rect);
                         
                         // 추가: 현재 선택된 아이템이 이 부모 패턴이라면, 프로퍼티 패널의 템플릿 이미지도 업데이트
@@ -3455,7 +3547,7 @@ void TeachingWidget::connectItemChangedEvent()
                     // **여기가 수정된 부분**
                     else if (parentPattern && parentPattern->type == PatternType::INS && 
                             cameraIndex >= 0 && cameraIndex < static_cast<int>(4) && 
-                            !cameraFrames[cameraIndex].empty()) {
+                            !cameraFrames.load(cameraIndex).empty()) {
                         updateInsTemplateImage(parentPattern, parentPattern->rect);
                         
                         // 추가: 현재 선택된 아이템이 이 부모 패턴이라면, 프로퍼티 패널의 템플릿 이미지도 업데이트
@@ -3488,13 +3580,13 @@ void TeachingWidget::connectItemChangedEvent()
                     // FID 패턴이면 템플릿 이미지 업데이트
                     if (pattern->type == PatternType::FID && 
                         cameraIndex >= 0 && cameraIndex < static_cast<int>(4) && 
-                        !cameraFrames[cameraIndex].empty()) {
+                        !cameraFrames.load(cameraIndex).empty()) {
                         updateFidTemplateImage(pattern, pattern->rect);
                     }
                     // INS 패턴이면 템플릿 이미지 업데이트 - **여기도 수정됨**
                     if (pattern->type == PatternType::INS && 
                         cameraIndex >= 0 && cameraIndex < static_cast<int>(4) && 
-                        !cameraFrames[cameraIndex].empty()) {
+                        !cameraFrames.load(cameraIndex).empty()) {
                         updateInsTemplateImage(pattern, pattern->rect);
                     }
                     
@@ -3713,9 +3805,10 @@ void TeachingWidget::onPatternSelected(QTreeWidgetItem *current, QTreeWidgetItem
                 }
                 
                 int frameIndex = camOff ? currentDisplayFrameIndex : cameraIndex;
-                if (frameIndex >= 0 && frameIndex < 4 && !cameraFrames[frameIndex].empty())
+                cv::Mat published = (frameIndex >= 0 && frameIndex < 4) ? cameraFrames.load(frameIndex) : cv::Mat();
+                if (!published.empty())
                 {
-                    cv::Mat sourceFrame = cameraFrames[frameIndex].clone();
+                    cv::Mat sourceFrame = published.clone();
                     
                     // 회전이 있는 경우: 회전된 사각형 영역에만 필터 적용
                     if (std::abs(parentPattern->angle) > 0.1)
@@ -3825,9 +3918,10 @@ void TeachingWidget::onPatternSelected(QTreeWidgetItem *current, QTreeWidgetItem
 
     // 패턴 선택 시 원본 화면 보여주기
     int frameIndex = camOff ? currentDisplayFrameIndex : cameraIndex;
-    if (frameIndex >= 0 && frameIndex < 4 && !cameraFrames[frameIndex].empty())
+    cv::Mat published = (frameIndex >= 0 && frameIndex < 4) ? cameraFrames.load(frameIndex) : cv::Mat();
+    if (!published.empty())
     {
-        cv::Mat sourceFrame = cameraFrames[frameIndex].clone();
+        cv::Mat sourceFrame = published.clone();
         
         // RGB 변환 및 UI 업데이트
         cv::Mat rgbFrame;
@@ -4106,6 +4200,7 @@ void TeachingWidget::createPropertyPanels()
     fidMatchMethodCombo = new QComboBox(fidMatchGroup);
     fidMatchMethodCombo->addItem("Coefficient", 0);
     fidMatchMethodCombo->addItem("Correlation", 1);
+    fidMatchMethodCombo->addItem("Shape", 2);
     fidMatchLayout->addRow(fidMatchMethodLabel, fidMatchMethodCombo);
 
     // 매칭 임계값
@@ -4415,6 +4510,7 @@ void TeachingWidget::createPropertyPanels()
     insPatternMatchMethodCombo = new QComboBox(insPatternMatchGroup);
     insPatternMatchMethodCombo->addItem("Coefficient", 0);
     insPatternMatchMethodCombo->addItem("Correlation", 1);
+    insPatternMatchMethodCombo->addItem("Shape", 2);
     patternMatchLayout->addRow(insPatternMatchMethodLabel, insPatternMatchMethodCombo);
 
     // 패턴 매칭 임계값
@@ -5672,15 +5768,15 @@ void TeachingWidget::updateInsTemplateImage(PatternInfo *pattern, const QRectF &
 
     // 시뮬레이션 모드와 일반 모드 모두 cameraFrames 사용
     {
-        QMutexLocker locker(&cameraFramesMutex);
-        if (cameraFrames[frameIndex].empty())
+        cv::Mat published = cameraFrames.load(frameIndex);
+        if (published.empty())
         {
             return;
         }
 
         try
         {
-            sourceFrame = cameraFrames[frameIndex].clone();
+            sourceFrame = published.clone();
         }
         catch (...)
         {
@@ -5744,20 +5840,9 @@ void TeachingWidget::updateInsTemplateImage(PatternInfo *pattern, const QRectF &
                  pattern->inspectionMethod == InspectionMethod::SSIM) &&
                 !pattern->filters.isEmpty())
             {
-                cv::Mat processedRegion = templateRegion.clone();
-                ImageProcessor processor;
-                for (const FilterInfo &filter : pattern->filters)
-                {
-                    if (filter.enabled)
-                    {
-                        cv::Mat tempFiltered;
-                        processor.applyFilter(processedRegion, tempFiltered, filter);
-                        if (!tempFiltered.empty())
-                        {
-                            processedRegion = tempFiltered.clone();
-                        }
-                    }
-                }
+                // 검사 때와 같은 컴파일된 체인 (LUT 합성 결과까지 동일)
+                cv::Mat processedRegion;
+                FilterChain(pattern->filters).apply(templateRegion, processedRegion);
                 templateRegion = processedRegion;
             }
 
@@ -5797,20 +5882,8 @@ void TeachingWidget::updateInsTemplateImage(PatternInfo *pattern, const QRectF &
                                 .arg(insRegion.rows)
                                 .arg(pattern->filters.size());
 
-                cv::Mat processedRegion = insRegion.clone();
-                ImageProcessor processor;
-                for (const FilterInfo &filter : pattern->filters)
-                {
-                    if (filter.enabled)
-                    {
-                        cv::Mat tempFiltered;
-                        processor.applyFilter(processedRegion, tempFiltered, filter);
-                        if (!tempFiltered.empty())
-                        {
-                            processedRegion = tempFiltered.clone();
-                        }
-                    }
-                }
+                cv::Mat processedRegion;
+                FilterChain(pattern->filters).apply(insRegion, processedRegion);
                 insRegion = processedRegion;
             }
 
@@ -5903,10 +5976,10 @@ void TeachingWidget::updateFidTemplateImage(PatternInfo *pattern, const QRectF &
     cv::Mat sourceFrame;
 
     // cameraFrames 유효성 검사 및 프레임 가져오기
-    if (frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-        !cameraFrames[frameIndex].empty())
+    cv::Mat published = (frameIndex >= 0 && frameIndex < static_cast<int>(4)) ? cameraFrames.load(frameIndex) : cv::Mat();
+    if (!published.empty())
     {
-        sourceFrame = cameraFrames[frameIndex].clone();
+        sourceFrame = published.clone();
     }
     else
     {
@@ -6033,10 +6106,10 @@ void TeachingWidget::updateInsMatchTemplate(PatternInfo *pattern)
     cv::Mat sourceFrame;
 
     // cameraFrames 유효성 검사 및 프레임 가져오기
-    if (frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-        !cameraFrames[frameIndex].empty())
+    cv::Mat published = (frameIndex >= 0 && frameIndex < static_cast<int>(4)) ? cameraFrames.load(frameIndex) : cv::Mat();
+    if (!published.empty())
     {
-        sourceFrame = cameraFrames[frameIndex].clone();
+        sourceFrame = published.clone();
     }
     else
     {
@@ -9051,11 +9124,8 @@ void TeachingWidget::processGrabbedFrame(const cv::Mat &frame, int camIdx)
         if (frameIndex >= 0 && frameIndex < MAX_CAMERAS)
         {
             // 프레임 쓰기 (mutex로 보호)
-            {
-                QMutexLocker locker(&cameraFramesMutex);
-                cameraFrames[frameIndex] = frame.clone();
-                frameUpdatedFlags[frameIndex] = true;
-            }
+            cameraFrames.store(frameIndex, frame);  // 풀 버퍼 공유 (읽기 전용)
+            frameUpdatedFlags[frameIndex] = true;
             
             // 해당 미리보기 즉시 업데이트 (메인 스레드에서 실행)
             QMetaObject::invokeMethod(this, [this, frameIndex]() {
@@ -9092,14 +9162,11 @@ void TeachingWidget::processGrabbedFrame(const cv::Mat &frame, int camIdx, int f
             
             // 프레임 쓰기 (mutex로 보호)
             try {
-                qDebug() << QString("[processGrabbedFrame] Frame[%1] clone 시작").arg(frameIndex);
+                qDebug() << QString("[processGrabbedFrame] Frame[%1] 저장 시작").arg(frameIndex);
                 
-                // 새 프레임 저장 (cv::Mat의 assignment operator가 자동으로 메모리 관리)
-                {
-                    QMutexLocker locker(&cameraFramesMutex);
-                    cameraFrames[frameIndex] = frame.clone();
-                    frameUpdatedFlags[frameIndex] = true;
-                }
+                // 새 프레임 저장 (풀 버퍼 참조 공유 - 이전 버퍼는 참조가 풀리면 풀로 돌아감)
+                cameraFrames.store(frameIndex, frame);
+                frameUpdatedFlags[frameIndex] = true;
                 
                 qDebug() << QString("[processGrabbedFrame] Frame[%1] clone 완료").arg(frameIndex);
             } catch (const cv::Exception& e) {
@@ -9620,15 +9687,11 @@ void TeachingWidget::updatePreviewFrames()
                     // pixmap이 null이면 원본 프레임 사용
                     if (i < static_cast<int>(4))
                     {
-                        cv::Mat previewFrame;
-                        {
-                            QMutexLocker locker(&cameraFramesMutex);
-                            if (!cameraFrames[i].empty()) {
-                                previewFrame = cameraFrames[i].clone();
-                            }
-                        }
-                        if (!previewFrame.empty()) {
-                            cv::cvtColor(previewFrame, previewFrame, cv::COLOR_BGR2RGB);
+                        cv::Mat published = cameraFrames.load(i);
+                        if (!published.empty()) {
+                            // 발행된 프레임은 다른 단계와 공유하므로 새 버퍼로 변환 (제자리 변환 금지)
+                            cv::Mat previewFrame;
+                            cv::cvtColor(published, previewFrame, cv::COLOR_BGR2RGB);
                             QImage image(previewFrame.data, previewFrame.cols, previewFrame.rows,
                                          previewFrame.step, QImage::Format_RGB888);
                             pixmap = QPixmap::fromImage(image.copy());
@@ -9639,15 +9702,13 @@ void TeachingWidget::updatePreviewFrames()
             // 검사 결과 없으면 원본 프레임 사용
             else if (i < static_cast<int>(4))
             {
-                cv::Mat previewFrame;
-                {
-                    QMutexLocker locker(&cameraFramesMutex);
-                    if (cameraFrames[i].empty())
-                        continue;
-                    previewFrame = cameraFrames[i].clone();
-                }
+                cv::Mat published = cameraFrames.load(i);
+                if (published.empty())
+                    continue;
                 
-                cv::cvtColor(previewFrame, previewFrame, cv::COLOR_BGR2RGB);
+                // 발행된 프레임은 다른 단계와 공유하므로 새 버퍼로 변환 (제자리 변환 금지)
+                cv::Mat previewFrame;
+                cv::cvtColor(published, previewFrame, cv::COLOR_BGR2RGB);
                 
                 // 메모리 안정성을 위해 연속 메모리 보장
                 if (!previewFrame.isContinuous()) {
@@ -9696,8 +9757,7 @@ void TeachingWidget::updatePreviewFrames()
     // 4분할 뷰 모드일 때 cameraView에 프레임 전달
     if (cameraView && cameraView->getQuadViewMode())
     {
-        QMutexLocker locker(&cameraFramesMutex);
-        cameraView->setQuadFrames(cameraFrames);
+        cameraView->setQuadFrames(cameraFrames.snapshot());
     }
 }
 
@@ -9855,12 +9915,12 @@ void TeachingWidget::updateSinglePreview(int frameIndex)
     qDebug() << QString("[updateSinglePreview] Frame[%1] 프레임 복사 시작").arg(frameIndex);
     
     // 프레임 복사
-    cv::Mat previewFrame;
-    if (cameraFrames[frameIndex].empty()) {
+    cv::Mat previewFrame = cameraFrames.load(frameIndex);
+    if (previewFrame.empty()) {
         qDebug() << QString("[updateSinglePreview] Frame[%1] cameraFrame is empty").arg(frameIndex);
         return;
     }
-    previewFrame = cameraFrames[frameIndex].clone();
+    previewFrame = previewFrame.clone();
     
     qDebug() << QString("[updateSinglePreview] Frame[%1] 프레임 복사 완료 - updateSinglePreviewWithFrame 호출")
                 .arg(frameIndex);
@@ -10002,10 +10062,8 @@ void TeachingWidget::onFrameIndexReceived(int frameIndex)
 }
 
 
-void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCameraIndex)
+void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCameraIndex, BayerPattern bayer, quint64 traceId)
 {
-    auto triggerStartTime = std::chrono::high_resolution_clock::now();
-    
     // Widget이 숨겨지거나 삭제 중이면 무시
     if (this->isHidden() || !this->isVisible()) {
         return;
@@ -10022,34 +10080,151 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
         return;  // 캡처, 검사 모두 무시
     }
 
-    // ★ 서버가 지정한 프레임 인덱스 읽기 (덮어쓰기 방식)
+    // ★ 서버가 지정한 프레임 인덱스 읽기 (덮어쓰기 방식) - 획득 시점에 확정해야 큐에서 기다리는 동안 바뀌지 않음
     int frameIdx = nextFrameIndex[triggerCameraIndex].load();
     
     if (frameIdx < 0 || frameIdx >= 4) {
         return;
     }
     
-    totalInspectionsExecuted++;  // 검사 실행 카운트
-    
-    // ★ 시리얼/서버 명령으로 트리거된 검사 플래그 설정
-    frameTriggeredBySerial[frameIdx] = true;
-    
     // ★ 트리거 사용 후 즉시 초기화 (같은 메시지로 중복 검사 방지)
     nextFrameIndex[triggerCameraIndex] = 0;
+
+    // 획득 스레드가 새로 만든 버퍼이므로 복사 없이 검사 단계로 넘김 (Bayer 원본은 변환 단계에서 BGR로)
+    TriggerFrame trigger;
+    if (bayer != BayerPattern::None)
+    {
+        trigger.raw = frame;
+        trigger.bayer = bayer;
+    }
+    else
+    {
+        trigger.frame = frame;
+    }
+    trigger.cameraIndex = triggerCameraIndex;
+    trigger.frameIndex = frameIdx;
+    trigger.acquiredAt = std::chrono::steady_clock::now();
+    trigger.traceId = traceId;
+    InspectionTracer::instance().setFrameIndex(traceId, frameIdx);
+
+    // ★ 카메라별 검사 큐에 넣음 (검사 중에도 다음 부품 획득 가능), 검사 스레드가 없으면 기존처럼 직접 검사
+    InspectionWorkerThread *worker = inspectionWorkers.value(triggerCameraIndex, nullptr);
+    if (worker && worker->isRunning())
+    {
+        if (!worker->submit(std::move(trigger)))
+        {
+            InspectionStats::instance().recordDrop(triggerCameraIndex, QStringLiteral("queue_full"));
+            InspectionTracer::instance().addInstant(traceId, "pipeline", QStringLiteral("큐 가득 참 - 버림"));
+            InspectionTracer::instance().endFrame(traceId);
+        }
+        return;
+    }
+    FrameBufferPool *pool = (triggerCameraIndex < static_cast<int>(framePools.size())) ? &framePools[triggerCameraIndex] : nullptr;
+    SdkDemosaicer *sdk = (triggerCameraIndex < static_cast<int>(sdkDemosaicers.size())) ? &sdkDemosaicers[triggerCameraIndex] : nullptr;
+    bool converted = false;
+    {
+        InspectionTraceScope convertTrace(traceId, "pipeline", QStringLiteral("변환"));
+        converted = frameConverter.convert(trigger, pool, sdk);
+    }
+    if (!converted)
+    {
+        return;
+    }
+    processTriggerFrame(trigger);
+}
+
+void TeachingWidget::applyPipelineSettings()
+{
+    ConfigManager *config = ConfigManager::instance();
+    frameConverter.setQuality(static_cast<DemosaicQuality>(qBound(0, config->getDemosaicQuality(), 3)));
+    frameConverter.setGrayOutput(config->getDemosaicGrayOutput());
+    InspectionTracer::instance().setEnabled(config->getLatencyTracing());
+}
+
+void TeachingWidget::startInspectionWorkers()
+{
+    stopInspectionWorkers();
+    applyPipelineSettings();
+    connect(ConfigManager::instance(), &ConfigManager::configChanged,
+            this, &TeachingWidget::applyPipelineSettings, Qt::UniqueConnection);
+
+    inspectionWorkers.resize(cameraInfos.size());
+    for (int i = 0; i < cameraInfos.size(); i++)
+    {
+        inspectionWorkers[i] = nullptr;
+        if (!cameraInfos[i].isConnected)
+            continue;
+
+        InspectionWorkerThread *worker = new InspectionWorkerThread(
+            i, INSPECTION_QUEUE_CAPACITY, [this](const TriggerFrame &trigger) { processTriggerFrame(trigger); }, this);
+        worker->setConverter(&frameConverter, (i < static_cast<int>(framePools.size())) ? &framePools[i] : nullptr);
+        worker->start(QThread::HighPriority);
+        inspectionWorkers[i] = worker;
+    }
+}
+
+void TeachingWidget::stopInspectionWorkers()
+{
+    // 획득 스레드(생산자)를 먼저 중지한 뒤 호출해야 함
+    for (InspectionWorkerThread *worker : inspectionWorkers)
+    {
+        if (!worker)
+            continue;
+        worker->stopWorker();
+        worker->wait();
+
+        InspectionPipelineStats stats = worker->stats();
+        qDebug().noquote() << QString("[Pipeline] Cam%1 검사 %2/%3, 큐 가득 참 버림 %4, 중지 시 버림 %5, 최대 대기 %6")
+                                  .arg(worker->cameraIndex())
+                                  .arg(stats.inspected)
+                                  .arg(stats.submitted)
+                                  .arg(stats.droppedQueueFull)
+                                  .arg(stats.droppedOnStop)
+                                  .arg(stats.maxQueueDepth);
+        if (stats.droppedOnStop > 0)
+            InspectionStats::instance().recordDrop(worker->cameraIndex(), QStringLiteral("stopped"), stats.droppedOnStop);
+        delete worker;
+    }
+
+    // ★ 지연 추적 중이면 이번 검사 구간의 프레임 기록을 Chrome trace JSON으로 저장
+    InspectionTracer &tracer = InspectionTracer::instance();
+    if (!inspectionWorkers.isEmpty() && tracer.isEnabled())
+    {
+        QString tracePath = QString("%1/traces/trace_%2.json")
+                                .arg(QCoreApplication::applicationDirPath())
+                                .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"));
+        tracer.exportChromeTrace(tracePath);
+        tracer.clear();
+    }
+    inspectionWorkers.clear();
+}
+
+void TeachingWidget::processTriggerFrame(const TriggerFrame &trigger)
+{
+    auto triggerStartTime = std::chrono::high_resolution_clock::now();
+    const int frameIdx = trigger.frameIndex;
+    const int triggerCameraIndex = trigger.cameraIndex;
+
+    totalInspectionsExecuted++;  // 검사 실행 카운트
     
     // ★★★ 같은 프레임이 이미 처리 중이면 무시 (동시 접근 차단)
+    // (카메라별 검사 스레드가 순서대로 처리하므로 다른 카메라가 같은 프레임 인덱스를 받은 경우만 해당)
     bool expected = false;
     if (!frameProcessing[frameIdx].compare_exchange_strong(expected, true)) {
         qWarning() << QString("[Trigger] Frame[%1] 이미 처리 중 - 트리거 무시").arg(frameIdx);
-        nextFrameIndex[triggerCameraIndex] = frameIdx;  // 롤백 (다음 트리거에서 사용 가능)
+        InspectionStats::instance().recordDrop(triggerCameraIndex, QStringLiteral("busy"));
         return;
     }
     
+    // ★ 시리얼/서버 명령으로 트리거된 검사 플래그 설정
+    // (처리 권한을 얻은 뒤에만 설정 - 무시되는 트리거가 처리 중인 검사의 플래그를 건드리지 않도록)
+    frameTriggeredBySerial[frameIdx] = true;
+    
     // 사용한 프레임 인덱스 기록
     lastUsedFrameIndex = frameIdx;
     
-    // ★★★ 완전 독립 메모리 사용 - cameraFrames 접근 안 함
-    cv::Mat frameForInspection = frame.clone();
+    // ★★★ 완전 독립 메모리 사용 - 획득 단계에서 새로 만든 버퍼를 검사 단계가 단독 소유
+    const cv::Mat &frameForInspection = trigger.frame;
     
     // **통합 로그 출력** - 제거됨
 
@@ -10066,8 +10241,7 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
 
     // ★★★ 하드웨어 트리거 들어오면 항상 cameraFrames에 저장 (레시피 생성 시 사용)
     {
-        QMutexLocker locker(&cameraFramesMutex);
-        cameraFrames[frameIdx] = frameForInspection.clone();
+        cameraFrames.store(frameIdx, frameForInspection);  // 풀 버퍼 공유 (읽기 전용)
         frameUpdatedFlags[frameIdx] = true;
         qDebug() << QString("[onTriggerSignalReceived] Frame[%1] cameraFrames에 저장 완료 (%2x%3)")
                     .arg(frameIdx).arg(frameForInspection.cols).arg(frameForInspection.rows);
@@ -10096,8 +10270,7 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
     if (cameraView && !cameraView->isHidden() && cameraView->getQuadViewMode())
     {
         try {
-            QMutexLocker locker(&cameraFramesMutex);
-            cameraView->setQuadFrames(cameraFrames);  // 배열 전체 전달하지만 frameIdx만 변경됨
+            cameraView->setQuadFrames(cameraFrames.snapshot());  // 배열 전체 전달하지만 frameIdx만 변경됨
             cameraView->viewport()->update();
         } catch (const std::exception& e) {
             qDebug() << "[onTriggerSignalReceived] Quad view update failed:" << e.what();
@@ -10143,8 +10316,11 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
     }
     
     bool passed = false;
+    InspectionResult inspectionResult;
+    inspectionResult.isPassed = true;  // 활성 패턴이 없으면 runInspect가 검사 없이 통과 처리
     try {
-        passed = runInspect(frameForInspection, triggerCameraIndex, false, frameIdx);
+        InspectionTraceScope inspectTrace(trigger.traceId, "inspect", QStringLiteral("검사 전체"));
+        passed = runInspect(frameForInspection, triggerCameraIndex, false, frameIdx, &inspectionResult, trigger.gray, trigger.traceId);
     } catch (const std::exception& e) {
         qDebug() << "[onTriggerSignalReceived] runInspect failed:" << e.what();
         frameProcessing[frameIdx] = false;
@@ -10152,33 +10328,33 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
         return;
     }
     
+    // ★ 검사 통계: 획득 → 결과 사이클 시간, 패턴별 검사 시간/NG
+    const qint64 cycleUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - trigger.acquiredAt).count();
+    InspectionStats::instance().recordFrame(triggerCameraIndex, frameIdx, cycleUs, inspectionResult, framePatterns);
+    
     // ★★★ 검사 완료 후 4분할 화면에 결과 저장 (카운트 업데이트)
+    // runInspect의 결과를 그대로 사용 (같은 프레임 재검사 없음)
     if (cameraView && !cameraView->isHidden() && cameraView->getQuadViewMode()) {
         try {
-            // framePatternLists에서 현재 프레임의 패턴 가져오기
-            const QList<PatternInfo>& framePatterns = framePatternLists[frameIdx];
-            QString cameraName = (triggerCameraIndex >= 0 && triggerCameraIndex < cameraInfos.size()) ? cameraInfos[triggerCameraIndex].serialNumber : "";
-            
-            // 검사 결과 재획득
-            InspectionResult quadResult = insProcessor->performInspection(frameForInspection, framePatterns, cameraName);
-            
             QImage qImage(frameForInspection.data, frameForInspection.cols, frameForInspection.rows, 
                           frameForInspection.step, QImage::Format_BGR888);
             QPixmap pixmap = QPixmap::fromImage(qImage);
-            cameraView->saveInspectionResultForMode(frameIdx, quadResult, pixmap);
+            cameraView->saveInspectionResultForMode(frameIdx, inspectionResult, pixmap);
         } catch (const std::exception& e) {
             qDebug() << "[onTriggerSignalReceived] Result save failed:" << e.what();
         }
     }
     
     // ★ 검사 후 패턴 트리 업데이트 및 화면 갱신 (UI 스레드에서 실행)
-    QMetaObject::invokeMethod(this, [this]() {
+    const quint64 traceId = trigger.traceId;
+    QMetaObject::invokeMethod(this, [this, traceId]() {
         if (this && !this->isHidden()) {
             try {
                 updatePatternTree();
                 if (cameraView && !cameraView->isHidden()) {
                     cameraView->viewport()->update();
                 }
+                InspectionTracer::instance().addInstant(traceId, "ui", QStringLiteral("UI 발행"));
             } catch (const std::exception& e) {
                 qDebug() << "[onTriggerSignalReceived] Pattern tree update failed:" << e.what();
             }
@@ -10186,23 +10362,31 @@ void TeachingWidget::onTriggerSignalReceived(const cv::Mat &frame, int triggerCa
     }, Qt::QueuedConnection);
     
     // ★★★ 검사 완료 후 cameraFrames에 저장 (shallow copy - 빠름)
-    cameraFrames[frameIdx] = frameForInspection;  // assignment operator (참조 카운팅)
+    cameraFrames.store(frameIdx, frameForInspection);  // assignment operator (참조 카운팅)
     frameUpdatedFlags[frameIdx] = true;
     
     // 트리거 처리 완료 시간 측정
     auto triggerEndTime = std::chrono::high_resolution_clock::now();
     auto triggerDuration = std::chrono::duration_cast<std::chrono::milliseconds>(triggerEndTime - triggerStartTime).count();
-    qDebug().noquote() << QString("[Inspect] Total: %1ms (Cam:%2 Frame[%3])").arg(triggerDuration).arg(triggerCameraIndex).arg(frameIdx);
+    auto queueWait = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - trigger.acquiredAt).count() - triggerDuration;
+    qDebug().noquote() << QString("[Inspect] Total: %1ms, Queue: %2ms (Cam:%3 Frame[%4])").arg(triggerDuration).arg(queueWait).arg(triggerCameraIndex).arg(frameIdx);
     
     // ★★★ 시리얼 통신으로 검사 결과 전송 (메인 스레드에서 실행)
     if (serialCommunication && serialCommunication->isConnected()) {
-        QMetaObject::invokeMethod(this, [this, frameIdx, passed]() {
+        QMetaObject::invokeMethod(this, [this, frameIdx, passed, traceId]() {
             if (serialCommunication && serialCommunication->isConnected()) {
                 serialCommunication->sendInspectionResult(frameIdx, passed);
+                InspectionTracer::instance().addInstant(traceId, "serial", QStringLiteral("시리얼 응답 전송"));
             }
         }, Qt::QueuedConnection);
     }
     
+    // 추적 종료는 위 UI/시리얼 작업 뒤에 큐잉 (메인 스레드 큐는 순서대로 실행)
+    if (traceId)
+    {
+        QMetaObject::invokeMethod(this, [traceId]() { InspectionTracer::instance().endFrame(traceId); }, Qt::QueuedConnection);
+    }
+    
     // 프레임 처리 완료 플래그 해제
     frameProcessing[frameIdx] = false;
     frameTriggeredBySerial[frameIdx] = false;  // 플래그 초기화
@@ -10303,6 +10487,7 @@ void TeachingWidget::startCamera()
     lastUsedFrameIndex = -1;
     totalTriggersReceived = 0;
     totalInspectionsExecuted = 0;
+    InspectionStats::instance().reset();
     qDebug() << "[startCamera] Server frame index initialized";
 
     // CameraView에 TEACH OFF 상태 전달
@@ -10314,9 +10499,7 @@ void TeachingWidget::startCamera()
     // ★ 모든 레시피 데이터 초기화 (공용 함수 사용)
     // clearAllRecipeData() 내부에 CAM ON 체크가 있으므로 직접 초기화
     // ★ 화면 깜빡임 방지: 배경 이미지는 유지하고 프레임만 초기화
-    for (auto& frame : cameraFrames) {
-        frame.release();
-    }
+    cameraFrames.clear();
     if (cameraView)
     {
         // 배경 이미지는 유지 (번쩍임 방지)
@@ -10352,6 +10535,7 @@ void TeachingWidget::startCamera()
         }
     }
     cameraThreads.clear();
+    stopInspectionWorkers();
 
     if (uiUpdateThread && uiUpdateThread->isRunning())
     {
@@ -10395,7 +10579,8 @@ void TeachingWidget::startCamera()
 
     // 5. 미리보기 오버레이는 updatePreviewFrames에서 자동 업데이트됨
 
-    // 7. 카메라 스레드 생성 및 시작
+    // 7. 카메라별 검사 스레드 + 카메라 스레드 생성 및 시작 (검사 스레드가 먼저 준비되어야 함)
+    startInspectionWorkers();
     for (int i = 0; i < cameraInfos.size(); i++)
     {
         if (cameraInfos[i].isConnected)
@@ -10507,9 +10692,7 @@ void TeachingWidget::stopCamera()
     }
 
     // ★ cameraFrames 초기화 - CAM ON에서 사용한 프레임 제거
-    for (auto& frame : cameraFrames) {
-        frame.release();
-    }
+    cameraFrames.clear();
     qDebug() << "[stopCamera] cameraFrames cleared";
 
     // UI 요소들 비활성화 제거됨
@@ -10536,6 +10719,7 @@ void TeachingWidget::stopCamera()
         }
     }
     cameraThreads.clear();
+    stopInspectionWorkers();
     QThread::msleep(200);  // ★★★ 스레드 완전 종료 대기 증가
 
     // 2. UI 업데이트 스레드 중지
@@ -10672,9 +10856,7 @@ void TeachingWidget::stopCamera()
         // **camOff 모드에서는 티칭 이미지(cameraFrames) 유지**
         if (!camOff)
         {
-            for (auto& frame : cameraFrames) {
-                frame.release();
-            }
+            cameraFrames.clear();
         }
 
         // 모든 패턴들 지우기
@@ -10718,9 +10900,8 @@ void TeachingWidget::saveCurrentImage()
     // 현재 카메라 프레임 확인
     cv::Mat frameToSave;
     {
-        QMutexLocker locker(&cameraFramesMutex);
-        if (cameraIndex < 0 || cameraIndex >= static_cast<int>(4) ||
-            cameraFrames[cameraIndex].empty())
+        cv::Mat published = cameraFrames.load(cameraIndex);
+        if (published.empty())
         {
             CustomMessageBox(this, CustomMessageBox::Warning, TR("SAVE_IMAGE"),
                              "저장할 이미지가 없습니다.\n카메라를 시작하고 이미지를 캡처해주세요.")
@@ -10728,7 +10909,7 @@ void TeachingWidget::saveCurrentImage()
             return;
         }
         // 현재 프레임 저장
-        frameToSave = cameraFrames[cameraIndex].clone();
+        frameToSave = published.clone();
     }
 
     // 저장 경로 선택 다이얼로그 (CustomFileDialog 사용)
@@ -11172,6 +11353,16 @@ void TeachingWidget::showTestDialog()
     testDialog->activateWindow();
 }
 
+void TeachingWidget::showInspectionStats()
+{
+    if (!inspectionStatsDialog) {
+        inspectionStatsDialog = new InspectionStatsDialog(this);
+    }
+    inspectionStatsDialog->show();
+    inspectionStatsDialog->raise();
+    inspectionStatsDialog->activateWindow();
+}
+
 void TeachingWidget::openLanguageSettings()
 {
     LanguageSettingsDialog dialog(this);
@@ -11199,12 +11390,11 @@ void TeachingWidget::updateCameraFrame()
         // CAM OFF 모드에서는 currentDisplayFrameIndex를 직접 사용
         int frameIndex = currentDisplayFrameIndex;
 
-        if (frameIndex < static_cast<int>(4) && !cameraFrames[frameIndex].empty())
+        cv::Mat published = cameraFrames.load(frameIndex);
+        if (!published.empty())
         {
-            cv::Mat currentFrame = cameraFrames[frameIndex];
-
             // ★ 모든 필터 적용 (선택된 필터만이 아닌 전체 필터 체인)
-            cv::Mat filteredFrame = cameraFrames[frameIndex].clone();
+            cv::Mat filteredFrame = published.clone();
             
             if (cameraView)
             {
@@ -11214,7 +11404,7 @@ void TeachingWidget::updateCameraFrame()
             // 필터링된 프레임이 없으면 원본 사용
             if (filteredFrame.empty())
             {
-                filteredFrame = cameraFrames[frameIndex].clone();
+                filteredFrame = published.clone();
             }
 
             // RGB 변환 및 UI 업데이트
@@ -11244,7 +11434,7 @@ void TeachingWidget::updateCameraFrame()
 
             QPixmap pixmap = QPixmap::fromImage(image);
 
-            QSize origSize(cameraFrames[frameIndex].cols, cameraFrames[frameIndex].rows);
+            QSize origSize(published.cols, published.rows);
             cameraView->setScalingInfo(origSize, cameraView->size());
             cameraView->setStatusInfo("SIM");
             cameraView->setBackgroundPixmap(pixmap);
@@ -11271,10 +11461,10 @@ void TeachingWidget::updateCameraFrame()
 
                 cv::Mat bgrFrame;
                 cv::cvtColor(frame, bgrFrame, cv::COLOR_RGB2BGR);
-                cameraFrames[cameraIndex] = bgrFrame.clone();
+                cameraFrames.store(cameraIndex, bgrFrame.clone());
 
                 // ★ 모든 필터 적용 (선택된 필터만이 아닌 전체 필터 체인)
-                cv::Mat filteredFrame = cameraFrames[cameraIndex].clone();
+                cv::Mat filteredFrame = bgrFrame.clone();
                 if (cameraView)
                 {
                     cameraView->applyFiltersToImage(filteredFrame);
@@ -11283,7 +11473,7 @@ void TeachingWidget::updateCameraFrame()
                 // 필터링된 프레임이 없으면 원본 사용
                 if (filteredFrame.empty())
                 {
-                    filteredFrame = cameraFrames[cameraIndex].clone();
+                    filteredFrame = bgrFrame.clone();
                 }
 
                 // RGB 변환 및 UI 업데이트
@@ -11588,9 +11778,10 @@ bool TeachingWidget::eventFilter(QObject *watched, QEvent *event)
                 if (watched == previewOverlayLabels[i] && previewOverlayLabels[i])
                 {
                     // 클릭된 미리보기의 프레임을 메인 화면에 표시
-                    if (i < static_cast<int>(4) && !cameraFrames[i].empty())
+                    cv::Mat published = cameraFrames.load(i);
+                    if (!published.empty())
                     {
-                            cv::Mat displayImage = cameraFrames[i].clone();
+                            cv::Mat displayImage = published.clone();
                             cv::cvtColor(displayImage, displayImage, cv::COLOR_BGR2RGB);
                             QImage qImage(displayImage.data, displayImage.cols, displayImage.rows,
                                           displayImage.step, QImage::Format_RGB888);
@@ -11875,10 +12066,9 @@ void TeachingWidget::switchToCamera(const QString &cameraUuid)
         // CAM OFF/ON 모두 현재 카메라 이미지 표시
         int frameIndex = getFrameIndex(cameraIndex);
         
-        if (frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-            !cameraFrames[frameIndex].empty())
+        cv::Mat currentFrame = (frameIndex >= 0 && frameIndex < static_cast<int>(4)) ? cameraFrames.load(frameIndex) : cv::Mat();
+        if (!currentFrame.empty())
         {
-            cv::Mat currentFrame = cameraFrames[frameIndex];
 
             // OpenCV Mat을 QImage로 변환
             QImage qImage;
@@ -12903,7 +13093,8 @@ QString TeachingWidget::getCameraName(int index)
     return cameraName;
 }
 
-bool TeachingWidget::runInspect(const cv::Mat &frame, int specificCameraIndex, bool updateMainView, int frameIndexForResult)
+bool TeachingWidget::runInspect(const cv::Mat &frame, int specificCameraIndex, bool updateMainView, int frameIndexForResult,
+                                InspectionResult *resultOut, const cv::Mat &frameGray, quint64 traceId)
 {
     if (frame.empty())
     {
@@ -12988,7 +13179,8 @@ bool TeachingWidget::runInspect(const cv::Mat &frame, int specificCameraIndex, b
         // 카메라 이름 가져오기 (resultFrameIndex 기반)
         int cameraIndexForName = (specificCameraIndex == -1) ? cameraIndex : specificCameraIndex;
         QString cameraName = (cameraIndexForName >= 0 && cameraIndexForName < cameraInfos.size()) ? cameraInfos[cameraIndexForName].serialNumber : "";
-        InspectionResult result = insProcessor->performInspection(frame, cameraPatterns, cameraName);
+        // 프레임 공용 흑백 평면 (변환 단계가 만든 평면이 있으면 재사용)
+        InspectionResult result = insProcessor->performInspection(FrameContext(frame, frameGray, traceId), cameraPatterns, cameraName);
 
         // **추가**: 검사 결과를 기반으로 패턴들을 FID 중심으로 그룹 회전
         if (!result.angles.isEmpty())
@@ -13113,6 +13305,12 @@ bool TeachingWidget::runInspect(const cv::Mat &frame, int specificCameraIndex, b
         // **검사 완료 후 결과에 따라 이미지 저장 (카메라별 폴더 구분)**
         saveImageAsync(frame, result.isPassed, cameraIndex);
 
+        // 호출자(4분할 결과 저장 등)에 결과 전달 - 아래 정리 전에 복사 (cv::Mat은 참조 공유)
+        if (resultOut)
+        {
+            *resultOut = result;
+        }
+
         // 메모리 정리: 검사 결과의 큰 이미지들 명시적 해제
         for (auto it = result.insProcessedImages.begin(); it != result.insProcessedImages.end(); ++it) {
             it.value().release();
@@ -13316,22 +13514,26 @@ void TeachingWidget::switchToTestMode()
     if (gotFrame)
     {
         // **벡터에 저장**
-        cameraFrames[cameraIndex] = testFrame.clone();
+        cameraFrames.store(cameraIndex, testFrame.clone());
 
         cv::Mat displayFrame;
-        cv::cvtColor(cameraFrames[cameraIndex], displayFrame, cv::COLOR_BGR2RGB);
+        cv::cvtColor(testFrame, displayFrame, cv::COLOR_BGR2RGB);
 
         QImage image(displayFrame.data, displayFrame.cols, displayFrame.rows,
                      displayFrame.step, QImage::Format_RGB888);
         QPixmap pixmap = QPixmap::fromImage(image);
         cameraView->setBackgroundPixmap(pixmap);
     }
-    else if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4) &&
-             !cameraFrames[cameraIndex].empty())
+    else if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4))
     {
         // 기존 프레임 사용
+        cv::Mat published = cameraFrames.load(cameraIndex);
+        if (published.empty())
+        {
+            return;
+        }
         cv::Mat displayFrame;
-        cv::cvtColor(cameraFrames[cameraIndex], displayFrame, cv::COLOR_BGR2RGB);
+        cv::cvtColor(published, displayFrame, cv::COLOR_BGR2RGB);
 
         QImage image(displayFrame.data, displayFrame.cols, displayFrame.rows,
                      displayFrame.step, QImage::Format_RGB888);
@@ -13356,11 +13558,11 @@ void TeachingWidget::switchToRecipeMode()
     }
 
     // --- 실시간 필터 적용: 카메라뷰에 필터 적용된 이미지를 표시 ---
-    if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4) &&
-        !cameraFrames[cameraIndex].empty())
+    cv::Mat published = (cameraIndex >= 0 && cameraIndex < static_cast<int>(4)) ? cameraFrames.load(cameraIndex) : cv::Mat();
+    if (!published.empty())
     {
 
-        cv::Mat filteredFrame = cameraFrames[cameraIndex].clone();
+        cv::Mat filteredFrame = published.clone();
         cameraView->applyFiltersToImage(filteredFrame);
         cv::Mat rgbFrame;
         cv::cvtColor(filteredFrame, rgbFrame, cv::COLOR_BGR2RGB);
@@ -13381,12 +13583,12 @@ void TeachingWidget::updateAllPatternTemplateImages()
     cv::Mat currentImage;
     if (camOff)
     {
-        if (cameraIndex < 0 || cameraIndex >= static_cast<int>(4) ||
-            cameraFrames[cameraIndex].empty())
+        cv::Mat published = cameraFrames.load(cameraIndex);
+        if (published.empty())
         {
             return;
         }
-        currentImage = cameraFrames[cameraIndex].clone();
+        currentImage = published.clone();
     }
     else
     {
@@ -13568,7 +13770,7 @@ void TeachingWidget::saveRecipe()
     // 프레임 인덱스 = 카메라 인덱스 (1:1 매핑)
     for (int frameIdx = 0; frameIdx < static_cast<int>(cameraFrames.size()); frameIdx++)
     {
-        if (!cameraFrames[frameIdx].empty())
+        if (!cameraFrames.load(frameIdx).empty())
         {
             // 이 프레임(카메라)이 cameraInfos에 있는지 확인
             bool cameraExists = false;
@@ -14152,9 +14354,9 @@ bool TeachingWidget::connectSpinnakerCamera(int index, CameraInfo &info)
                 std::cout << "AcquisitionMode 설정 전 트리거 소스: " << triggerSourceBeforeAcq.toStdString() << std::endl;
             }
 
-            // **중요**: 트리거 모드에서는 AcquisitionMode를 변경하지 않음
+            // **중요**: 여기서는 AcquisitionMode를 변경하지 않음
             // UserSet에서 설정된 AcquisitionMode를 그대로 유지
-            // - 트리거 모드일 때: SingleFrame (각 트리거마다 한 장씩)
+            // - 트리거 모드일 때: CameraGrabberThread가 SingleFrame → Continuous로 전환 (스트리밍 유지)
             // - 자유 실행 모드일 때: Continuous (연속 촬영)
 
             // 현재 설정 상태만 확인하고 로그 출력
@@ -14267,7 +14469,121 @@ bool TeachingWidget::connectSpinnakerCamera(int index, CameraInfo &info)
     }
 }
 
-cv::Mat TeachingWidget::grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr &camera)
+BayerPattern TeachingWidget::spinnakerBayerPattern(const Spinnaker::ImagePtr &image)
+{
+    switch (image->GetPixelFormat())
+    {
+    case Spinnaker::PixelFormat_BayerRG8:
+        return BayerPattern::RG;
+    case Spinnaker::PixelFormat_BayerGR8:
+        return BayerPattern::GR;
+    case Spinnaker::PixelFormat_BayerGB8:
+        return BayerPattern::GB;
+    case Spinnaker::PixelFormat_BayerBG8:
+        return BayerPattern::BG;
+    default:
+        return BayerPattern::None;
+    }
+}
+
+cv::Mat TeachingWidget::convertSpinnakerToBgr(const Spinnaker::ImagePtr &image, FrameBufferPool *pool) const
+{
+    const BayerPattern bayer = spinnakerBayerPattern(image);
+    if (bayer != BayerPattern::None)
+    {
+        // Bayer 8비트: 카메라 버퍼를 그대로 감싸서 설정한 화질로 디모자이크
+        // (SDK 프로세서는 호출 스레드 - 카메라별 획득 스레드/UI 스레드 - 마다 하나를 재사용)
+        thread_local SdkDemosaicer sdkDemosaicer;
+        cv::Mat raw(static_cast<int>(image->GetHeight()), static_cast<int>(image->GetWidth()),
+                    CV_8UC1, image->GetData(), image->GetStride());
+        cv::Mat frame = pool ? pool->acquire(raw.rows, raw.cols, CV_8UC3) : cv::Mat();
+        FrameConverter::demosaicBgr(raw, bayer, frameConverter.quality(), &sdkDemosaicer, frame);
+        return frame;
+    }
+
+    // Bayer가 아닌 컬러 포맷(RGB/YUV 등)은 SDK 변환
+    Spinnaker::ImageProcessor processor;
+    processor.SetColorProcessing(Spinnaker::SPINNAKER_COLOR_PROCESSING_ALGORITHM_DIRECTIONAL_FILTER);
+
+    const int width = static_cast<int>(image->GetWidth());
+    const int height = static_cast<int>(image->GetHeight());
+
+    if (pool)
+    {
+        // 풀 버퍼를 대상 이미지로 감싸서 변환 결과를 바로 써 넣음 (clone 없음)
+        cv::Mat frame = pool->acquire(height, width, CV_8UC3);
+        Spinnaker::ImagePtr target = Spinnaker::Image::Create(width, height, 0, 0, Spinnaker::PixelFormat_BGR8, frame.data);
+        processor.Convert(image, target, Spinnaker::PixelFormat_BGR8);
+        return frame;
+    }
+
+    Spinnaker::ImagePtr convertedImage = processor.Convert(image, Spinnaker::PixelFormat_BGR8);
+    if (!convertedImage || convertedImage->IsIncomplete())
+        return cv::Mat();
+    return cv::Mat(height, width, CV_8UC3, convertedImage->GetData()).clone();
+}
+
+bool TeachingWidget::enableContinuousTriggerAcquisition(Spinnaker::CameraPtr &camera)
+{
+    // SingleFrame 트리거는 한 장마다 acquisition이 멈춰 재시작(End/Begin) 동안 들어온 트리거를 놓침
+    // Continuous + TriggerMode On이면 스트리밍을 유지한 채 트리거마다 한 장씩 전달됨
+    try
+    {
+        Spinnaker::GenApi::INodeMap &nodeMap = camera->GetNodeMap();
+        Spinnaker::GenApi::CEnumerationPtr ptrAcquisitionMode = nodeMap.GetNode("AcquisitionMode");
+        if (!Spinnaker::GenApi::IsReadable(ptrAcquisitionMode))
+            return false;
+
+        QString acqModeStr = QString::fromStdString(ptrAcquisitionMode->GetCurrentEntry()->GetSymbolic().c_str());
+        if (acqModeStr == "Continuous")
+            return true;
+
+        // AcquisitionMode와 버퍼 정책은 스트리밍 중에는 변경 불가
+        if (camera->IsStreaming())
+        {
+            camera->EndAcquisition();
+        }
+
+        Spinnaker::GenApi::CEnumEntryPtr ptrContinuous = ptrAcquisitionMode->GetEntryByName("Continuous");
+        if (!Spinnaker::GenApi::IsWritable(ptrAcquisitionMode) || !Spinnaker::GenApi::IsReadable(ptrContinuous))
+            return false;
+        ptrAcquisitionMode->SetIntValue(ptrContinuous->GetValue());
+
+        // 연달아 들어온 트리거 프레임을 버리지 않도록 도착 순서대로 전달
+        setStreamBufferHandling(camera, "OldestFirst");
+
+        qDebug() << "[Camera] 트리거 모드 AcquisitionMode: SingleFrame → Continuous";
+        return true;
+    }
+    catch (Spinnaker::Exception &e)
+    {
+        qDebug() << "[Camera] Continuous 트리거 전환 실패:" << e.what();
+        return false;
+    }
+}
+
+void TeachingWidget::setStreamBufferHandling(Spinnaker::CameraPtr &camera, const char *mode)
+{
+    try
+    {
+        Spinnaker::GenApi::INodeMap &streamNodeMap = camera->GetTLStreamNodeMap();
+        Spinnaker::GenApi::CEnumerationPtr ptrBufferHandlingMode = streamNodeMap.GetNode("StreamBufferHandlingMode");
+        if (!Spinnaker::GenApi::IsWritable(ptrBufferHandlingMode))
+            return;
+
+        Spinnaker::GenApi::CEnumEntryPtr ptrMode = ptrBufferHandlingMode->GetEntryByName(mode);
+        if (Spinnaker::GenApi::IsReadable(ptrMode))
+        {
+            ptrBufferHandlingMode->SetIntValue(ptrMode->GetValue());
+        }
+    }
+    catch (Spinnaker::Exception &e)
+    {
+        // 무시 (기존 버퍼 정책 유지)
+    }
+}
+
+cv::Mat TeachingWidget::grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr &camera, FrameBufferPool *pool)
 {
     cv::Mat cvImage;
     try
@@ -14322,19 +14638,11 @@ cv::Mat TeachingWidget::grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr &camer
                 if (!latestImage->IsIncomplete())
                 {
                     // 성공적으로 최신 프레임 획득
-                    size_t width = latestImage->GetWidth();
-                    size_t height = latestImage->GetHeight();
-
                     try
                     {
-                        Spinnaker::ImageProcessor processor;
-                        processor.SetColorProcessing(Spinnaker::SPINNAKER_COLOR_PROCESSING_ALGORITHM_DIRECTIONAL_FILTER);
-                        Spinnaker::ImagePtr convertedImage = processor.Convert(latestImage, Spinnaker::PixelFormat_BGR8);
-
-                        if (convertedImage && !convertedImage->IsIncomplete())
+                        cvImage = convertSpinnakerToBgr(latestImage, pool);
+                        if (!cvImage.empty())
                         {
-                            unsigned char *buffer = static_cast<unsigned char *>(convertedImage->GetData());
-                            cvImage = cv::Mat(height, width, CV_8UC3, buffer).clone();
                             latestImage->Release();
                             return cvImage; // 최신 프레임 반환
                         }
@@ -14420,22 +14728,10 @@ cv::Mat TeachingWidget::grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr &camer
         }
         else
         {
-            // 컬러 이미지 변환 (BGR8 형식으로 - OpenCV는 BGR 순서 사용)
+            // 컬러 이미지 변환 (BGR8 형식으로 - OpenCV는 BGR 순서 사용, 풀 버퍼에 직접 변환)
             try
             {
-                // 이미지 처리기를 사용하여 BGR8로 변환
-                Spinnaker::ImageProcessor processor;
-                processor.SetColorProcessing(Spinnaker::SPINNAKER_COLOR_PROCESSING_ALGORITHM_DIRECTIONAL_FILTER);
-                Spinnaker::ImagePtr convertedImage = processor.Convert(spinImage, Spinnaker::PixelFormat_BGR8);
-
-                if (convertedImage && !convertedImage->IsIncomplete())
-                {
-                    unsigned char *buffer = static_cast<unsigned char *>(convertedImage->GetData());
-                    cvImage = cv::Mat(height, width, CV_8UC3, buffer).clone();
-                }
-                else
-                {
-                }
+                cvImage = convertSpinnakerToBgr(spinImage, pool);
             }
             catch (Spinnaker::Exception &e)
             {
@@ -14515,14 +14811,8 @@ TeachingWidget::~TeachingWidget()
     qDebug() << "[~TeachingWidget] 비동기 작업 정리 완료";
     
     // 0-2. cameraFrames 명시적 해제 (OpenCV Mat 소멸자 mutex 문제 방지)
-    for (auto& frame : cameraFrames) {
-        if (!frame.empty()) {
-            frame.release();
-        }
-    }
-    for (auto& frame : cameraFrames) {
-        frame.release();
-    }
+    cameraFrames.clear();
+    InspectionStats::instance().setCounterProvider(nullptr);
     
     // 1. ClientDialog reconnect 스레드 중지 (Spinnaker SDK 정리 전에 필수)
     qDebug() << "[~TeachingWidget] ClientDialog reconnect 스레드 중지 시작";
@@ -14543,6 +14833,7 @@ TeachingWidget::~TeachingWidget()
         }
     }
     cameraThreads.clear();
+    stopInspectionWorkers();
     qDebug() << "[~TeachingWidget] 카메라 스레드 중지 완료";
 
     // 2. UI 업데이트 스레드 정리
@@ -14707,7 +14998,7 @@ void TeachingWidget::addPattern()
 
     // 시뮬레이션 모드 상태 디버깅 - cameraFrames 체크
     if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4) &&
-        !cameraFrames[cameraIndex].empty())
+        !cameraFrames.load(cameraIndex).empty())
     {
     }
 
@@ -14840,10 +15131,10 @@ void TeachingWidget::addPattern()
                      << "4:" << 4;
 
             // cameraFrames[frameIndex] 사용
-            if (frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-                !cameraFrames[frameIndex].empty())
+            cv::Mat published = (frameIndex >= 0 && frameIndex < static_cast<int>(4)) ? cameraFrames.load(frameIndex) : cv::Mat();
+            if (!published.empty())
             {
-                sourceImage = cameraFrames[frameIndex].clone();
+                sourceImage = published.clone();
                 hasSourceImage = true;
                 qDebug() << "[addPattern] 템플릿 이미지 획득 성공 - 크기:" << sourceImage.cols << "x" << sourceImage.rows;
             }
@@ -14902,6 +15193,10 @@ void TeachingWidget::addPattern()
             framePatternLists[frameIdx].append(*addedPattern);
             qDebug().noquote() << QString("[addPattern] Frame[%1]에 패턴 추가 - 총 패턴 수: %2")
                         .arg(frameIdx).arg(framePatternLists[frameIdx].size());
+            if (insProcessor) {
+                insProcessor->compileInspectionPlan(framePatternLists[frameIdx],
+                                                    ConfigManager::instance()->getLastRecipePath());
+            }
         }
 
         // INS 패턴인 경우 템플릿 이미지를 필터가 적용된 상태로 업데이트
@@ -15072,6 +15367,7 @@ void TeachingWidget::onBackButtonClicked()
         }
     }
     cameraThreads.clear();
+    stopInspectionWorkers();
 
     // **2. UI 업데이트 스레드 중지**
     if (uiUpdateThread)
@@ -15125,11 +15421,11 @@ void TeachingWidget::updateUIElements()
         return;
 
     // 스케일링 정보 업데이트
-    if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4) &&
-        !cameraFrames[cameraIndex].empty())
+    cv::Mat published = (cameraIndex >= 0 && cameraIndex < static_cast<int>(4)) ? cameraFrames.load(cameraIndex) : cv::Mat();
+    if (!published.empty())
     {
 
-        QSize origSize(cameraFrames[cameraIndex].cols, cameraFrames[cameraIndex].rows);
+        QSize origSize(published.cols, published.rows);
         QSize viewSize = cameraView->size();
 
         if (origSize.width() > 0 && origSize.height() > 0 &&
@@ -15202,10 +15498,10 @@ InspectionResult TeachingWidget::runSingleInspection(int specificCameraIndex)
         // camOff 모드에서는 항상 cameraFrames[0] 사용, camOn 모드에서는 specificCameraIndex 사용
         int frameIndex = camOff ? 0 : specificCameraIndex;
 
-        if (cameraView && frameIndex >= 0 && frameIndex < static_cast<int>(4) &&
-            !cameraFrames[frameIndex].empty())
+        cv::Mat published = (cameraView && frameIndex >= 0 && frameIndex < static_cast<int>(4)) ? cameraFrames.load(frameIndex) : cv::Mat();
+        if (!published.empty())
         {
-            inspectionFrame = cameraFrames[frameIndex].clone();
+            inspectionFrame = published.clone();
         }
 
         if (!inspectionFrame.empty() && cameraView)
@@ -15386,9 +15682,7 @@ void TeachingWidget::onCamModeToggled()
         else
         {
             // 레시피가 없으면 cameraFrames 초기화
-            for (auto& frame : cameraFrames) {
-                frame.release();
-            }
+            cameraFrames.clear();
         }
     }
     else
@@ -15421,7 +15715,7 @@ void TeachingWidget::onSimulationImageSelected(const cv::Mat &image, const QStri
         if (cameraIndex >= 0)
         {
             // cameraFrames 크기가 충분한지 확인
-            cameraFrames[cameraIndex] = image.clone();
+            cameraFrames.store(cameraIndex, image.clone());
         }
 
         // 시뮬레이션 모드임을 명확히 표시
@@ -16049,7 +16343,8 @@ void TeachingWidget::newRecipe()
         bool allFramesValid = true;
         for (int i = 0; i < 4; i++)
         {
-            if (cameraFrames[i].empty())
+            cv::Mat published = cameraFrames.load(i);
+            if (published.empty())
             {
                 allFramesValid = false;
                 qDebug() << "[Recipe] 카메라" << i << "프레임 없음";
@@ -16058,7 +16353,7 @@ void TeachingWidget::newRecipe()
             else
             {
                 qDebug() << "[Recipe] 카메라" << i << "프레임 있음:" 
-                         << cameraFrames[i].cols << "x" << cameraFrames[i].rows;
+                         << published.cols << "x" << published.rows;
             }
         }
         
@@ -16129,7 +16424,7 @@ void TeachingWidget::newRecipe()
         if (4 <= static_cast<size_t>(cameraIndex))
         {
         }
-        cameraFrames[cameraIndex] = loadedImage.clone();
+        cameraFrames.store(cameraIndex, loadedImage.clone());
 
         // 생성 날짜를 카메라 이름으로 설정 (레시피 이름과 동일)
         QString cameraName = recipeName; // 레시피 이름(타임스탬프)을 카메라 이름으로 사용
@@ -16213,7 +16508,7 @@ void TeachingWidget::newRecipe()
         if (4 <= static_cast<size_t>(cameraIndex))
         {
         }
-        cameraFrames[cameraIndex] = mainCameraImage.clone();
+        cameraFrames.store(cameraIndex, mainCameraImage.clone());
 
         // 카메라 정보 설정
         if (cameraView)
@@ -16319,11 +16614,12 @@ void TeachingWidget::createNewRecipeWithName(const QString& recipeName)
         qDebug() << "[Recipe] ===== cameraFrames 상태 확인 시작 =====";
         for (int i = 0; i < 4; i++)
         {
-            qDebug() << "[Recipe] cameraFrames[" << i << "] empty:" << cameraFrames[i].empty() 
-                     << ", size:" << cameraFrames[i].cols << "x" << cameraFrames[i].rows
-                     << ", data:" << (cameraFrames[i].data ? "OK" : "NULL");
+            cv::Mat published = cameraFrames.load(i);
+            qDebug() << "[Recipe] cameraFrames[" << i << "] empty:" << published.empty() 
+                     << ", size:" << published.cols << "x" << published.rows
+                     << ", data:" << (published.data ? "OK" : "NULL");
             
-            if (cameraFrames[i].empty())
+            if (published.empty())
             {
                 allFramesValid = false;
                 qDebug() << "[Recipe] 카메라" << i << "프레임 없음";
@@ -16331,7 +16627,7 @@ void TeachingWidget::createNewRecipeWithName(const QString& recipeName)
             else
             {
                 qDebug() << "[Recipe] 카메라" << i << "프레임 있음:" 
-                         << cameraFrames[i].cols << "x" << cameraFrames[i].rows;
+                         << published.cols << "x" << published.rows;
             }
         }
         qDebug() << "[Recipe] ===== cameraFrames 상태 확인 완료 =====" << "allFramesValid:" << allFramesValid;
@@ -16402,7 +16698,7 @@ void TeachingWidget::createNewRecipeWithName(const QString& recipeName)
         if (4 <= static_cast<size_t>(cameraIndex))
         {
         }
-        cameraFrames[cameraIndex] = loadedImage.clone();
+        cameraFrames.store(cameraIndex, loadedImage.clone());
 
         QString cameraName = recipeName;
         cameraView->setCurrentCameraName(cameraName);
@@ -16516,7 +16812,7 @@ void TeachingWidget::createNewRecipeWithName(const QString& recipeName)
                         }
                         
                         // cameraFrames에 저장
-                        cameraFrames[imageIndex] = teachingImage.clone();
+                        cameraFrames.store(imageIndex, teachingImage.clone());
                         foundImage = true;
                         
                         qDebug() << "[Recipe] Loaded teaching image" << imageIndex << ":" << teachingImage.cols << "x" << teachingImage.rows;
@@ -16645,7 +16941,7 @@ void TeachingWidget::loadTeachingImage()
     if (4 <= static_cast<size_t>(cameraIndex))
     {
     }
-    cameraFrames[cameraIndex] = loadedImage.clone();
+    cameraFrames.store(cameraIndex, loadedImage.clone());
 
     // 카메라 정보가 없으면 기본 카메라 정보 생성
     if (cameraInfos.isEmpty())
@@ -16734,9 +17030,7 @@ void TeachingWidget::clearAllRecipeData()
     qDebug() << "[clearAllRecipeData] 레시피 데이터 초기화 시작";
 
     // 1. cameraFrames 초기화 (CAM ON 상태에서도 허용)
-    for (auto& frame : cameraFrames) {
-        frame.release();
-    }
+    cameraFrames.clear();
     qDebug() << "[clearAllRecipeData] cameraFrames 초기화";
 
     // 2. 뷰포트 클리어 (배경 이미지 및 패턴 제거)
@@ -16926,8 +17220,9 @@ void TeachingWidget::manageRecipes()
                         // 메인 화면과 4분할 미리보기 갱신
                         if (!camOff) {
                             // CAM ON: 현재 카메라 프레임으로 갱신
-                            if (cameraIndex >= 0 && cameraIndex < 4 && !cameraFrames[cameraIndex].empty()) {
-                                QImage qImage = InsProcessor::matToQImage(cameraFrames[cameraIndex]);
+                            cv::Mat published = (cameraIndex >= 0 && cameraIndex < 4) ? cameraFrames.load(cameraIndex) : cv::Mat();
+                            if (!published.empty()) {
+                                QImage qImage = InsProcessor::matToQImage(published);
                                 QPixmap pixmap = QPixmap::fromImage(qImage);
                                 cameraView->setBackgroundPixmap(pixmap);
                             }
@@ -16939,8 +17234,9 @@ void TeachingWidget::manageRecipes()
                         // 4분할 미리보기 갱신
                         for (int i = 0; i < 4; i++) {
                             if (previewOverlayLabels[i]) {
-                                if (!cameraFrames[i].empty()) {
-                                    QImage qImage = InsProcessor::matToQImage(cameraFrames[i]);
+                                cv::Mat published = cameraFrames.load(i);
+                                if (!published.empty()) {
+                                    QImage qImage = InsProcessor::matToQImage(published);
                                     QPixmap pixmap = QPixmap::fromImage(qImage);
                                     previewOverlayLabels[i]->setPixmap(pixmap.scaled(
                                         previewOverlayLabels[i]->size(), Qt::KeepAspectRatio, Qt::SmoothTransformation));
@@ -17182,7 +17478,7 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
                     int camIdx = imageIndex;
                     
                     // cameraFrames 배열 크기 확장
-                    cameraFrames[camIdx] = teachingImage.clone();
+                    cameraFrames.store(camIdx, teachingImage.clone());
                 }
             }
             imageIndex++; // 실패해도 인덱스는 증가
@@ -17200,7 +17496,7 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
             // 카메라 ON 상태 - 패턴만 로드됨
         }
         else if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4) &&
-                 !cameraFrames[cameraIndex].empty())
+                 !cameraFrames.load(cameraIndex).empty())
         {
             qDebug() << "[onRecipeSelected] camOff 상태에서 updateCameraFrame 호출 - cameraIndex:" << cameraIndex 
                      << "cameraFrames.size:" << 4;
@@ -17215,11 +17511,11 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
                      << "camOff:" << camOff;
             if (cameraIndex >= 0 && cameraIndex < static_cast<int>(4))
             {
-                qDebug() << "  cameraFrames[cameraIndex].empty():" << cameraFrames[cameraIndex].empty();
+                qDebug() << "  cameraFrames[cameraIndex].empty():" << cameraFrames.load(cameraIndex).empty();
             }
             
             // ★ 수정: cameraFrames[0]이 비어있지 않으면 updateCameraFrame 호출
-            if (camOff && !cameraFrames.empty() && !cameraFrames[0].empty())
+            if (camOff && !cameraFrames.empty() && !cameraFrames.load(0).empty())
             {
                 cameraIndex = 0;
                 qDebug() << "[onRecipeSelected] cameraIndex=0으로 설정 후 updateCameraFrame 호출";
@@ -17233,7 +17529,7 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
         // 4분할 뷰에 프레임 설정 (영상이 있으면 무조건 표시)
         if (cameraView && cameraView->getQuadViewMode())
         {
-            cameraView->setQuadFrames(cameraFrames);
+            cameraView->setQuadFrames(cameraFrames.snapshot());
             cameraView->viewport()->update();
             cameraView->repaint();
         }
@@ -17324,13 +17620,16 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
 
         // TODO: 현재 연결된 카메라의 패턴만 필터링하는 기능 추가 예정
 
-        // 첫 번째로 비어있지 않은 프레임 찾기
+        // 첫 번째로 비어있지 않은 프레임 찾기 (찾은 프레임을 그대로 표시에 사용)
         int firstValidFrameIndex = -1;
+        cv::Mat firstValidFrame;
         for (int i = 0; i < static_cast<int>(cameraFrames.size()); ++i)
         {
-            if (!cameraFrames[i].empty())
+            cv::Mat published = cameraFrames.load(i);
+            if (!published.empty())
             {
                 firstValidFrameIndex = i;
+                firstValidFrame = published;
                 break;
             }
         }
@@ -17345,7 +17644,7 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
                 QString firstCameraUuid = cameraInfos[firstValidFrameIndex].uniqueId;
                 
                 cv::Mat displayImage;
-                cv::cvtColor(cameraFrames[firstValidFrameIndex], displayImage, cv::COLOR_BGR2RGB);
+                cv::cvtColor(firstValidFrame, displayImage, cv::COLOR_BGR2RGB);
                 QImage qImage(displayImage.data, displayImage.cols, displayImage.rows,
                               displayImage.step, QImage::Format_RGB888);
                 QPixmap pixmap = QPixmap::fromImage(qImage.copy());
@@ -17382,6 +17681,15 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
             }
         }
         
+        // 프레임별 검사 계획 미리 컴파일 (트리거마다 패턴 분류/모델 경로 계산 생략)
+        if (insProcessor) {
+            insProcessor->invalidateInspectionPlans();
+            insProcessor->clearTemplateCache();
+            for (int i = 0; i < 4; i++) {
+                insProcessor->compileInspectionPlan(framePatternLists[i], recipeName);
+            }
+        }
+        
         // 레시피 로드 완료 - 템플릿 자동 업데이트 재활성화
         isLoadingRecipe = false;
         
@@ -17449,33 +17757,14 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
             {
                 QString firstCameraUuid = recipeCameraUuids.first();
 
-                // cameraFrames 상태 디버그 출력
-
-                for (int i = 0; i < static_cast<int>(4); i++)
-                {
-                    if (!cameraFrames[i].empty())
-                    {
-                    }
-                    else
-                    {
-                    }
-                }
-
-                if (cameraFrames.empty())
-                {
-                }
-                else if (4 > 0 && cameraFrames[0].empty())
-                {
-                }
-
                 // 첫 번째 카메라로 전환 (프리뷰도 자동 할당됨)
                 switchToCamera(firstCameraUuid);
                 cameraIndex = 0;
 
                 // camOff 모드에서 첫 번째 카메라의 티칭 이미지를 메인 카메라뷰에 표시
-                if (!cameraFrames.empty() && !cameraFrames[0].empty() && cameraView)
+                cv::Mat firstCameraImage = cameraFrames.load(0);
+                if (!firstCameraImage.empty() && cameraView)
                 {
-                    cv::Mat firstCameraImage = cameraFrames[0];
 
                     // OpenCV Mat을 QImage로 변환
                     QImage qImage;
@@ -17534,7 +17823,7 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
         // 4분할 화면 업데이트 (영상이 있으면 무조건 표시)
         if (cameraView && cameraView->getQuadViewMode())
         {
-            cameraView->setQuadFrames(cameraFrames);
+            cameraView->setQuadFrames(cameraFrames.snapshot());
             cameraView->viewport()->update();
             cameraView->repaint();
             QApplication::processEvents();
@@ -17544,10 +17833,11 @@ void TeachingWidget::onRecipeSelected(const QString &recipeName)
         if (wasThreadsPaused)
         {
             // 배경 이미지 확실히 유지 (스레드 재개 전)
-            if (!cameraFrames.empty() && !cameraFrames[0].empty() && cameraView)
+            cv::Mat published = cameraFrames.load(0);
+            if (!published.empty() && cameraView)
             {
                 cv::Mat displayImage;
-                cv::cvtColor(cameraFrames[0], displayImage, cv::COLOR_BGR2RGB);
+                cv::cvtColor(published, displayImage, cv::COLOR_BGR2RGB);
                 QImage qImage(displayImage.data, displayImage.cols, displayImage.rows,
                               displayImage.step, QImage::Format_RGB888);
                 QPixmap pixmap = QPixmap::fromImage(qImage.copy());
@@ -18278,7 +18568,7 @@ void TeachingWidget::setCameraFrame(int index, const cv::Mat& frame)
     if (index >= static_cast<int>(4)) {
     }
     
-    cameraFrames[index] = frame.clone();
+    cameraFrames.store(index, frame.clone());
     
     // 화면 업데이트
     if (index == cameraIndex) {
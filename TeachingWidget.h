@@ -59,6 +59,8 @@
 #include "FilterDialog.h"
 #include "InsProcessor.h"
 #include "ConfigManager.h"
+#include "InspectionPipeline.h"
+#include "InspectionTrace.h"
 
 #ifdef USE_SPINNAKER
 #include "Spinnaker.h"
@@ -70,6 +72,8 @@ class SerialSettingsDialog;
 class CameraSettingsDialog;
 class ClientDialog;
 class TestDialog;
+class InspectionStatsDialog;
+class InspectionStatsServer;
 
 class CameraGrabberThread : public QThread {
     Q_OBJECT
@@ -83,7 +87,7 @@ public:
     
 signals:
     void frameGrabbed(const cv::Mat& frame, int cameraIndex);  // 카메라 인덱스 추가
-    void triggerSignalReceived(const cv::Mat& frame, int cameraIndex);  // 트리거 신호 수신
+    void triggerSignalReceived(const cv::Mat& frame, int cameraIndex, BayerPattern bayer, quint64 traceId);  // 트리거 신호 수신 (bayer != None이면 변환 전 원본, traceId: 지연 추적 ID)
     
 protected:
     void run() override;
@@ -96,6 +100,11 @@ private:
     std::atomic<bool> m_paused;
     bool previousInspectMode = false;
     bool modeInitialized = false;
+    bool continuousTriggerActive = false;  // Continuous 트리거 획득으로 전환됨 (버퍼 정책 OldestFirst)
+    bool continuousTriggerFailed = false;  // 전환 불가 카메라 - 트리거 해제 전까지 재시도 안 함
+    
+    // 트리거 대기 타임아웃 (블로킹 대기, 중지 요청 확인 주기)
+    static constexpr int TRIGGER_WAIT_TIMEOUT_MS = 100;
 };
 
 // UI 업데이트 스레드
@@ -147,9 +156,9 @@ class TeachingWidget : public QWidget {
 
 public:
     // RecipeManager에서 접근 가능하도록 public으로 선언
-    std::array<cv::Mat, 4> cameraFrames;  // 고정 크기 4 배열 (CAM0_STRIP, CAM0_CRIMP, CAM1_STRIP, CAM1_CRIMP)
+    FrameSlots cameraFrames;  // 프레임 슬롯 4개 (CAM0_STRIP, CAM0_CRIMP, CAM1_STRIP, CAM1_CRIMP), 슬롯별 원자적 발행/읽기
     std::array<cv::Mat, 4> lastInspectionFrames;  // 마지막 검사 프레임 백업 (레시피 생성용)
-    std::array<bool, 4> frameUpdatedFlags;  // 각 프레임의 업데이트 플래그 (트리거로 새 데이터 수신됨)
+    std::array<std::atomic<bool>, 4> frameUpdatedFlags;  // 각 프레임의 업데이트 플래그 (트리거로 새 데이터 수신됨)
     bool camOff = true;
     int cameraIndex;
     int currentDisplayFrameIndex = 0;  // 현재 메인 뷰에 표시된 프레임 인덱스 (0~3)
@@ -234,7 +243,7 @@ public:
     bool getCamOff() const { return camOff; }
     int getCurrentDisplayFrameIndex() const { return currentDisplayFrameIndex; }
     int getCameraIndex() const { return cameraIndex; }
-    const std::array<cv::Mat, 4>& getCameraFrames() const { return cameraFrames; }
+    std::array<cv::Mat, 4> getCameraFrames() const { return cameraFrames.snapshot(); }
     
     // 강제 camOff (프로그램 종료 시 사용)
     void forceCamOff();
@@ -287,7 +296,7 @@ signals:
     void messageReceived(const QString& message);
     
 private slots:
-    void onTriggerSignalReceived(const cv::Mat& frame, int cameraIndex);
+    void onTriggerSignalReceived(const cv::Mat& frame, int cameraIndex, BayerPattern bayer = BayerPattern::None, quint64 traceId = 0);  // 획득 단계 (프레임 인덱스 확정 후 검사 큐에 넣음)
     void onInspectionRequestReceived(const QJsonObject& request);  // 소켓 검사 요청 수신
     void onRecipeReadyReceived(const QJsonObject& request);  // 서버 레시피 준비 요청 수신
     void onFrameIndexReceived(int frameIndex);  // 시리얼 프레임 인덱스 수신 (레거시)
@@ -299,6 +308,7 @@ private slots:
     void showCameraSettings();
     void showModelManagement();
     void showTestDialog();
+    void showInspectionStats();
     void openGeneralSettings() {
         QMessageBox::information(this, TR("GENERAL_SETTINGS"), 
             TR("GENERAL_SETTINGS_INFO"));
@@ -324,7 +334,9 @@ private slots:
 
     void switchToRecipeMode();
     void switchToTestMode();
-    bool runInspect(const cv::Mat& frame, int specificCameraIndex = -1, bool updateMainView = true, int frameIndexForResult = -1);
+    // resultOut이 있으면 이번 검사 결과를 그대로 넘겨줌 (같은 프레임을 다시 검사하지 않도록)
+    bool runInspect(const cv::Mat& frame, int specificCameraIndex = -1, bool updateMainView = true, int frameIndexForResult = -1,
+                    InspectionResult* resultOut = nullptr, const cv::Mat& frameGray = cv::Mat(), quint64 traceId = 0);
     void onBackButtonClicked();
     void toggleFullScreenMode();
     
@@ -364,7 +376,6 @@ private:
     
     // 스레드 안전성을 위한 뮤텍스
     mutable QMutex cameraInfosMutex;
-    mutable QMutex cameraFramesMutex;  // cameraFrames 전체 보호용
     
     // 필터 설정 중 프로퍼티 패널 업데이트 방지 플래그
     bool isFilterAdjusting = false;
@@ -404,6 +415,7 @@ private:
     QAction* cameraSettingsAction = nullptr;
     QAction* modelManagementAction = nullptr;
     QAction* testDialogAction = nullptr;
+    QAction* inspectionStatsAction = nullptr;
     
     // 버튼 멤버 변수들
     QPushButton* modeToggleButton = nullptr;
@@ -648,7 +660,14 @@ private:
     bool initSpinnakerSDK();
     void releaseSpinnakerSDK();
     bool connectSpinnakerCamera(int index, CameraInfo& info);
-    cv::Mat grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr& camera);
+    cv::Mat grabFrameFromSpinnakerCamera(Spinnaker::CameraPtr& camera, FrameBufferPool* pool = nullptr);
+    // BGR8 변환 (풀이 있으면 풀 버퍼에 직접 변환해 추가 복사 없음, Bayer는 병렬 디모자이크)
+    cv::Mat convertSpinnakerToBgr(const Spinnaker::ImagePtr& image, FrameBufferPool* pool) const;
+    // 카메라 PixelFormat → Bayer 배열 (Bayer 8비트가 아니면 None)
+    static BayerPattern spinnakerBayerPattern(const Spinnaker::ImagePtr& image);
+    // 트리거 모드를 Continuous 획득으로 전환 (트리거마다 End/BeginAcquisition 불필요)
+    static bool enableContinuousTriggerAcquisition(Spinnaker::CameraPtr& camera);
+    static void setStreamBufferHandling(Spinnaker::CameraPtr& camera, const char* mode);
 #endif
 
     // ===== 초기화 및 설정 함수 =====
@@ -754,6 +773,8 @@ private:
     ResizeEdge rightPanelResizeEdge = ResizeEdge::None;
     FilterDialog* filterDialog;
     TestDialog* testDialog = nullptr;
+    InspectionStatsDialog* inspectionStatsDialog = nullptr;
+    InspectionStatsServer* inspectionStatsServer = nullptr;  // 로컬 통계 엔드포인트 (포트 0이면 대기 안 함)
     
     // 카메라 관련
     QString cameraStatus;
@@ -801,6 +822,24 @@ private:
     // 카메라별 스레드 보관
     QVector<CameraGrabberThread*> cameraThreads;
     
+    // 카메라별 프레임 버퍼 풀 (변환 단계가 직접 써 넣고 검사/표시/저장이 읽기 전용으로 공유)
+    std::array<FrameBufferPool, 2> framePools;
+    // 카메라별 Bayer 원본 버퍼 풀 (획득 스레드가 복사, 변환 단계가 다 쓰면 반환)
+    std::array<FrameBufferPool, 2> rawFramePools;
+    // Bayer → BGR/흑백 변환 단계 설정 (카메라 공용, ConfigManager 값 반영)
+    FrameConverter frameConverter;
+    // 검사 스레드 없이 직접 변환할 때 쓰는 카메라별 SDK 디모자이커 (검사 스레드는 각자 보유)
+    std::array<SdkDemosaicer, 2> sdkDemosaicers;
+    // 디모자이크/지연 추적 설정 반영 (ConfigManager 변경 시에도 호출)
+    void applyPipelineSettings();
+    
+    // 카메라별 검사 단계 스레드 (카메라 인덱스 순, 연결 안 된 카메라는 nullptr)
+    QVector<InspectionWorkerThread*> inspectionWorkers;
+    static constexpr int INSPECTION_QUEUE_CAPACITY = 4;
+    void startInspectionWorkers();
+    void stopInspectionWorkers();
+    void processTriggerFrame(const TriggerFrame& trigger);  // 검사 단계 (검사 스레드에서 실행)
+    
     // 시리얼 통신 관련
     SerialCommunication* serialCommunication = nullptr;
     SerialSettingsDialog* serialSettingsDialog = nullptr;
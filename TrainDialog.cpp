@@ -1059,7 +1059,8 @@ bool TrainDialog::performPatternMatching(const cv::Mat& image, PatternInfo* targ
     }
     
     cv::Mat result;
-    int matchMethod = (parentFidPattern->fidMatchMethod == 0) ? cv::TM_CCOEFF_NORMED : cv::TM_CCORR_NORMED;
+    // 형상 매칭(2) FID도 학습 영상 정렬은 Coefficient 템플릿 매칭 사용
+    int matchMethod = (parentFidPattern->fidMatchMethod == 1) ? cv::TM_CCORR_NORMED : cv::TM_CCOEFF_NORMED;
     double matchThreshold = parentFidPattern->matchThreshold / 100.0;
     
     if (!fidMask.empty()) {